@@ -24,13 +24,17 @@
 # find opm -name '*.c*' -printf '\t%p\n' | sort
 list (APPEND MAIN_SOURCE_FILES
   ebos/collecttoiorank.cc
+  ebos/eclcheckpointfile.cc
   ebos/eclgenericcpgridvanguard.cc
   ebos/eclgenericoutputblackoilmodule.cc
   ebos/eclgenericproblem.cc
   ebos/eclgenericthresholdpressure.cc
   ebos/eclgenerictracermodel.cc
   ebos/eclgenericvanguard.cc
+  ebos/eclbinaryrecords.cc
+  ebos/ecldistributedcelldata.cc
   ebos/eclgenericwriter.cc
+  ebos/eclmappedrestartfile.cc
   ebos/ecltransmissibility.cc
   opm/core/props/phaseUsageFromDeck.cpp
   opm/core/props/satfunc/RelpermDiagnostics.cpp
@@ -47,6 +51,7 @@ list (APPEND MAIN_SOURCE_FILES
   opm/simulators/linalg/setupPropertyTree.cpp
   opm/simulators/utils/PartiallySupportedFlowKeywords.cpp
   opm/simulators/utils/readDeck.cpp
+  opm/simulators/utils/StartupTimings.cpp
   opm/simulators/utils/UnsupportedFlowKeywords.cpp
   opm/simulators/timestepping/AdaptiveSimulatorTimer.cpp
   opm/simulators/timestepping/AdaptiveTimeSteppingEbos.cpp
@@ -125,6 +130,11 @@ endif()
 list (APPEND TEST_SOURCE_FILES
   tests/test_equil.cc
   tests/test_ecl_output.cc
+  tests/test_eclcheckpointfile.cc
+  tests/test_ecldistributedcelldata.cc
+  tests/test_eclpendingwrites.cc
+  tests/test_eclmappedrestartfile.cc
+  tests/test_ecltracersweepsolver.cc
   tests/test_blackoil_amg.cpp
   tests/test_convergencereport.cpp
   tests/test_flexiblesolver.cpp
@@ -133,6 +143,7 @@ list (APPEND TEST_SOURCE_FILES
   tests/test_vfpproperties.cpp
   tests/test_milu.cpp
   tests/test_multmatrixtransposed.cpp
+  tests/test_numericalaquifercondensation.cc
   tests/test_wellmodel.cpp
   tests/test_deferredlogger.cpp
   tests/test_timer.cpp
@@ -150,7 +161,8 @@ list (APPEND TEST_SOURCE_FILES
   )
 
 if(MPI_FOUND)
-  list(APPEND TEST_SOURCE_FILES tests/test_parallelistlinformation.cpp
+  list(APPEND TEST_SOURCE_FILES tests/test_inputcache.cpp
+                                tests/test_parallelistlinformation.cpp
                                 tests/test_ParallelRestart.cpp)
 endif()
 if(CUDA_FOUND)
@@ -167,6 +179,7 @@ list (APPEND TEST_DATA_FILES
   tests/equil_capillary_overlap.DATA
   tests/equil_capillary_swatinit.DATA
   tests/equil_deadfluids.DATA
+  tests/equil_thpres.DATA
   tests/equil_pbvd_and_pdvd.DATA
   tests/VFPPROD1
   tests/VFPPROD2
@@ -263,6 +276,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/linalg/ISTLSolverEbosFlexible.hpp
   opm/simulators/linalg/MatrixBlock.hpp
   opm/simulators/linalg/MatrixMarketSpecializations.hpp
+  opm/simulators/linalg/NumericalAquiferCondensation.hpp
   opm/simulators/linalg/OwningBlockPreconditioner.hpp
   opm/simulators/linalg/OwningTwoLevelPreconditioner.hpp
   opm/simulators/linalg/ParallelOverlappingILU0.hpp
@@ -294,10 +308,12 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/utils/ParallelEclipseState.hpp
   opm/simulators/utils/ParallelRestart.hpp
   opm/simulators/utils/PropsCentroidsDataHandle.hpp
+  opm/simulators/wells/ArraySlice.hpp
   opm/simulators/wells/PerfData.hpp
   opm/simulators/wells/PerforationData.hpp
   opm/simulators/wells/RateConverter.hpp
   opm/simulators/utils/readDeck.hpp
+  opm/simulators/utils/StartupTimings.hpp
   opm/simulators/wells/TargetCalculator.hpp
   opm/simulators/wells/WellConnectionAuxiliaryModule.hpp
   opm/simulators/wells/WellState.hpp
@@ -325,5 +341,6 @@ list (APPEND PUBLIC_HEADER_FILES
   )
 
 list (APPEND EXAMPLE_SOURCE_FILES
+  examples/mergedistributedrestart.cpp
   examples/printvfp.cpp
   )
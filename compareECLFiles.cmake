@@ -100,18 +100,51 @@ function(add_test_compare_restarted_simulation)
                TEST_ARGS ${PARAM_TEST_ARGS})
 endfunction()
 
+###########################################################################
+# TEST: add_test_compare_checkpointed_simulation
+###########################################################################
+
+# Input:
+#   - casename: basename (no extension)
+#
+# Details:
+#   - This test class compares the output from a simulation restarted
+#     from a checkpoint to that of a non-restarted simulation.
+function(add_test_compare_checkpointed_simulation)
+  set(oneValueArgs CASENAME FILENAME SIMULATOR ABS_TOL REL_TOL DIR TEST_NAME)
+  set(multiValueArgs TEST_ARGS)
+  cmake_parse_arguments(PARAM "$" "${oneValueArgs}" "${multiValueArgs}" ${ARGN} )
+  if(NOT PARAM_DIR)
+    set(PARAM_DIR ${PARAM_CASENAME})
+  endif()
+  if(NOT PARAM_TEST_NAME)
+    set(PARAM_TEST_NAME ${PARAM_FILENAME})
+  endif()
+  set(RESULT_PATH ${BASE_RESULT_PATH}/checkpoint/${PARAM_SIMULATOR}+${PARAM_TEST_NAME})
+  opm_add_test(compareCheckpointedSim_${PARAM_SIMULATOR}+${PARAM_TEST_NAME} NO_COMPILE
+               EXE_NAME ${PARAM_SIMULATOR}
+               DRIVER_ARGS ${OPM_TESTS_ROOT}/${PARAM_DIR} ${RESULT_PATH}
+                           ${PROJECT_BINARY_DIR}/bin
+                           ${PARAM_FILENAME}
+                           ${PARAM_ABS_TOL} ${PARAM_REL_TOL}
+                           ${COMPARE_ECL_COMMAND}
+                           ${OPM_PACK_COMMAND}
+               TEST_ARGS ${PARAM_TEST_ARGS})
+endfunction()
+
 ###########################################################################
 # TEST: add_test_compare_parallel_simulation
 ###########################################################################
 
 # Input:
 #   - casename: basename (no extension)
+#   - data_dir: directory of the deck, defaults to ${OPM_TESTS_ROOT}/<dir>
 #
 # Details:
 #   - This test class compares the output from a parallel simulation
 #     to the output from the serial instance of the same model.
 function(add_test_compare_parallel_simulation)
-  set(oneValueArgs CASENAME FILENAME SIMULATOR ABS_TOL REL_TOL DIR)
+  set(oneValueArgs CASENAME FILENAME SIMULATOR ABS_TOL REL_TOL DIR DATA_DIR)
   set(multiValueArgs TEST_ARGS)
   cmake_parse_arguments(PARAM "$" "${oneValueArgs}" "${multiValueArgs}" ${ARGN} )
 
@@ -119,13 +152,17 @@ function(add_test_compare_parallel_simulation)
     set(PARAM_DIR ${PARAM_CASENAME})
   endif()
 
+  if(NOT PARAM_DATA_DIR)
+    set(PARAM_DATA_DIR ${OPM_TESTS_ROOT}/${PARAM_DIR})
+  endif()
+
   set(RESULT_PATH ${BASE_RESULT_PATH}/parallel/${PARAM_SIMULATOR}+${PARAM_CASENAME})
-  set(TEST_ARGS ${OPM_TESTS_ROOT}/${PARAM_DIR}/${PARAM_FILENAME} ${PARAM_TEST_ARGS})
+  set(TEST_ARGS ${PARAM_DATA_DIR}/${PARAM_FILENAME} ${PARAM_TEST_ARGS})
 
   # Add test that runs flow_mpi and outputs the results to file
   opm_add_test(compareParallelSim_${PARAM_SIMULATOR}+${PARAM_FILENAME} NO_COMPILE
                EXE_NAME ${PARAM_SIMULATOR}
-               DRIVER_ARGS ${OPM_TESTS_ROOT}/${PARAM_DIR} ${RESULT_PATH}
+               DRIVER_ARGS ${PARAM_DATA_DIR} ${RESULT_PATH}
                            ${PROJECT_BINARY_DIR}/bin
                            ${PARAM_FILENAME}
                            ${PARAM_ABS_TOL} ${PARAM_REL_TOL}
@@ -962,6 +999,29 @@ add_test(NAME NORNE_RESTART
          COMMAND flow --output-dir=${BASE_RESULT_PATH}/norne-restart ${OPM_TESTS_ROOT}/norne/NORNE_ATW2013_RESTART.DATA)
 
 
+# Checkpoint tests. The checkpoints hold the state of the wells in a format
+# which needs MPI, and restarts from them are meant to be bit-identical.
+if(MPI_FOUND)
+  opm_set_test_driver(${PROJECT_SOURCE_DIR}/tests/run-checkpoint-regressionTest.sh "")
+  add_test_compare_checkpointed_simulation(CASENAME spe1
+                                           FILENAME SPE1CASE2_ACTNUM
+                                           SIMULATOR flow
+                                           ABS_TOL 0
+                                           REL_TOL 0)
+  add_test_compare_checkpointed_simulation(CASENAME spe9
+                                           FILENAME SPE9_CP_SHORT
+                                           SIMULATOR flow
+                                           ABS_TOL 0
+                                           REL_TOL 0)
+  add_test_compare_checkpointed_simulation(CASENAME spe9
+                                           FILENAME SPE9_CP_SHORT
+                                           TEST_NAME SPE9_CP_SHORT_SUBSTEPS
+                                           SIMULATOR flow
+                                           ABS_TOL 0
+                                           REL_TOL 0
+                                           TEST_ARGS --ecl-checkpoint-sub-steps=true)
+endif()
+
 # Parallel tests
 if(MPI_FOUND)
   opm_set_test_driver(${PROJECT_SOURCE_DIR}/tests/run-parallel-restart-regressionTest.sh "")
@@ -1116,4 +1176,14 @@ endif()
                                        REL_TOL ${coarse_rel_tol_parallel}
                                        DIR udq_actionx
                                        TEST_ARGS --linear-solver-reduction=1e-7 --tolerance-cnv=5e-6 --tolerance-mb=1e-6)
+
+  # The tracer concentrations of the summary (WTPR/WTIR/WTPT/WTIT) and
+  # restart files are compared as well, which covers the distributed
+  # tracer solve.
+  add_test_compare_parallel_simulation(CASENAME tracer_water
+                                       FILENAME TRACER_WATER
+                                       SIMULATOR flow
+                                       ABS_TOL ${abs_tol_parallel}
+                                       REL_TOL ${coarse_rel_tol_parallel}
+                                       DATA_DIR ${PROJECT_SOURCE_DIR}/tests)
 endif()
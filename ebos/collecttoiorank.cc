@@ -39,6 +39,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <initializer_list>
 #include <stdexcept>
 #include <string>
 
@@ -308,11 +309,18 @@ public:
                 assert(ret.second);
             }
 
-            MessageBufferType buffer;
-            pack(0, buffer);
-
-            // the last index map is the local one
-            doUnpack(indexMaps.back(), buffer);
+            // the last index map is the local one. Copy the local data
+            // straight into the global arrays instead of going through a
+            // message buffer holding a second copy of it.
+            const IndexMapType& indexMap = indexMaps.back();
+            for (const auto& pair : localCellData_) {
+                const auto& localData = pair.second.data;
+                auto& globalData = globalCellData_.data(pair.first);
+                assert(indexMap.size() == localIndexMap_.size());
+                for (std::size_t i = 0; i < indexMap.size(); ++i) {
+                    globalData[indexMap[i]] = localData[localIndexMap_[i]];
+                }
+            }
         }
     }
 
@@ -716,6 +724,34 @@ private:
 };
 
 
+/// \brief Packs the data of several handles into one message per link.
+///
+/// Collecting all output data then needs a single exchange with the I/O
+/// rank instead of one synchronising exchange per kind of data.
+class PackUnPackCollection : public P2PCommunicatorType::DataHandleInterface
+{
+    std::vector<P2PCommunicatorType::DataHandleInterface*> handles_;
+
+public:
+    explicit PackUnPackCollection(std::initializer_list<P2PCommunicatorType::DataHandleInterface*> handles)
+        : handles_(handles)
+    {}
+
+    // pack the data of all handles, in order
+    void pack(int link, MessageBufferType& buffer)
+    {
+        for (auto* handle : handles_)
+            handle->pack(link, buffer);
+    }
+
+    // unpack the data of all handles, in the order they were packed
+    void unpack(int link, MessageBufferType& buffer)
+    {
+        for (auto* handle : handles_)
+            handle->unpack(link, buffer);
+    }
+};
+
 template <class Grid, class EquilGrid, class GridView>
 CollectDataToIORank<Grid,EquilGrid,GridView>::
 CollectDataToIORank(const Grid& grid, const EquilGrid* equilGrid,
@@ -900,12 +936,17 @@ collect(const data::Solution& localCellData,
                 this->isIORank()
     };
 
-    toIORankComm_.exchange(packUnpackCellData);
-    toIORankComm_.exchange(packUnpackWellData);
-    toIORankComm_.exchange(packUnpackGroupAndNetworkData);
-    toIORankComm_.exchange(packUnpackBlockData);
-    toIORankComm_.exchange(packUnpackWBPData);
-    toIORankComm_.exchange(packUnpackAquiferData);
+    // send everything in one message per rank
+    PackUnPackCollection packUnpackAll {
+        &packUnpackCellData,
+        &packUnpackWellData,
+        &packUnpackGroupAndNetworkData,
+        &packUnpackBlockData,
+        &packUnpackWBPData,
+        &packUnpackAquiferData
+    };
+
+    toIORankComm_.exchange(packUnpackAll);
 
 #ifndef NDEBUG
     // make sure every process is on the same page
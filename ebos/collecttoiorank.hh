@@ -80,6 +80,13 @@ public:
     const data::Solution& globalCellData() const
     { return globalCellData_; }
 
+    /// \brief Hand over the collected global cell data.
+    ///
+    /// Moves the global arrays out of the collector, so the I/O rank
+    /// does not keep a second global copy until the next collect().
+    data::Solution releaseGlobalCellData()
+    { return std::move(globalCellData_); }
+
     const data::Wells& globalWellData() const
     { return globalWellData_; }
 
@@ -37,6 +37,7 @@
 #include <opm/grid/common/CartesianIndexMapper.hpp>
 #include <opm/parser/eclipse/EclipseState/Aquifer/NumericalAquifer/NumericalAquiferCell.hpp>
 #include <opm/simulators/flow/BlackoilModelParametersEbos.hpp>
+#include <opm/simulators/utils/StartupTimings.hpp>
 
 #include <array>
 #include <optional>
@@ -76,6 +77,10 @@ struct EclOutputInterval {
     using type = UndefinedProperty;
 };
 template<class TypeTag, class MyTypeTag>
+struct EclInputCacheFile {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
 struct IgnoreKeywords {
     using type = UndefinedProperty;
 };
@@ -116,6 +121,10 @@ struct EclOutputInterval<TypeTag, TTag::EclBaseVanguard> {
     static constexpr int value = -1;
 };
 template<class TypeTag>
+struct EclInputCacheFile<TypeTag, TTag::EclBaseVanguard> {
+    static constexpr auto value = "";
+};
+template<class TypeTag>
 struct EnableOpmRstFile<TypeTag, TTag::EclBaseVanguard> {
     static constexpr bool value = false;
 };
@@ -199,6 +208,8 @@ public:
                              "The name of the file which contains the ECL deck to be simulated");
         EWOMS_REGISTER_PARAM(TypeTag, int, EclOutputInterval,
                              "The number of report steps that ought to be skipped between two writes of ECL results");
+        EWOMS_REGISTER_PARAM(TypeTag, std::string, EclInputCacheFile,
+                             "File caching the parsed ECL deck. It is read instead of parsing the deck if it matches the deck and its include files, and written otherwise. Empty disables the cache.");
         EWOMS_REGISTER_PARAM(TypeTag, bool, EnableOpmRstFile,
                              "Include OPM-specific keywords in the ECL restart file to enable restart of OPM simulators from these files");
         EWOMS_REGISTER_PARAM(TypeTag, std::string, IgnoreKeywords,
@@ -388,8 +399,11 @@ public:
 protected:
     void callImplementationInit()
     {
-        asImp_().createGrids_();
-        asImp_().filterConnections_();
+        {
+            StartupPhaseTimer timer("Creating grid");
+            asImp_().createGrids_();
+            asImp_().filterConnections_();
+        }
         std::string outputDir = EWOMS_GET_PARAM(TypeTag, std::string, OutputDir);
         bool enableEclCompatFile = !EWOMS_GET_PARAM(TypeTag, bool, EnableOpmRstFile);
         asImp_().updateOutputDir_(outputDir, enableEclCompatFile);
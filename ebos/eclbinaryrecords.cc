@@ -0,0 +1,211 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+
+#include <config.h>
+#include <ebos/eclbinaryrecords.hh>
+
+#include <opm/common/ErrorMacros.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::size_t headerSize = 4 + 8 + 4 + 4 + 4;
+constexpr std::size_t numericBlockSize = 1000;
+constexpr std::size_t charBlockSize = 105;
+
+template <class UInt>
+UInt fromBigEndian(const char* p)
+{
+    UInt value = 0;
+    for (std::size_t i = 0; i < sizeof(UInt); ++i)
+        value = (value << 8) | static_cast<unsigned char>(p[i]);
+    return value;
+}
+
+void writeBigEndian(std::ostream& os, std::int32_t value)
+{
+    const auto bits = static_cast<std::uint32_t>(value);
+    const char bytes[4] = {static_cast<char>(bits >> 24), static_cast<char>(bits >> 16),
+                           static_cast<char>(bits >> 8), static_cast<char>(bits)};
+    os.write(bytes, sizeof(bytes));
+}
+
+std::string trimmed(const char* p, std::size_t length)
+{
+    std::string s(p, length);
+    s.erase(s.find_last_not_of(' ') + 1);
+    return s;
+}
+
+// The element size and number of elements per block of an array type
+std::pair<std::size_t, std::size_t> typeLayout(const std::string& type,
+                                               const std::string& fileName)
+{
+    if (type == "INTE" || type == "REAL" || type == "LOGI")
+        return {4, numericBlockSize};
+    if (type == "DOUB")
+        return {8, numericBlockSize};
+    if (type == "CHAR")
+        return {8, charBlockSize};
+    if (type == "MESS")
+        return {0, numericBlockSize};
+    if (type.size() == 4 && type[0] == 'C' &&
+        std::isdigit(static_cast<unsigned char>(type[1])) &&
+        std::isdigit(static_cast<unsigned char>(type[2])) &&
+        std::isdigit(static_cast<unsigned char>(type[3])))
+        return {std::stoul(type.substr(1)), charBlockSize};
+
+    OPM_THROW(std::runtime_error, "Unknown array type '" << type << "' in '" << fileName << "'");
+}
+
+}
+
+namespace Opm::EclBinary {
+
+MappedFile::MappedFile(const std::string& fileName)
+    : fileName_(fileName)
+{
+    const int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+        OPM_THROW(std::runtime_error, "Could not open file '" << fileName << "'");
+
+    struct stat fileStat;
+    if (::fstat(fd, &fileStat) != 0) {
+        ::close(fd);
+        OPM_THROW(std::runtime_error, "Could not determine the size of file '" << fileName << "'");
+    }
+
+    size_ = fileStat.st_size;
+    if (size_ > 0) {
+        void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED)
+            OPM_THROW(std::runtime_error, "Could not map file '" << fileName << "' into memory");
+        data_ = static_cast<const char*>(addr);
+    }
+    else
+        ::close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_)
+        ::munmap(const_cast<char*>(data_), size_);
+}
+
+Record readRecord(const MappedFile& file, std::size_t pos)
+{
+    const char* data = file.data();
+    if (pos + headerSize > file.size() ||
+        readInt(data + pos) != 16 ||
+        readInt(data + pos + headerSize - 4) != 16)
+        OPM_THROW(std::runtime_error, "'" << file.fileName() << "' is not a binary ECL file");
+
+    Record record;
+    record.name = trimmed(data + pos + 4, 8);
+    const std::int32_t count = readInt(data + pos + 12);
+    record.type = std::string(data + pos + 16, 4);
+    if (count < 0)
+        OPM_THROW(std::runtime_error, "'" << file.fileName() << "' is not a binary ECL file");
+
+    const auto [elemSize, blockSize] = typeLayout(record.type, file.fileName());
+    const std::size_t numBlocks = (count + blockSize - 1)/blockSize;
+    const std::size_t dataBytes = elemSize > 0 ? count*elemSize + numBlocks*8 : 0;
+
+    record.count = count;
+    record.elemSize = elemSize;
+    record.begin = pos;
+    record.dataBegin = pos + headerSize;
+    record.end = record.dataBegin + dataBytes;
+    if (record.end > file.size())
+        OPM_THROW(std::runtime_error, "'" << file.fileName() << "' is truncated");
+
+    return record;
+}
+
+std::size_t elementOffset(const Record& record, std::size_t index)
+{
+    const std::size_t stride = numericBlockSize*record.elemSize + 8;
+    return record.dataBegin
+        + (index / numericBlockSize)*stride
+        + 4 + (index % numericBlockSize)*record.elemSize;
+}
+
+std::int32_t readInt(const char* p)
+{ return static_cast<std::int32_t>(fromBigEndian<std::uint32_t>(p)); }
+
+float readFloat(const char* p)
+{
+    const auto bits = fromBigEndian<std::uint32_t>(p);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+double readDouble(const char* p)
+{
+    const auto bits = fromBigEndian<std::uint64_t>(p);
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+void writeArray(std::ostream& os,
+                const std::string& name,
+                const std::string& type,
+                std::size_t elemSize,
+                const char* data,
+                std::size_t count)
+{
+    if (name.size() > 8 || type.size() != 4)
+        OPM_THROW(std::logic_error, "Invalid array name '" << name << "' or type '" << type << "'");
+
+    std::string paddedName = name;
+    paddedName.resize(8, ' ');
+
+    writeBigEndian(os, 16);
+    os.write(paddedName.data(), 8);
+    writeBigEndian(os, static_cast<std::int32_t>(count));
+    os.write(type.data(), 4);
+    writeBigEndian(os, 16);
+
+    for (std::size_t first = 0; first < count; first += numericBlockSize) {
+        const std::size_t numBytes = std::min(numericBlockSize, count - first)*elemSize;
+        writeBigEndian(os, static_cast<std::int32_t>(numBytes));
+        os.write(data + first*elemSize, numBytes);
+        writeBigEndian(os, static_cast<std::int32_t>(numBytes));
+    }
+}
+
+} // namespace Opm::EclBinary
@@ -0,0 +1,125 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/**
+ * \file
+ *
+ * \brief Low level access to the records of binary ECL files.
+ */
+#ifndef EWOMS_ECL_BINARY_RECORDS_HH
+#define EWOMS_ECL_BINARY_RECORDS_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace Opm::EclBinary {
+
+/*!
+ * \brief A binary file mapped read-only into memory.
+ */
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string& fileName);
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile();
+
+    const char* data() const
+    { return data_; }
+
+    std::size_t size() const
+    { return size_; }
+
+    const std::string& fileName() const
+    { return fileName_; }
+
+private:
+    std::string fileName_;
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+/*!
+ * \brief The location of one array of a binary ECL file.
+ *
+ * Every array consists of a header record (name, number of elements and type)
+ * followed by the data records. All records are written as Fortran
+ * unformatted sequential records, i.e. enclosed by their length in bytes.
+ * Numeric arrays are split into records of 1000 elements, character arrays
+ * into records of 105 elements.
+ */
+struct Record
+{
+    std::string name;
+    std::string type;
+    std::size_t count;
+
+    //! The offset of the header record
+    std::size_t begin;
+
+    //! The offset of the first data record
+    std::size_t dataBegin;
+
+    //! The offset behind the last data record
+    std::size_t end;
+
+    //! The size of an element in bytes
+    std::size_t elemSize;
+};
+
+/*!
+ * \brief Locate the array whose header record starts at the given offset.
+ *
+ * Throws if the file is not a binary ECL file or if it is truncated.
+ */
+Record readRecord(const MappedFile& file, std::size_t pos);
+
+/*!
+ * \brief Returns the offset of an element of a numeric array.
+ */
+std::size_t elementOffset(const Record& record, std::size_t index);
+
+std::int32_t readInt(const char* p);
+float readFloat(const char* p);
+double readDouble(const char* p);
+
+/*!
+ * \brief Write a numeric array.
+ *
+ * The elements are given in their big-endian on-disk representation, i.e.
+ * count*elemSize bytes.
+ */
+void writeArray(std::ostream& os,
+                const std::string& name,
+                const std::string& type,
+                std::size_t elemSize,
+                const char* data,
+                std::size_t count);
+
+} // namespace Opm::EclBinary
+
+#endif
@@ -0,0 +1,211 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+
+#include <config.h>
+#include <ebos/eclcheckpointfile.hh>
+
+#include <opm/common/ErrorMacros.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+constexpr std::array<char, 8> checkpointMagic{'O', 'P', 'M', 'C', 'K', 'P', 'T', '1'};
+constexpr std::uint32_t byteOrderMarker = 0x01020304;
+constexpr std::uint32_t formatVersion = 1;
+constexpr std::size_t nameLength = 16;
+constexpr std::size_t alignment = 8;
+
+struct SectionHeader
+{
+    char name[nameLength];
+    std::uint64_t elemSize;
+    std::uint64_t count;
+};
+
+static_assert(sizeof(SectionHeader) % alignment == 0,
+              "Section headers must keep the payload aligned");
+
+std::size_t paddedSize(std::size_t numBytes)
+{
+    return (numBytes + alignment - 1) / alignment * alignment;
+}
+
+// The restart file name without its extension.
+std::string checkpointBaseName(const std::string& restartFileName)
+{
+    std::string base = restartFileName;
+    const auto dotPos = base.find_last_of('.');
+    const auto slashPos = base.find_last_of('/');
+    if (dotPos != std::string::npos &&
+        (slashPos == std::string::npos || dotPos > slashPos))
+        base.erase(dotPos);
+
+    return base;
+}
+
+}
+
+namespace Opm {
+
+std::string eclCheckpointFileName(const std::string& restartFileName,
+                                  int reportStep,
+                                  int rank)
+{
+    return fmt::format("{}_{:04d}.{}.OPMCKPT", checkpointBaseName(restartFileName), reportStep, rank);
+}
+
+std::string eclCheckpointMarkerFileName(const std::string& restartFileName,
+                                        int reportStep)
+{
+    return fmt::format("{}_{:04d}.OPMCKPT", checkpointBaseName(restartFileName), reportStep);
+}
+
+EclCheckpointWriter::EclCheckpointWriter(const std::string& fileName)
+    : fileName_(fileName)
+    , os_(fileName + ".tmp", std::ios::binary | std::ios::trunc)
+{
+    if (!os_)
+        OPM_THROW(std::runtime_error, "Could not open checkpoint file '" << fileName_ << "' for writing");
+
+    os_.write(checkpointMagic.data(), checkpointMagic.size());
+    os_.write(reinterpret_cast<const char*>(&byteOrderMarker), sizeof(byteOrderMarker));
+    os_.write(reinterpret_cast<const char*>(&formatVersion), sizeof(formatVersion));
+}
+
+void EclCheckpointWriter::close()
+{
+    os_.flush();
+    if (!os_)
+        OPM_THROW(std::runtime_error, "Could not write checkpoint file '" << fileName_ << "'");
+    os_.close();
+
+    // the file is written under a temporary name and only replaces an existing
+    // checkpoint once it is complete
+    if (std::rename((fileName_ + ".tmp").c_str(), fileName_.c_str()) != 0)
+        OPM_THROW(std::runtime_error, "Could not move checkpoint file '" << fileName_ << "' into place");
+}
+
+void EclCheckpointWriter::writeRaw_(const std::string& name, const void* data,
+                                    std::size_t elemSize, std::size_t count)
+{
+    if (name.size() >= nameLength)
+        OPM_THROW(std::logic_error, "Checkpoint section name '" << name << "' is too long");
+
+    SectionHeader header{};
+    std::copy(name.begin(), name.end(), header.name);
+    header.elemSize = elemSize;
+    header.count = count;
+    os_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    const std::size_t numBytes = elemSize*count;
+    if (numBytes > 0)
+        os_.write(static_cast<const char*>(data), numBytes);
+
+    static const std::array<char, alignment> zeros{};
+    os_.write(zeros.data(), paddedSize(numBytes) - numBytes);
+}
+
+EclCheckpointReader::EclCheckpointReader(const std::string& fileName)
+    : fileName_(fileName)
+{
+    std::ifstream is(fileName, std::ios::binary | std::ios::ate);
+    if (!is)
+        OPM_THROW(std::runtime_error, "Could not open checkpoint file '" << fileName_ << "'");
+
+    buffer_.resize(is.tellg());
+    is.seekg(0);
+    is.read(buffer_.data(), buffer_.size());
+    if (!is)
+        OPM_THROW(std::runtime_error, "Could not read checkpoint file '" << fileName_ << "'");
+
+    constexpr std::size_t fileHeaderSize =
+        checkpointMagic.size() + sizeof(byteOrderMarker) + sizeof(formatVersion);
+    if (buffer_.size() < fileHeaderSize ||
+        !std::equal(checkpointMagic.begin(), checkpointMagic.end(), buffer_.begin()))
+        OPM_THROW(std::runtime_error, "'" << fileName_ << "' is not a checkpoint file");
+
+    std::uint32_t marker;
+    std::uint32_t version;
+    std::memcpy(&marker, buffer_.data() + checkpointMagic.size(), sizeof(marker));
+    std::memcpy(&version, buffer_.data() + checkpointMagic.size() + sizeof(marker), sizeof(version));
+    if (marker != byteOrderMarker)
+        OPM_THROW(std::runtime_error, "Checkpoint file '" << fileName_
+                  << "' was written on a machine with a different byte order");
+    if (version != formatVersion)
+        OPM_THROW(std::runtime_error, "Checkpoint file '" << fileName_
+                  << "' has unsupported format version " << version);
+
+    std::size_t offset = fileHeaderSize;
+    while (offset < buffer_.size()) {
+        if (offset + sizeof(SectionHeader) > buffer_.size())
+            OPM_THROW(std::runtime_error, "Checkpoint file '" << fileName_ << "' is truncated");
+
+        SectionHeader header;
+        std::memcpy(&header, buffer_.data() + offset, sizeof(header));
+        offset += sizeof(header);
+
+        const std::size_t numBytes = header.elemSize*header.count;
+        if (offset + numBytes > buffer_.size())
+            OPM_THROW(std::runtime_error, "Checkpoint file '" << fileName_ << "' is truncated");
+
+        const std::string name(header.name, std::find(header.name, header.name + nameLength, '\0'));
+        sections_[name] = Section{offset, header.elemSize, header.count};
+        offset += paddedSize(numBytes);
+    }
+}
+
+std::size_t EclCheckpointReader::size(const std::string& name) const
+{
+    auto it = sections_.find(name);
+    if (it == sections_.end())
+        OPM_THROW(std::runtime_error, "Checkpoint file '" << fileName_
+                  << "' does not contain section '" << name << "'");
+    return it->second.count;
+}
+
+void EclCheckpointReader::readRaw_(const std::string& name, void* data,
+                                   std::size_t elemSize, std::size_t count) const
+{
+    auto it = sections_.find(name);
+    if (it == sections_.end())
+        OPM_THROW(std::runtime_error, "Checkpoint file '" << fileName_
+                  << "' does not contain section '" << name << "'");
+
+    const Section& section = it->second;
+    if (section.elemSize != elemSize || section.count != count)
+        OPM_THROW(std::runtime_error, "Section '" << name << "' of checkpoint file '" << fileName_
+                  << "' has " << section.count << " elements of size " << section.elemSize
+                  << ", expected " << count << " elements of size " << elemSize);
+
+    if (count > 0)
+        std::memcpy(data, buffer_.data() + section.offset, elemSize*count);
+}
+
+} // namespace Opm
@@ -0,0 +1,167 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/**
+ * \file
+ *
+ * \copydoc Opm::EclCheckpointWriter
+ */
+#ifndef EWOMS_ECL_CHECKPOINT_FILE_HH
+#define EWOMS_ECL_CHECKPOINT_FILE_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Opm {
+
+/*!
+ * \brief Returns the name of the checkpoint file of a process for a report step.
+ *
+ * The name is derived from the name of the ECL restart file of the same step,
+ * so checkpoints end up next to the restart files and are found by the same
+ * RESTART keyword.
+ */
+std::string eclCheckpointFileName(const std::string& restartFileName,
+                                  int reportStep,
+                                  int rank);
+
+/*!
+ * \brief Returns the name of the marker file of the checkpoint of a report step.
+ *
+ * The marker file is written once the checkpoint files of all processes are
+ * complete. It records the number of processes and the time of the checkpoint,
+ * and a checkpoint is only used for a restart if its marker file exists.
+ */
+std::string eclCheckpointMarkerFileName(const std::string& restartFileName,
+                                        int reportStep);
+
+/*!
+ * \brief Writes a native checkpoint file.
+ *
+ * A checkpoint file holds named sections of raw data in the byte order of the
+ * writing machine. It starts with a fixed header containing a byte order
+ * marker. Each section is a fixed-size descriptor (name, element size, element
+ * count) followed by its payload, padded to a multiple of eight bytes. Every
+ * payload thus starts at an aligned offset and can be used in place if the
+ * file is mapped into memory. The values are stored exactly, so reading a
+ * checkpoint gives back bitwise identical data.
+ */
+class EclCheckpointWriter
+{
+public:
+    explicit EclCheckpointWriter(const std::string& fileName);
+
+    template <class T>
+    void write(const std::string& name, const T* data, std::size_t count)
+    {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "Checkpoint sections must consist of trivially copyable values");
+        writeRaw_(name, data, sizeof(T), count);
+    }
+
+    template <class T>
+    void write(const std::string& name, const std::vector<T>& data)
+    { write(name, data.data(), data.size()); }
+
+    /*!
+     * \brief Flushes the file and throws if anything could not be written.
+     *
+     * The data is written to a temporary file which only replaces the
+     * checkpoint file here, so an interrupted write does not destroy an
+     * existing checkpoint.
+     */
+    void close();
+
+private:
+    void writeRaw_(const std::string& name, const void* data,
+                   std::size_t elemSize, std::size_t count);
+
+    std::string fileName_;
+    std::ofstream os_;
+};
+
+/*!
+ * \brief Reads a checkpoint file written by EclCheckpointWriter.
+ *
+ * The file is read in one go and the sections are located by their
+ * descriptors. No conversion takes place; files written on a machine with
+ * another byte order are rejected.
+ */
+class EclCheckpointReader
+{
+public:
+    explicit EclCheckpointReader(const std::string& fileName);
+
+    bool has(const std::string& name) const
+    { return sections_.count(name) > 0; }
+
+    /*!
+     * \brief Returns the number of elements of a section.
+     */
+    std::size_t size(const std::string& name) const;
+
+    /*!
+     * \brief Copies the elements of a section to the given location.
+     *
+     * Throws if the section does not exist or if its element size or number
+     * of elements differs from the expected ones.
+     */
+    template <class T>
+    void read(const std::string& name, T* data, std::size_t count) const
+    {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "Checkpoint sections must consist of trivially copyable values");
+        readRaw_(name, data, sizeof(T), count);
+    }
+
+    template <class T>
+    std::vector<T> read(const std::string& name) const
+    {
+        std::vector<T> data(size(name));
+        read(name, data.data(), data.size());
+        return data;
+    }
+
+private:
+    struct Section
+    {
+        std::size_t offset;
+        std::size_t elemSize;
+        std::size_t count;
+    };
+
+    void readRaw_(const std::string& name, void* data,
+                  std::size_t elemSize, std::size_t count) const;
+
+    std::string fileName_;
+    std::vector<char> buffer_;
+    std::map<std::string, Section> sections_;
+};
+
+} // namespace Opm
+
+#endif
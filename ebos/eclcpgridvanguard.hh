@@ -130,6 +130,7 @@ public:
      */
     void loadBalance()
     {
+        StartupPhaseTimer timer("Load balancing");
 #if HAVE_MPI
         this->doLoadBalance_(this->edgeWeightsMethod(), this->ownersFirst(),
                              this->serialPartitioning(), this->enableDistributedWells(),
@@ -0,0 +1,257 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+
+#include <config.h>
+#include <ebos/ecldistributedcelldata.hh>
+#include <ebos/eclbinaryrecords.hh>
+
+#include <opm/common/ErrorMacros.hpp>
+#include <opm/io/eclipse/EclOutput.hpp>
+#include <opm/output/data/Solution.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+using Opm::EclBinary::Record;
+
+// The cell data written by one process
+struct CellDataFile
+{
+    explicit CellDataFile(const std::string& fileName);
+
+    Opm::EclBinary::MappedFile file;
+    std::vector<int> globalIndices;
+
+    // the arrays of each report step, including the ENDSOL message
+    std::map<int, std::vector<Record>> steps;
+};
+
+CellDataFile::CellDataFile(const std::string& fileName)
+    : file(fileName)
+{
+    using namespace Opm::EclBinary;
+
+    const auto cellIdx = readRecord(file, 0);
+    if (cellIdx.name != "CELLIDX" || cellIdx.type != "INTE")
+        OPM_THROW(std::runtime_error, "'" << fileName << "' is not a distributed cell data file");
+
+    globalIndices.resize(cellIdx.count);
+    for (std::size_t i = 0; i < cellIdx.count; ++i)
+        globalIndices[i] = readInt(file.data() + elementOffset(cellIdx, i));
+
+    std::vector<Record>* step = nullptr;
+    std::size_t pos = cellIdx.end;
+    while (pos < file.size()) {
+        auto record = readRecord(file, pos);
+        pos = record.end;
+
+        if (record.name == "SEQNUM" && record.type == "INTE" && record.count == 1)
+            step = &steps[readInt(file.data() + elementOffset(record, 0))];
+        else if (step)
+            step->push_back(std::move(record));
+        else
+            OPM_THROW(std::runtime_error, "'" << fileName << "' is not a distributed cell data file");
+    }
+}
+
+// Write the solution arrays, i.e. the ones in front of ENDSOL, or the auxiliary
+// arrays behind it of a report step.
+void writeCellArrays(std::ostream& os,
+                     const std::vector<std::unique_ptr<CellDataFile>>& files,
+                     int reportStep,
+                     bool auxiliary,
+                     std::size_t numCells)
+{
+    std::vector<std::pair<const Record*, const Record*>> parts;
+    for (const auto& cellData : files) {
+        const auto stepIt = cellData->steps.find(reportStep);
+        if (stepIt == cellData->steps.end())
+            OPM_THROW(std::runtime_error, "'" << cellData->file.fileName()
+                      << "' does not contain the cell data of report step " << reportStep);
+
+        const auto& records = stepIt->second;
+        const auto endSol = std::find_if(records.begin(), records.end(),
+                                         [](const Record& record)
+                                         { return record.name == "ENDSOL" && record.type == "MESS"; });
+        if (endSol == records.end())
+            OPM_THROW(std::runtime_error, "'" << cellData->file.fileName()
+                      << "' is not a distributed cell data file");
+
+        if (auxiliary)
+            parts.emplace_back(records.data() + (endSol - records.begin()) + 1,
+                               records.data() + records.size());
+        else
+            parts.emplace_back(records.data(), records.data() + (endSol - records.begin()));
+    }
+
+    const std::size_t numArrays = parts[0].second - parts[0].first;
+    std::vector<char> values;
+    for (std::size_t arrayIdx = 0; arrayIdx < numArrays; ++arrayIdx) {
+        const Record& first = parts[0].first[arrayIdx];
+        if (first.type != "INTE" && first.type != "REAL" && first.type != "DOUB")
+            OPM_THROW(std::runtime_error, "Cell array " << first.name
+                      << " of report step " << reportStep << " is not numeric");
+
+        values.assign(numCells*first.elemSize, 0);
+        for (std::size_t fileIdx = 0; fileIdx < files.size(); ++fileIdx) {
+            const auto& cellData = *files[fileIdx];
+            const auto& [begin, end] = parts[fileIdx];
+            if (static_cast<std::size_t>(end - begin) != numArrays ||
+                begin[arrayIdx].name != first.name ||
+                begin[arrayIdx].type != first.type ||
+                begin[arrayIdx].count != cellData.globalIndices.size())
+                OPM_THROW(std::runtime_error, "'" << cellData.file.fileName()
+                          << "' does not match the other cell data files in report step "
+                          << reportStep);
+
+            for (std::size_t i = 0; i < cellData.globalIndices.size(); ++i)
+                std::memcpy(values.data() + cellData.globalIndices[i]*first.elemSize,
+                            cellData.file.data() + Opm::EclBinary::elementOffset(begin[arrayIdx], i),
+                            first.elemSize);
+        }
+
+        Opm::EclBinary::writeArray(os, first.name, first.type, first.elemSize,
+                                   values.data(), numCells);
+    }
+}
+
+}
+
+namespace Opm {
+
+std::string eclDistributedCellDataFileName(const std::string& outputDir,
+                                           const std::string& baseName,
+                                           int rank)
+{
+    return fmt::format("{}/{}.{}.OPMCELL", outputDir, baseName, rank);
+}
+
+EclDistributedCellWriter::EclDistributedCellWriter(const std::string& fileName,
+                                                   const std::vector<int>& globalIndices)
+    : output_(std::make_unique<EclIO::EclOutput>(fileName, /*formatted=*/false))
+    , numCells_(globalIndices.size())
+{
+    output_->write("CELLIDX", globalIndices);
+    output_->flushStream();
+}
+
+EclDistributedCellWriter::~EclDistributedCellWriter() = default;
+
+void EclDistributedCellWriter::writeStep(int reportStep,
+                                         const data::Solution& solution,
+                                         bool doublePrecision,
+                                         bool writeAuxiliary)
+{
+    // check before writing anything, so a failed step leaves no partial records
+    for (const auto& [name, cellData] : solution) {
+        const bool written = cellData.target == data::TargetType::RESTART_SOLUTION ||
+            (writeAuxiliary && cellData.target == data::TargetType::RESTART_AUXILIARY);
+        if (written && cellData.data.size() != numCells_)
+            OPM_THROW(std::logic_error, "Cell array " << name << " has " << cellData.data.size()
+                      << " values, expected " << numCells_);
+    }
+
+    const auto writeArrays = [this, &solution, doublePrecision](data::TargetType target)
+    {
+        for (const auto& [name, cellData] : solution) {
+            if (cellData.target != target)
+                continue;
+
+            if (doublePrecision)
+                output_->write(name, cellData.data);
+            else
+                output_->write(name, std::vector<float>(cellData.data.begin(), cellData.data.end()));
+        }
+    };
+
+    output_->write("SEQNUM", std::vector<int>{reportStep});
+    writeArrays(data::TargetType::RESTART_SOLUTION);
+    output_->message("ENDSOL");
+    if (writeAuxiliary)
+        writeArrays(data::TargetType::RESTART_AUXILIARY);
+
+    // the file must be complete when the run ends, whichever way it ends
+    output_->flushStream();
+}
+
+void mergeEclDistributedCellData(const std::string& restartFileName,
+                                 const std::vector<std::string>& cellDataFileNames,
+                                 const std::string& outputFileName)
+{
+    if (cellDataFileNames.empty())
+        OPM_THROW(std::invalid_argument, "No cell data files given for '" << restartFileName << "'");
+
+    std::vector<std::unique_ptr<CellDataFile>> files;
+    std::size_t numCells = 0;
+    for (const auto& fileName : cellDataFileNames) {
+        files.push_back(std::make_unique<CellDataFile>(fileName));
+        numCells += files.back()->globalIndices.size();
+    }
+
+    // every cell must be written by exactly one process
+    std::vector<bool> covered(numCells, false);
+    for (const auto& cellData : files) {
+        for (const int globalIdx : cellData->globalIndices) {
+            if (globalIdx < 0 || static_cast<std::size_t>(globalIdx) >= numCells || covered[globalIdx])
+                OPM_THROW(std::runtime_error, "The cell data files of '" << restartFileName
+                          << "' do not contain every cell exactly once");
+            covered[globalIdx] = true;
+        }
+    }
+
+    const EclBinary::MappedFile restartFile(restartFileName);
+    std::ofstream os(outputFileName, std::ios::binary | std::ios::trunc);
+    if (!os)
+        OPM_THROW(std::runtime_error, "Could not open '" << outputFileName << "' for writing");
+
+    int reportStep = -1;
+    std::size_t pos = 0;
+    while (pos < restartFile.size()) {
+        const auto record = EclBinary::readRecord(restartFile, pos);
+        os.write(restartFile.data() + record.begin, record.end - record.begin);
+        pos = record.end;
+
+        if (record.name == "SEQNUM" && record.type == "INTE" && record.count > 0)
+            reportStep = EclBinary::readInt(restartFile.data() + EclBinary::elementOffset(record, 0));
+        else if (record.type == "MESS" && (record.name == "STARTSOL" || record.name == "ENDSOL")) {
+            if (reportStep < 0)
+                OPM_THROW(std::runtime_error, "'" << restartFileName << "' is not a unified restart file");
+
+            writeCellArrays(os, files, reportStep, record.name == "ENDSOL", numCells);
+        }
+    }
+
+    os.flush();
+    if (!os)
+        OPM_THROW(std::runtime_error, "Could not write '" << outputFileName << "'");
+}
+
+} // namespace Opm
@@ -0,0 +1,114 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/**
+ * \file
+ *
+ * \copydoc Opm::EclDistributedCellWriter
+ */
+#ifndef EWOMS_ECL_DISTRIBUTED_CELL_DATA_HH
+#define EWOMS_ECL_DISTRIBUTED_CELL_DATA_HH
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Opm {
+
+namespace data { class Solution; }
+namespace EclIO { class EclOutput; }
+
+/*!
+ * \brief Returns the name of the file holding the restart cell data of a process.
+ */
+std::string eclDistributedCellDataFileName(const std::string& outputDir,
+                                           const std::string& baseName,
+                                           int rank);
+
+/*!
+ * \brief Writes the restart cell arrays of the cells of one process.
+ *
+ * In the distributed restart output mode each process writes the values of its
+ * interior cells to a file of its own instead of sending them to the I/O rank,
+ * which writes the restart file without the cell arrays.
+ * mergeEclDistributedCellData() inserts the arrays into the restart file
+ * afterwards.
+ *
+ * The file is an ECL binary file. It starts with the array CELLIDX, which holds
+ * the position of each cell in the global cell arrays. For every report step it
+ * contains SEQNUM, the arrays of the restart solution, the message ENDSOL and
+ * the auxiliary arrays.
+ */
+class EclDistributedCellWriter
+{
+public:
+    /*!
+     * \param fileName The name of the file
+     * \param globalIndices The index in the global cell arrays of each cell,
+     *                      in the order of the values passed to writeStep()
+     */
+    EclDistributedCellWriter(const std::string& fileName,
+                             const std::vector<int>& globalIndices);
+
+    ~EclDistributedCellWriter();
+
+    /*!
+     * \brief Write the cell arrays of a report step.
+     *
+     * The solution holds one value per cell in output units. As in the restart
+     * file, the arrays are written in single precision unless doublePrecision
+     * is set, auxiliary arrays are only written if writeAuxiliary is set and
+     * arrays with other targets are skipped.
+     */
+    void writeStep(int reportStep,
+                   const data::Solution& solution,
+                   bool doublePrecision,
+                   bool writeAuxiliary);
+
+private:
+    std::unique_ptr<EclIO::EclOutput> output_;
+    std::size_t numCells_;
+};
+
+/*!
+ * \brief Insert the cell arrays written by EclDistributedCellWriter into a
+ *        restart file.
+ *
+ * The restart file must be a unified binary restart file which was written
+ * without cell arrays. For each report step the solution arrays are inserted
+ * behind its STARTSOL message and the auxiliary arrays behind its ENDSOL
+ * message, where the restart writer puts them. All other records are copied
+ * unchanged, so the result is identical to the restart file written from the
+ * gathered cell data.
+ *
+ * Throws if the files of the processes do not cover every cell exactly once,
+ * if they disagree on the arrays of a report step or if the cell data of a
+ * report step of the restart file is missing.
+ */
+void mergeEclDistributedCellData(const std::string& restartFileName,
+                                 const std::vector<std::string>& cellDataFileNames,
+                                 const std::string& outputFileName);
+
+} // namespace Opm
+
+#endif
@@ -28,6 +28,8 @@
 #include <opm/grid/CpGrid.hpp>
 #include <opm/grid/polyhedralgrid.hh>
 #include <opm/models/discretization/ecfv/ecfvstencil.hh>
+#include <opm/simulators/linalg/ExtractParallelGridInformationToISTL.hpp>
+#include <opm/simulators/linalg/ParallelIstlInformation.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 #include <opm/parser/eclipse/EclipseState/Runspec.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TracerVdTable.hpp>
@@ -35,6 +37,9 @@
 #include <dune/istl/operators.hh>
 #include <dune/istl/solvers.hh>
 #include <dune/istl/preconditioners.hh>
+#if HAVE_MPI
+#include <dune/istl/schwarz.hh>
+#endif
 
 #if HAVE_DUNE_FEM
 #include <dune/fem/gridpart/adaptiveleafgridpart.hh>
@@ -42,12 +47,69 @@
 #include <ebos/femcpgridcompat.hh>
 #endif
 
+#include <any>
 #include <iostream>
+#include <memory>
 #include <set>
 #include <stdexcept>
 
 namespace Opm {
 
+namespace {
+
+// Solves the local part of the tracer system with the sweep solver. Used
+// inside a block preconditioner, it results in exact subdomain solves. If the
+// sweep solver fails because one of its diagonal blocks is singular, the
+// preconditioner falls back to ILU(0) for the rest of the linear solve.
+template<class Matrix, class Vector, class Scalar>
+class TracerSweepPreconditioner : public Dune::Preconditioner<Vector, Vector>
+{
+public:
+    TracerSweepPreconditioner(const Matrix& M, EclTracerSweepSolver<Scalar>& solver)
+        : M_(M)
+        , solver_(solver)
+    {}
+
+    void pre(Vector&, Vector&) override
+    {}
+
+    void apply(Vector& v, const Vector& d) override
+    {
+        if (!fallback_) {
+            d_.resize(d.size());
+            for (size_t i = 0; i < d.size(); ++i)
+                d_[i] = d[i][0];
+            v_.assign(d.size(), 0.0);
+
+            if (solver_.solve(M_, v_, d_, 1)) {
+                for (size_t i = 0; i < v.size(); ++i)
+                    v[i] = v_[i];
+                return;
+            }
+
+            OpmLog::debug("Tracer sweep solver failed, falling back to ILU(0)");
+            fallback_ = std::make_unique<Dune::SeqILU<Matrix,Vector,Vector>>(M_, 0, 1);
+        }
+
+        fallback_->apply(v, d);
+    }
+
+    void post(Vector&) override
+    {}
+
+    Dune::SolverCategory::Category category() const override
+    { return Dune::SolverCategory::sequential; }
+
+private:
+    const Matrix& M_;
+    EclTracerSweepSolver<Scalar>& solver_;
+    std::vector<Scalar> d_;
+    std::vector<Scalar> v_;
+    std::unique_ptr<Dune::SeqILU<Matrix,Vector,Vector>> fallback_;
+};
+
+}
+
 template<class Grid, class GridView, class DofMapper, class Stencil, class Scalar>
 EclGenericTracerModel<Grid,GridView,DofMapper,Stencil,Scalar>::
 EclGenericTracerModel(const GridView& gridView,
@@ -84,7 +146,8 @@ tracerConcentration(int tracerIdx, int globalDofIdx) const
 template<class Grid,class GridView, class DofMapper, class Stencil, class Scalar>
 void EclGenericTracerModel<Grid,GridView,DofMapper,Stencil,Scalar>::
 doInit(bool enabled, size_t numGridDof,
-       size_t gasPhaseIdx, size_t oilPhaseIdx, size_t waterPhaseIdx)
+       size_t gasPhaseIdx, size_t oilPhaseIdx, size_t waterPhaseIdx,
+       const std::vector<Scalar>& cellCenterDepth)
 {
     const auto& tracers = eclState_.tracer();
     const auto& comm = gridView_.comm();
@@ -102,10 +165,10 @@ doInit(bool enabled, size_t numGridDof,
         return; // Tracer transport must be enabled by the user
     }
 
-    if (comm.size() > 1) {
+    if (comm.size() > 1 && !setupParallelSolver_(numGridDof)) {
         tracerNames_.resize(0);
         if (comm.rank() == 0)
-            std::cout << "Warning: The tracer model currently does not work for parallel runs\n"
+            std::cout << "Warning: The tracer model only works for parallel runs on CpGrid\n"
                       << std::flush;
         return;
     }
@@ -145,12 +208,11 @@ doInit(bool enabled, size_t numGridDof,
         }
         //TVDPF keyword
         else {
-            const auto& eclGrid = eclState_.getInputGrid();
-
+            // the input grid is only available on the I/O rank, so use the cell
+            // depths of the vanguard, which are the same on all ranks.
             for (size_t globalDofIdx = 0; globalDofIdx < numGridDof; ++globalDofIdx){
-                int cartDofIdx = cartMapper_.cartesianIndex(globalDofIdx);
-                const auto& center = eclGrid.getCellCenter(cartDofIdx);
-                tracerConcentration_[tracerIdx][globalDofIdx] = tracer.free_tvdp.evaluate("TRACER_CONCENTRATION", center[2]);
+                tracerConcentration_[tracerIdx][globalDofIdx] =
+                    tracer.free_tvdp.evaluate("TRACER_CONCENTRATION", cellCenterDepth[globalDofIdx]);
             }
         }
         ++tracerIdx;
@@ -202,8 +264,9 @@ doInit(bool enabled, size_t numGridDof,
     }
     tracerMatrix_->endindices();
 
+    // cells of other processes are marked by -1
     const int sizeCartGrid = cartMapper_.cartesianSize();
-    cartToGlobal_.resize(sizeCartGrid);
+    cartToGlobal_.assign(sizeCartGrid, -1);
     for (unsigned i = 0; i < numGridDof; ++i) {
         int cartIdx = cartMapper_.cartesianIndex(i);
         cartToGlobal_[cartIdx] = i;
@@ -280,6 +343,129 @@ linearSolveBatchwise_(const TracerMatrix& M, std::vector<TracerVector>& x, std::
     return converged;
 }
 
+template<class Grid,class GridView, class DofMapper, class Stencil, class Scalar>
+bool EclGenericTracerModel<Grid,GridView,DofMapper,Stencil,Scalar>::
+linearSolveInterleaved_(const TracerMatrix& M, std::vector<Scalar>& x, std::vector<Scalar>& b, int numTracer)
+{
+    // the tracer equations are discretized with single point upwinding, so
+    // they can be solved exactly by a sweep in flow order. only if the flux
+    // field contains large cycles, the iterative solver is used instead.
+#if HAVE_MPI
+    const bool parallel = static_cast<bool>(comm_);
+#else
+    const bool parallel = false;
+#endif
+    if (!parallel && sweepSolver_.update(M) && sweepSolver_.solve(M, x, b, numTracer))
+        return true;
+
+    const size_t numDof = M.N();
+    std::vector<TracerVector> xs(numTracer, TracerVector(numDof));
+    std::vector<TracerVector> bs(numTracer, TracerVector(numDof));
+    for (size_t dofIdx = 0; dofIdx < numDof; ++dofIdx)
+        for (int tIdx = 0; tIdx < numTracer; ++tIdx)
+            bs[tIdx][dofIdx] = b[dofIdx*numTracer + tIdx];
+
+    bool converged = parallel
+        ? linearSolveParallel_(M, xs, bs)
+        : linearSolveBatchwise_(M, xs, bs);
+
+    for (size_t dofIdx = 0; dofIdx < numDof; ++dofIdx)
+        for (int tIdx = 0; tIdx < numTracer; ++tIdx)
+            x[dofIdx*numTracer + tIdx] = xs[tIdx][dofIdx];
+
+    return converged;
+}
+
+template<class Grid,class GridView, class DofMapper, class Stencil, class Scalar>
+void EclGenericTracerModel<Grid,GridView,DofMapper,Stencil,Scalar>::
+makeOverlapRowsInvalid_(TracerMatrix& M, std::vector<Scalar>& b, int numTracer) const
+{
+    for (const int row : overlapRows_) {
+        M[row] = 0.0;
+        M[row][row] = 1.0;
+        for (int tIdx = 0; tIdx < numTracer; ++tIdx)
+            b[row*numTracer + tIdx] = 0.0;
+    }
+}
+
+template<class Grid,class GridView, class DofMapper, class Stencil, class Scalar>
+bool EclGenericTracerModel<Grid,GridView,DofMapper,Stencil,Scalar>::
+setupParallelSolver_([[maybe_unused]] size_t numGridDof)
+{
+#if HAVE_MPI
+    std::any parallelInformation;
+    extractParallelGridInformationToISTL(gridView_.grid(), parallelInformation);
+    const auto* parinfo = std::any_cast<ParallelISTLInformation>(&parallelInformation);
+    if (!parinfo)
+        return false;
+
+    comm_ = std::make_unique<CommunicationType>(gridView_.comm());
+    parinfo->copyValuesTo(comm_->indexSet(), comm_->remoteIndices(), numGridDof, 1);
+
+    overlapRows_.clear();
+    auto elemIt = gridView_.template begin<0>();
+    const auto elemEndIt = gridView_.template end<0>();
+    for (; elemIt != elemEndIt; ++elemIt) {
+        if (elemIt->partitionType() != Dune::InteriorEntity)
+            overlapRows_.push_back(dofMapper_.index(*elemIt));
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+template<class Grid,class GridView, class DofMapper, class Stencil, class Scalar>
+bool EclGenericTracerModel<Grid,GridView,DofMapper,Stencil,Scalar>::
+linearSolveParallel_([[maybe_unused]] const TracerMatrix& M,
+                     [[maybe_unused]] std::vector<TracerVector>& x,
+                     [[maybe_unused]] std::vector<TracerVector>& b)
+{
+#if HAVE_MPI
+    // The same overlapping Schwarz setup as for the flow equations. The local
+    // problems are solved exactly by the sweep solver if possible, so the
+    // Krylov method only has to propagate the information between the
+    // processes.
+    Scalar tolerance = 1e-6;
+    int maxIter = 100;
+
+    int verbosity = 0;
+    using TracerSolver = Dune::BiCGSTABSolver<TracerVector>;
+    using TracerOperator = Dune::OverlappingSchwarzOperator<TracerMatrix,TracerVector,TracerVector,CommunicationType>;
+    using TracerScalarProduct = Dune::OverlappingSchwarzScalarProduct<TracerVector,CommunicationType>;
+    using LocalPreconditioner = Dune::Preconditioner<TracerVector,TracerVector>;
+    using TracerPreconditioner = Dune::BlockPreconditioner<TracerVector,TracerVector,CommunicationType,LocalPreconditioner>;
+
+    std::unique_ptr<LocalPreconditioner> localPreconditioner;
+    if (sweepSolver_.update(M))
+        localPreconditioner = std::make_unique<TracerSweepPreconditioner<TracerMatrix,TracerVector,Scalar>>(M, sweepSolver_);
+    else
+        localPreconditioner = std::make_unique<Dune::SeqILU<TracerMatrix,TracerVector,TracerVector>>(M, 0, 1);
+
+    TracerOperator tracerOperator(M, *comm_);
+    TracerScalarProduct tracerScalarProduct(*comm_);
+    TracerPreconditioner tracerPreconditioner(*localPreconditioner, *comm_);
+
+    TracerSolver solver (tracerOperator, tracerScalarProduct,
+                         tracerPreconditioner, tolerance, maxIter,
+                         verbosity);
+
+    bool converged = true;
+    for (size_t nrhs =0; nrhs < b.size(); ++nrhs) {
+        x[nrhs] = 0.0;
+        Dune::InverseOperatorResult result;
+        solver.apply(x[nrhs], b[nrhs], result);
+        comm_->copyOwnerToAll(x[nrhs], x[nrhs]);
+        converged = (converged && result.converged);
+    }
+
+    return converged;
+#else
+    return false;
+#endif
+}
+
 #if HAVE_DUNE_FEM
 template class EclGenericTracerModel<Dune::CpGrid,
                                      Dune::GridView<Dune::Fem::GridPart2GridViewTraits<Dune::Fem::AdaptiveLeafGridPart<Dune::CpGrid, Dune::PartitionIteratorType(4), false>>>,
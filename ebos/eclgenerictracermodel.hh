@@ -28,15 +28,21 @@
 #ifndef EWOMS_ECL_GENERIC_TRACER_MODEL_HH
 #define EWOMS_ECL_GENERIC_TRACER_MODEL_HH
 
+#include <ebos/ecltracersweepsolver.hh>
+
 #include <opm/grid/common/CartesianIndexMapper.hpp>
 
 #include <opm/models/blackoil/blackoilmodel.hh>
 #include <opm/common/OpmLog/OpmLog.hpp>
 
 #include <dune/istl/bcrsmatrix.hh>
+#if HAVE_MPI
+#include <dune/istl/owneroverlapcopy.hh>
+#endif
 
 #include <dune/common/version.hh>
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -68,6 +74,12 @@ public:
      */
     Scalar tracerConcentration(int tracerIdx, int globalDofIdx) const;
 
+    /*!
+     * \brief Return the tracer concentrations of all degrees of freedom
+     */
+    const TracerVector& tracerConcentrations(int tracerIdx) const
+    { return tracerConcentration_[tracerIdx]; }
+
     /*!
     * \brief Return well tracer rates
     */
@@ -82,17 +94,47 @@ protected:
 
     /*!
      * \brief Initialize all internal data structures needed by the tracer module
+     *
+     * The cell depths are used to evaluate the initial concentrations given by TVDPF.
      */
     void doInit(bool enabled,
                 size_t numGridDof,
                 size_t gasPhaseIdx,
                 size_t oilPhaseIdx,
-                size_t waterPhaseIdx);
+                size_t waterPhaseIdx,
+                const std::vector<Scalar>& cellCenterDepth);
 
     bool linearSolve_(const TracerMatrix& M, TracerVector& x, TracerVector& b);
 
     bool linearSolveBatchwise_(const TracerMatrix& M, std::vector<TracerVector>& x, std::vector<TracerVector>& b);
 
+    /*!
+     * \brief Solve the tracer system for all tracers of a batch at once
+     *
+     * The right hand sides and solutions are stored with the tracer index as
+     * the fastest running index, i.e. entry (dofIdx, tIdx) is located at
+     * dofIdx*numTracer + tIdx.
+     */
+    bool linearSolveInterleaved_(const TracerMatrix& M, std::vector<Scalar>& x, std::vector<Scalar>& b, int numTracer);
+
+    /*!
+     * \brief Replace the equations of the overlap cells by identities
+     *
+     * The equations of these cells are incomplete on this process. Their
+     * values are taken from the owning process after the solve instead.
+     */
+    void makeOverlapRowsInvalid_(TracerMatrix& M, std::vector<Scalar>& b, int numTracer) const;
+
+    /*!
+     * \brief Set up the communication for the distributed tracer solve
+     *
+     * Returns false if the grid does not provide the information needed to
+     * solve the tracer equations in parallel.
+     */
+    bool setupParallelSolver_(size_t numGridDof);
+
+    bool linearSolveParallel_(const TracerMatrix& M, std::vector<TracerVector>& x, std::vector<TracerVector>& b);
+
     const GridView& gridView_;
     const EclipseState& eclState_;
     const CartesianIndexMapper& cartMapper_;
@@ -110,6 +152,17 @@ protected:
     // <wellName, tracerIdx> -> wellRate
     std::map<std::pair<std::string, std::string>, double> wellTracerRate_;
 
+    // direct solver for the upwind tracer systems
+    EclTracerSweepSolver<Scalar> sweepSolver_;
+
+    // the cells which are not owned by this process
+    std::vector<int> overlapRows_;
+
+#if HAVE_MPI
+    using CommunicationType = Dune::OwnerOverlapCopyCommunication<int, int>;
+    std::unique_ptr<CommunicationType> comm_;
+#endif
+
 };
 
 } // namespace Opm
@@ -23,12 +23,16 @@
 
 #include <config.h>
 #include <ebos/eclgenericwriter.hh>
+#include <ebos/ecldistributedcelldata.hh>
+#include <ebos/eclpendingwrites.hh>
 
 #include <opm/grid/CpGrid.hpp>
 #include <opm/grid/cpgrid/GridHelpers.hpp>
 #include <opm/grid/polyhedralgrid.hh>
 #include <opm/grid/utility/cartesianToCompressed.hpp>
 
+#include <opm/common/ErrorMacros.hpp>
+
 #include <opm/output/eclipse/EclipseIO.hpp>
 #include <opm/output/eclipse/RestartValue.hpp>
 #include <opm/output/eclipse/Summary.hpp>
@@ -40,6 +44,7 @@
 #include <opm/parser/eclipse/EclipseState/Schedule/UDQ/UDQState.hpp>
 #include <opm/parser/eclipse/Units/UnitSystem.hpp>
 
+#include <dune/grid/common/gridenums.hh>
 #include <dune/grid/common/mcmgmapper.hh>
 
 #if HAVE_DUNE_FEM
@@ -52,6 +57,10 @@
 #include <mpi.h>
 #endif
 
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
 namespace {
 
 /*!
@@ -105,6 +114,8 @@ bool directVerticalNeighbors(const std::array<int, 3>& cartDims,
 
 struct EclWriteTasklet : public Opm::TaskletInterface
 {
+    std::shared_ptr<Opm::EclPendingWrites> pendingWrites_;
+    std::size_t size_;
     Opm::Action::State actionState_;
     Opm::SummaryState summaryState_;
     Opm::UDQState udqState_;
@@ -115,7 +126,9 @@ struct EclWriteTasklet : public Opm::TaskletInterface
     Opm::RestartValue restartValue_;
     bool writeDoublePrecision_;
 
-    explicit EclWriteTasklet(const Opm::Action::State& actionState,
+    explicit EclWriteTasklet(std::shared_ptr<Opm::EclPendingWrites> pendingWrites,
+                             std::size_t size,
+                             const Opm::Action::State& actionState,
                              const Opm::SummaryState& summaryState,
                              const Opm::UDQState& udqState,
                              Opm::EclipseIO& eclIO,
@@ -124,20 +137,30 @@ struct EclWriteTasklet : public Opm::TaskletInterface
                              double secondsElapsed,
                              Opm::RestartValue restartValue,
                              bool writeDoublePrecision)
-        : actionState_(actionState)
+        : pendingWrites_(std::move(pendingWrites))
+        , size_(size)
+        , actionState_(actionState)
         , summaryState_(summaryState)
         , udqState_(udqState)
         , eclIO_(eclIO)
         , reportStepNum_(reportStepNum)
         , isSubStep_(isSubStep)
         , secondsElapsed_(secondsElapsed)
-        , restartValue_(restartValue)
+        , restartValue_(std::move(restartValue))
         , writeDoublePrecision_(writeDoublePrecision)
     { }
 
     // callback to eclIO serial writeTimeStep method
     void run()
     {
+        // release the slot in the queue of pending writes also if
+        // writing fails
+        struct Release {
+            Opm::EclPendingWrites& pending;
+            std::size_t size;
+            ~Release() { pending.release(size); }
+        } release{*pendingWrites_, size_};
+
         eclIO_.writeTimeStep(actionState_,
                              summaryState_,
                              udqState_,
@@ -149,6 +172,20 @@ struct EclWriteTasklet : public Opm::TaskletInterface
     }
 };
 
+/// Approximate number of bytes held by a restart value, dominated by the
+/// cell data.
+std::size_t restartValueSize(const Opm::RestartValue& restartValue)
+{
+    std::size_t size = 0;
+    for (const auto& [key, cellData] : restartValue.solution) {
+        size += cellData.data.size() * sizeof(double);
+    }
+    for (const auto& [key, data] : restartValue.extra) {
+        size += data.size() * sizeof(double);
+    }
+    return size;
+}
+
 }
 
 namespace Opm {
@@ -163,7 +200,10 @@ EclGenericWriter(const Schedule& schedule,
                  const GridView& gridView,
                  const Dune::CartesianIndexMapper<Grid>& cartMapper,
                  const Dune::CartesianIndexMapper<EquilGrid>* equilCartMapper,
-                 bool enableAsyncOutput)
+                 bool enableAsyncOutput,
+                 int maxPendingWrites,
+                 double maxPendingWriteMemory,
+                 bool distributedRestartOutput)
     : collectToIORank_(grid,
                        equilGrid,
                        gridView,
@@ -201,8 +241,42 @@ EclGenericWriter(const Schedule& schedule,
     if (enableAsyncOutput && collectToIORank_.isIORank())
         numWorkerThreads = 1;
     taskletRunner_.reset(new TaskletRunner(numWorkerThreads));
+
+    const auto maxPendingWriteBytes = static_cast<std::size_t>(std::max(maxPendingWriteMemory, 0.0) * 1024 * 1024);
+    pendingWrites_ = std::make_shared<EclPendingWrites>(std::max(maxPendingWrites, 1),
+                                                        maxPendingWriteBytes);
+
+    // in the distributed restart output mode every process writes the restart
+    // cell arrays of its interior cells itself. This only pays off in parallel.
+    if (distributedRestartOutput && collectToIORank_.isParallel()) {
+        const auto& ioConfig = eclState_.getIOConfig();
+        if (!ioConfig.getUNIFOUT() || ioConfig.getFMTOUT())
+            OPM_THROW(std::invalid_argument,
+                      "Distributed restart output requires unified binary output files");
+
+        ElementMapper elemMapper(gridView_, Dune::mcmgElementLayout());
+        std::vector<int> globalIndices;
+        for (const auto& elem : elements(gridView_)) {
+            if (elem.partitionType() != Dune::InteriorEntity)
+                continue;
+
+            const int elemIdx = elemMapper.index(elem);
+            distributedCellIdx_.push_back(elemIdx);
+            globalIndices.push_back(collectToIORank_.localIdxToGlobalIdx(elemIdx));
+        }
+
+        distributedCellWriter_ = std::make_unique<EclDistributedCellWriter>(
+            eclDistributedCellDataFileName(ioConfig.getOutputDir(),
+                                           ioConfig.getBaseName(),
+                                           grid_.comm().rank()),
+            globalIndices);
+    }
 }
 
+template<class Grid, class EquilGrid, class GridView, class ElementMapper, class Scalar>
+EclGenericWriter<Grid,EquilGrid,GridView,ElementMapper,Scalar>::
+~EclGenericWriter() = default;
+
 template<class Grid, class EquilGrid, class GridView, class ElementMapper, class Scalar>
 const EclipseIO& EclGenericWriter<Grid,EquilGrid,GridView,ElementMapper,Scalar>::
 eclIO() const
@@ -402,7 +476,7 @@ doWriteOutput(const int                     reportStepNum,
     const auto isParallel = this->collectToIORank_.isParallel();
 
     RestartValue restartValue {
-        isParallel ? this->collectToIORank_.globalCellData()
+        isParallel ? this->collectToIORank_.releaseGlobalCellData()
                    : std::move(localCellData),
 
         isParallel ? this->collectToIORank_.globalWellData()
@@ -427,19 +501,61 @@ doWriteOutput(const int                     reportStepNum,
 
     // first, create a tasklet to write the data for the current time
     // step to disk
+    const auto size = restartValueSize(restartValue);
     auto eclWriteTasklet = std::make_shared<EclWriteTasklet>(
+        this->pendingWrites_, size,
         actionState, summaryState, udqState, *this->eclIO_,
         reportStepNum, isSubStep, curTime, std::move(restartValue), doublePrecision);
 
-    // then, make sure that the previous I/O request has been completed
-    // and the number of incomplete tasklets does not increase between
-    // time steps
-    this->taskletRunner_->barrier();
+    // then, wait until the number and size of the queued I/O requests
+    // allow another one. With the default of one pending write this waits
+    // for the previous request to complete.
+    this->pendingWrites_->acquire(size);
 
-    // finally, start a new output writing job
+    // finally, start a new output writing job. The tasklets are run in
+    // order by a single worker thread, so the writes stay ordered.
     this->taskletRunner_->dispatch(std::move(eclWriteTasklet));
 }
 
+template<class Grid, class EquilGrid, class GridView, class ElementMapper, class Scalar>
+void EclGenericWriter<Grid,EquilGrid,GridView,ElementMapper,Scalar>::
+writeDistributedCellData(int reportStepNum,
+                         data::Solution& localCellData,
+                         bool doublePrecision)
+{
+    if (!distributedCellWriter_)
+        return;
+
+    const bool writeStep = schedule_.write_rst_file(reportStepNum);
+
+    data::Solution restartCellData;
+    for (auto it = localCellData.begin(); it != localCellData.end();) {
+        const auto& [name, cellData] = *it;
+        if (cellData.target != data::TargetType::RESTART_SOLUTION &&
+            cellData.target != data::TargetType::RESTART_AUXILIARY) {
+            ++it;
+            continue;
+        }
+
+        if (writeStep) {
+            std::vector<double> interiorData(distributedCellIdx_.size());
+            for (std::size_t i = 0; i < distributedCellIdx_.size(); ++i)
+                interiorData[i] = cellData.data[distributedCellIdx_[i]];
+
+            restartCellData.insert(name, cellData.dim, std::move(interiorData), cellData.target);
+        }
+
+        it = localCellData.erase(it);
+    }
+
+    if (!writeStep)
+        return;
+
+    restartCellData.convertFromSI(eclState_.getUnits());
+    distributedCellWriter_->writeStep(reportStepNum, restartCellData, doublePrecision,
+                                      !eclState_.getIOConfig().getEclCompatibleRST());
+}
+
 template<class Grid, class EquilGrid, class GridView, class ElementMapper, class Scalar>
 void EclGenericWriter<Grid,EquilGrid,GridView,ElementMapper,Scalar>::
 evalSummary(int reportStepNum,
@@ -35,6 +35,7 @@
 
 #include <cstddef>
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -42,8 +43,10 @@
 namespace Opm {
 
 namespace Action { class State; }
+class EclDistributedCellWriter;
 class EclipseIO;
 class EclipseState;
+class EclPendingWrites;
 class Inplace;
 struct NNCdata;
 class Schedule;
@@ -69,7 +72,12 @@ public:
                      const GridView& gridView,
                      const Dune::CartesianIndexMapper<Grid>& cartMapper,
                      const Dune::CartesianIndexMapper<EquilGrid>* equilCartMapper,
-                     bool enableAsyncOutput);
+                     bool enableAsyncOutput,
+                     int maxPendingWrites,
+                     double maxPendingWriteMemory,
+                     bool distributedRestartOutput);
+
+    ~EclGenericWriter();
 
     const EclipseIO& eclIO() const;
 
@@ -97,6 +105,18 @@ protected:
                        Scalar nextStepSize,
                        bool doublePrecision);
 
+    /*!
+     * \brief Write the restart cell arrays of the interior cells of this
+     *        process to a file of its own.
+     *
+     * Only does something in the distributed restart output mode. The arrays
+     * are removed from the cell data, so they are neither sent to the I/O
+     * rank nor written to the restart file.
+     */
+    void writeDistributedCellData(int reportStepNum,
+                                  data::Solution& localCellData,
+                                  bool doublePrecision);
+
     void evalSummary(int reportStepNum,
                      Scalar curTime,
                      const std::map<std::size_t, double>& wbpData,
@@ -119,12 +139,15 @@ protected:
     const SummaryConfig& summaryConfig_;
     std::unique_ptr<EclipseIO> eclIO_;
     std::unique_ptr<TaskletRunner> taskletRunner_;
+    std::shared_ptr<EclPendingWrites> pendingWrites_;
     Scalar restartTimeStepSize_;
     const TransmissibilityType* globalTrans_ = nullptr;
     const Dune::CartesianIndexMapper<Grid>& cartMapper_;
     const Dune::CartesianIndexMapper<EquilGrid>* equilCartMapper_;
     const EquilGrid* equilGrid_;
     std::vector<std::size_t> wbp_index_list_;
+    std::unique_ptr<EclDistributedCellWriter> distributedCellWriter_;
+    std::vector<int> distributedCellIdx_;
 
 private:
     data::Solution computeTrans_(const std::unordered_map<int,int>& cartesianToActive) const;
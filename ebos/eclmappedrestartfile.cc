@@ -0,0 +1,101 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+
+#include <config.h>
+#include <ebos/eclmappedrestartfile.hh>
+
+#include <opm/common/ErrorMacros.hpp>
+
+#include <stdexcept>
+#include <utility>
+
+namespace Opm {
+
+EclMappedRestartFile::EclMappedRestartFile(const std::string& fileName,
+                                           int reportStep,
+                                           bool unified)
+    : file_(fileName)
+{
+    indexReportStep_(reportStep, unified);
+}
+
+std::size_t EclMappedRestartFile::size(const std::string& name) const
+{ return array_(name).count; }
+
+std::vector<double> EclMappedRestartFile::read(const std::string& name,
+                                               const std::vector<int>& indices) const
+{
+    const auto& array = array_(name);
+    const bool isDouble = array.type == "DOUB";
+
+    std::vector<double> values(indices.size());
+    for (std::size_t i = 0; i < indices.size(); ++i) {
+        const int idx = indices[i];
+        if (idx < 0 || static_cast<std::size_t>(idx) >= array.count)
+            OPM_THROW(std::runtime_error, "Cell " << idx << " is outside of array " << name
+                      << " of restart file '" << file_.fileName() << "'");
+
+        const char* p = file_.data() + EclBinary::elementOffset(array, idx);
+        values[i] = isDouble ? EclBinary::readDouble(p) : EclBinary::readFloat(p);
+    }
+
+    return values;
+}
+
+const EclBinary::Record&
+EclMappedRestartFile::array_(const std::string& name) const
+{
+    auto it = arrays_.find(name);
+    if (it == arrays_.end())
+        OPM_THROW(std::runtime_error, "Restart file '" << file_.fileName()
+                  << "' does not contain array " << name);
+    return it->second;
+}
+
+void EclMappedRestartFile::indexReportStep_(int reportStep, bool unified)
+{
+    bool inStep = !unified;
+    bool foundStep = !unified;
+    std::size_t pos = 0;
+    while (pos < file_.size()) {
+        auto record = EclBinary::readRecord(file_, pos);
+        pos = record.end;
+
+        if (unified && record.name == "SEQNUM" && record.type == "INTE" && record.count > 0) {
+            const bool isRequestedStep =
+                EclBinary::readInt(file_.data() + EclBinary::elementOffset(record, 0)) == reportStep;
+            if (inStep && !isRequestedStep)
+                break;
+            inStep = isRequestedStep;
+            foundStep = foundStep || isRequestedStep;
+        }
+        else if (inStep && (record.type == "REAL" || record.type == "DOUB"))
+            arrays_.emplace(record.name, std::move(record));
+    }
+
+    if (!foundStep)
+        OPM_THROW(std::runtime_error, "Restart file '" << file_.fileName()
+                  << "' does not contain report step " << reportStep);
+}
+
+} // namespace Opm
@@ -0,0 +1,94 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/**
+ * \file
+ *
+ * \copydoc Opm::EclMappedRestartFile
+ */
+#ifndef EWOMS_ECL_MAPPED_RESTART_FILE_HH
+#define EWOMS_ECL_MAPPED_RESTART_FILE_HH
+
+#include <ebos/eclbinaryrecords.hh>
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Opm {
+
+/*!
+ * \brief Random access to the cell arrays of one report step of a binary ECL
+ *        restart file.
+ *
+ * The file is mapped into memory and only the record headers are scanned to
+ * locate the arrays of the requested report step. Values are decoded from the
+ * big-endian on-disk representation only for the cells that are asked for, so
+ * each process touches just the parts of the file which belong to its own
+ * cells.
+ */
+class EclMappedRestartFile
+{
+public:
+    /*!
+     * \brief Map a restart file and index the arrays of a report step.
+     *
+     * \param fileName The name of the restart file
+     * \param reportStep The report step to index. For unified files it is
+     *                   located by its SEQNUM record, non-unified files are
+     *                   expected to contain only this step.
+     * \param unified Whether the file is a unified restart file
+     */
+    EclMappedRestartFile(const std::string& fileName, int reportStep, bool unified);
+
+    /*!
+     * \brief Returns whether the report step contains a floating point array
+     *        of the given name.
+     */
+    bool has(const std::string& name) const
+    { return arrays_.count(name) > 0; }
+
+    /*!
+     * \brief Returns the number of elements of an array.
+     */
+    std::size_t size(const std::string& name) const;
+
+    /*!
+     * \brief Decode selected elements of a floating point array.
+     *
+     * Single precision arrays are converted to double precision.
+     */
+    std::vector<double> read(const std::string& name,
+                             const std::vector<int>& indices) const;
+
+private:
+    const EclBinary::Record& array_(const std::string& name) const;
+    void indexReportStep_(int reportStep, bool unified);
+
+    EclBinary::MappedFile file_;
+    std::map<std::string, EclBinary::Record> arrays_;
+};
+
+} // namespace Opm
+
+#endif
@@ -22,7 +22,10 @@
 #define ECL_MPI_SERIALIZER_HH
 
 #include <opm/simulators/utils/ParallelRestart.hpp>
+#include <algorithm>
+#include <array>
 #include <optional>
+#include <utility>
 #include <variant>
 
 namespace Opm {
@@ -331,7 +334,7 @@ public:
                 pack(data);
                 m_packSize = m_position;
                 m_comm.broadcast(&m_packSize, 1, 0);
-                m_comm.broadcast(m_buffer.data(), m_position, 0);
+                broadcastChunks();
             } catch (...) {
                 m_packSize = std::numeric_limits<size_t>::max();
                 m_comm.broadcast(&m_packSize, 1, 0);
@@ -343,7 +346,7 @@ public:
                 throw std::runtime_error("Error detected in parallel serialization");
             }
             m_buffer.resize(m_packSize);
-            m_comm.broadcast(m_buffer.data(), m_packSize, 0);
+            broadcastChunks();
             unpack(data);
         }
     }
@@ -354,6 +357,19 @@ public:
         return m_position;
     }
 
+    //! \brief Returns the buffer holding the data serialized by the last call to pack().
+    //! \details Only the first position() bytes are in use.
+    const std::vector<char>& buffer() const
+    {
+        return m_buffer;
+    }
+
+    //! \brief Replaces the buffer which is de-serialized by the next call to unpack().
+    void setBuffer(std::vector<char> buffer)
+    {
+        m_buffer = std::move(buffer);
+    }
+
     //! \brief Returns true if we are currently doing a serialization operation.
     bool isSerializing() const
     {
@@ -461,6 +477,28 @@ protected:
             data->serializeOp(*this);
     }
 
+    //! \brief Broadcasts the first m_packSize bytes of the buffer from the root process.
+    //! \details The buffer is sent in fixed-size chunks with a few broadcasts in
+    //!          flight at any time. This lets the MPI library pipeline the chunks
+    //!          through its broadcast tree instead of forwarding the complete
+    //!          buffer one level at a time.
+    void broadcastChunks()
+    {
+#if HAVE_MPI
+        std::array<MPI_Request, maxChunksInFlight> requests;
+        requests.fill(MPI_REQUEST_NULL);
+        for (size_t offset = 0, chunk = 0; offset < m_packSize; offset += chunkSize, ++chunk) {
+            auto& request = requests[chunk % maxChunksInFlight];
+            MPI_Wait(&request, MPI_STATUS_IGNORE);
+            const int count = static_cast<int>(std::min(chunkSize, m_packSize - offset));
+            MPI_Ibcast(m_buffer.data() + offset, count, MPI_BYTE, 0, m_comm, &request);
+        }
+        MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+#else
+        m_comm.broadcast(m_buffer.data(), m_packSize, 0);
+#endif
+    }
+
     //! \brief Checks if a type has a serializeOp member.
     //! \detail Ideally we would check for the serializeOp member,
     //!         but this is a member template. For simplicity,
@@ -476,6 +514,9 @@ protected:
         static constexpr bool value = sizeof(test<T>(0)) == sizeof(yes_type);
     };
 
+    static constexpr size_t chunkSize = 16 * 1024 * 1024; //!< Size in bytes of a broadcast chunk
+    static constexpr size_t maxChunksInFlight = 4; //!< Number of chunks broadcast concurrently
+
     Dune::CollectiveCommunication<Dune::MPIHelper::MPICommunicator> m_comm; //!< Communicator to broadcast using
 
     Operation m_op = Operation::PACKSIZE; //!< Current operation
@@ -179,6 +179,11 @@ public:
     /*!
      * \brief Modify the internal buffers according to the intensive quanties relevant
      *        for an element
+     *
+     * This method may be called concurrently for distinct elements: it only
+     * writes to the entries of the output buffers which belong to the degrees
+     * of freedom of the element and serializes the few updates of shared
+     * state.
      */
     void processElement(const ElementContext& elemCtx)
     {
@@ -350,6 +355,9 @@ public:
                 }
                 catch (const NumericalIssue&) {
                     const auto cartesianIdx = elemCtx.simulator().vanguard().grid().globalCell()[globalDofIdx];
+#ifdef _OPENMP
+#pragma omp critical (EclOutputFailedCells)
+#endif
                     this->failedCellsPb_.push_back(cartesianIdx);
                 }
             }
@@ -359,6 +367,9 @@ public:
                 }
                 catch (const NumericalIssue&) {
                     const auto cartesianIdx = elemCtx.simulator().vanguard().grid().globalCell()[globalDofIdx];
+#ifdef _OPENMP
+#pragma omp critical (EclOutputFailedCells)
+#endif
                     this->failedCellsPd_.push_back(cartesianIdx);
                 }
             }
@@ -500,23 +511,31 @@ public:
                         std::string logstring = "Keyword '";
                         logstring.append(key.first);
                         logstring.append("' is unhandled for output to file.");
+#ifdef _OPENMP
+#pragma omp critical (EclOutputLog)
+#endif
                         OpmLog::warning("Unhandled output keyword", logstring);
                     }
                 }
             }
 
-            // Adding Well RFT data
-            if (this->oilConnectionPressures_.count(cartesianIdx) > 0) {
-                this->oilConnectionPressures_[cartesianIdx] = getValue(fs.pressure(oilPhaseIdx));
+            // Adding Well RFT data. The maps are only searched, never
+            // modified structurally, so that concurrent calls are safe.
+            auto oilPressureIt = this->oilConnectionPressures_.find(cartesianIdx);
+            if (oilPressureIt != this->oilConnectionPressures_.end()) {
+                oilPressureIt->second = getValue(fs.pressure(oilPhaseIdx));
             }
-            if (this->waterConnectionSaturations_.count(cartesianIdx) > 0) {
-                this->waterConnectionSaturations_[cartesianIdx] = getValue(fs.saturation(waterPhaseIdx));
+            auto waterSaturationIt = this->waterConnectionSaturations_.find(cartesianIdx);
+            if (waterSaturationIt != this->waterConnectionSaturations_.end()) {
+                waterSaturationIt->second = getValue(fs.saturation(waterPhaseIdx));
             }
-            if (this->gasConnectionSaturations_.count(cartesianIdx) > 0) {
-                this->gasConnectionSaturations_[cartesianIdx] = getValue(fs.saturation(gasPhaseIdx));
+            auto gasSaturationIt = this->gasConnectionSaturations_.find(cartesianIdx);
+            if (gasSaturationIt != this->gasConnectionSaturations_.end()) {
+                gasSaturationIt->second = getValue(fs.saturation(gasPhaseIdx));
             }
-            if (this->wbpData_.count(cartesianIdx) > 0)
-                this->wbpData_[cartesianIdx] = getValue(fs.pressure(oilPhaseIdx));
+            auto wbpIt = this->wbpData_.find(cartesianIdx);
+            if (wbpIt != this->wbpData_.end())
+                wbpIt->second = getValue(fs.pressure(oilPhaseIdx));
 
             // tracers
             const auto& tracerModel = simulator_.problem().tracerModel();
@@ -0,0 +1,84 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/**
+ * \file
+ *
+ * \copydoc Opm::EclPendingWrites
+ */
+#ifndef EWOMS_ECL_PENDING_WRITES_HH
+#define EWOMS_ECL_PENDING_WRITES_HH
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+namespace Opm {
+
+/// Bookkeeping of the write tasklets which are queued or running.  Bounds
+/// the number of restart values held for writing, and the memory they use.
+class EclPendingWrites
+{
+public:
+    EclPendingWrites(std::size_t maxCount, std::size_t maxSize)
+        : maxCount_(std::max(maxCount, std::size_t{1}))
+        , maxSize_(maxSize)
+    {}
+
+    /// Wait until a write of the given size may be queued and reserve
+    /// a slot for it.  A single write is always admitted when the queue
+    /// is empty, also if it exceeds the memory limit on its own.
+    void acquire(std::size_t size)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [this, size]()
+        {
+            return count_ == 0 ||
+                (count_ < maxCount_ && (maxSize_ == 0 || size_ + size <= maxSize_));
+        });
+        ++count_;
+        size_ += size;
+    }
+
+    void release(std::size_t size)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --count_;
+            size_ -= size;
+        }
+        cond_.notify_all();
+    }
+
+private:
+    std::size_t maxCount_;
+    std::size_t maxSize_;
+    std::size_t count_ = 0;
+    std::size_t size_ = 0;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+};
+
+} // namespace Opm
+
+#endif
@@ -60,6 +60,8 @@
 #include "eclthresholdpressure.hh"
 #include "ecldummygradientcalculator.hh"
 #include "eclfluxmodule.hh"
+#include "eclcheckpointfile.hh"
+#include "eclmpiserializer.hh"
 #include "eclbaseaquifermodel.hh"
 #include "eclnewtonmethod.hh"
 #include "ecltracermodel.hh"
@@ -91,6 +93,7 @@
 #include <opm/parser/eclipse/EclipseState/Schedule/Action/ActionContext.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Action/ActionX.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Action/State.hpp>
+#include <opm/common/utility/FileSystem.hpp>
 #include <opm/common/utility/TimeService.hpp>
 #include <opm/material/common/ConditionalStorage.hpp>
 
@@ -102,10 +105,15 @@
 
 #include <opm/common/OpmLog/OpmLog.hpp>
 
+#include <opm/simulators/utils/StartupTimings.hpp>
+
 #include <set>
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <map>
 
 namespace Opm {
 template <class TypeTag>
@@ -144,6 +152,24 @@ struct EnableWriteAllSolutions {
     using type = UndefinedProperty;
 };
 
+// Write native checkpoint files and use them for restarts if they are available
+template<class TypeTag, class MyTypeTag>
+struct EnableEclCheckpoint {
+    using type = UndefinedProperty;
+};
+
+// The number of report steps between two consecutive checkpoints
+template<class TypeTag, class MyTypeTag>
+struct EclCheckpointInterval {
+    using type = UndefinedProperty;
+};
+
+// Also write a checkpoint after each sub step of a report step
+template<class TypeTag, class MyTypeTag>
+struct EclCheckpointSubSteps {
+    using type = UndefinedProperty;
+};
+
 // The number of time steps skipped between writing two consequtive restart files
 template<class TypeTag, class MyTypeTag>
 struct RestartWritingInterval {
@@ -320,6 +346,23 @@ struct EnableWriteAllSolutions<TypeTag, TTag::EclBaseProblem> {
     static constexpr bool value = false;
 };
 
+// only use the ECL restart files by default
+template<class TypeTag>
+struct EnableEclCheckpoint<TypeTag, TTag::EclBaseProblem> {
+    static constexpr bool value = false;
+};
+
+// write a checkpoint at the end of each report step
+template<class TypeTag>
+struct EclCheckpointInterval<TypeTag, TTag::EclBaseProblem> {
+    static constexpr int value = 1;
+};
+
+template<class TypeTag>
+struct EclCheckpointSubSteps<TypeTag, TTag::EclBaseProblem> {
+    static constexpr bool value = false;
+};
+
 // disable API tracking
 template<class TypeTag>
 struct EnableApiTracking<TypeTag, TTag::EclBaseProblem> {
@@ -444,6 +487,31 @@ struct EclOutputDoublePrecision<TypeTag, TTag::EclBaseProblem> {
     static constexpr bool value = false;
 };
 
+// By default, wait for the previous ECL output to be written before
+// queueing the next one
+template<class TypeTag>
+struct EclOutputMaxPendingWrites<TypeTag, TTag::EclBaseProblem> {
+    static constexpr int value = 1;
+};
+
+template<class TypeTag>
+struct EclOutputMaxPendingWriteMemory<TypeTag, TTag::EclBaseProblem> {
+    using type = GetPropType<TypeTag, Scalar>;
+    static constexpr type value = 0.0;
+};
+
+// Decode the restart solution of each process' cells directly from the file
+template<class TypeTag>
+struct EclLazyRestartReading<TypeTag, TTag::EclBaseProblem> {
+    static constexpr bool value = true;
+};
+
+// Send the restart cell arrays to the I/O rank by default
+template<class TypeTag>
+struct EclDistributedRestartOutput<TypeTag, TTag::EclBaseProblem> {
+    static constexpr bool value = false;
+};
+
 // The default location for the ECL output files
 template<class TypeTag>
 struct OutputDir<TypeTag, TTag::EclBaseProblem> {
@@ -684,6 +752,14 @@ public:
         EWOMS_REGISTER_PARAM(TypeTag, bool, EnableEclOutput,
                              "Write binary output which is compatible with the commercial "
                              "Eclipse simulator");
+        EWOMS_REGISTER_PARAM(TypeTag, bool, EnableEclCheckpoint,
+                             "Write native checkpoint files and use them instead of the "
+                             "ECL restart file for bit-identical restarts");
+        EWOMS_REGISTER_PARAM(TypeTag, int, EclCheckpointInterval,
+                             "The number of report steps between two consecutive checkpoints");
+        EWOMS_REGISTER_PARAM(TypeTag, bool, EclCheckpointSubSteps,
+                             "Additionally write a checkpoint after each sub step. It replaces "
+                             "the checkpoint of the report step which it belongs to");
         EWOMS_REGISTER_PARAM(TypeTag, bool, EclOutputDoublePrecision,
                              "Tell the output writer to use double precision. Useful for 'perfect' restarts");
         EWOMS_REGISTER_PARAM(TypeTag, unsigned, RestartWritingInterval,
@@ -789,6 +865,17 @@ public:
         enableDriftCompensation_ = EWOMS_GET_PARAM(TypeTag, bool, EclEnableDriftCompensation);
 
         enableEclOutput_ = EWOMS_GET_PARAM(TypeTag, bool, EnableEclOutput);
+        enableEclCheckpoint_ = EWOMS_GET_PARAM(TypeTag, bool, EnableEclCheckpoint);
+        eclCheckpointInterval_ = EWOMS_GET_PARAM(TypeTag, int, EclCheckpointInterval);
+        eclCheckpointSubSteps_ = EWOMS_GET_PARAM(TypeTag, bool, EclCheckpointSubSteps);
+#if !HAVE_MPI
+        // the state of the wells and of the other models is serialized using the MPI
+        // packing functions
+        if (enableEclCheckpoint_)
+            throw std::runtime_error("Checkpoints require a build with MPI support");
+#endif
+        if (eclCheckpointInterval_ < 1)
+            throw std::runtime_error("The checkpoint interval must be at least one report step");
 
         if constexpr (enableExperiments)
             enableAquifers_ = EWOMS_GET_PARAM(TypeTag, bool, EclEnableAquifers);
@@ -857,13 +944,20 @@ public:
         this->readRockParameters_(simulator.vanguard().cellCenterDepths());
         readMaterialParameters_();
         readThermalParameters_();
-        transmissibilities_.finishInit();
+        {
+            StartupPhaseTimer timer("Transmissibilities");
+            transmissibilities_.finishInit();
+        }
 
         const auto& initconfig = eclState.getInitConfig();
-        if (initconfig.restartRequested())
+        if (initconfig.restartRequested()) {
+            StartupPhaseTimer timer("Reading restart solution");
             readEclRestartSolution_();
-        else
+        }
+        else {
+            StartupPhaseTimer timer("Initial condition");
             readInitialCondition_();
+        }
 
         updatePffDofData_();
 
@@ -931,6 +1025,15 @@ public:
 
         simulator.vanguard().releaseGlobalTransmissibilities();
 
+        // the connection data has been copied to pffDofData_ and the static output
+        // files have been written, so the per-face maps are not needed anymore. the
+        // only other users of the interior transmissibilities are the INIT file
+        // writer (which also gets them via the vanguard's globalTransmissibility()
+        // for PolyhedralGrid) and updatePffDofData_(). everything which is computed
+        // later, e.g. the default threshold pressures, must use the transmissibility()
+        // accessors of the problem instead.
+        transmissibilities_.releaseInteriorTransmissibilities();
+
         // after finishing the initialization and writing the initial solution, we move
         // to the first "real" episode/report step
         // for restart the episode index and start is already set
@@ -1015,6 +1118,8 @@ public:
             this->referencePorosity_[1] = this->referencePorosity_[0];
             updateReferencePorosity_();
             updatePffDofData_();
+            updatePffThresholdPressures_();
+            transmissibilities_.releaseInteriorTransmissibilities();
         }
 
         bool tuningEvent = this->beginEpisode_(enableExperiments, this->episodeIndex());
@@ -1022,6 +1127,13 @@ public:
         // set up the wells for the next episode.
         wellModel_.beginEpisode();
 
+        // a restart from a checkpoint written within the report step continues with
+        // the well state of the checkpoint
+        if (!subStepWellState_.empty()) {
+            wellModel_.resumeFromCheckpoint(subStepWellState_);
+            subStepWellState_.clear();
+        }
+
         // set up the aquifers for the next episode.
         if (enableAquifers_)
             // set up the aquifers for the next episode.
@@ -1184,6 +1296,19 @@ public:
         bool isSubStep = !EWOMS_GET_PARAM(TypeTag, bool, EnableWriteAllSolutions) && !this->simulator().episodeWillBeOver();
         if (enableEclOutput_)
             eclWriter_->writeOutput(isSubStep);
+
+        if (enableEclCheckpoint_) {
+            // a checkpoint written within a report step can be used to restart from the
+            // report step which it belongs to
+            const int episodeIdx = this->simulator().episodeIndex();
+            const int reportStepNum = episodeIdx + 1;
+            if (this->simulator().episodeWillBeOver()) {
+                if (reportStepNum > 0 && reportStepNum % eclCheckpointInterval_ == 0)
+                    writeCheckpoint_(reportStepNum, /*isSubStep=*/false);
+            }
+            else if (eclCheckpointSubSteps_ && episodeIdx > 0)
+                writeCheckpoint_(episodeIdx, /*isSubStep=*/true);
+        }
     }
 
     void finalizeOutput() {
@@ -1337,6 +1462,20 @@ public:
         return pffDofData_.get(context.element(), toDofLocalIdx).transmissibility;
     }
 
+    /*!
+     * \brief Returns the transmissibility between an element and one of its neighbors
+     *        without requiring an element context.
+     *
+     * The neighbor is given by its index in the element's stencil, i.e., the
+     * intersections of the element which have a neighbor are numbered starting at 1 in
+     * the order in which the grid view iterates over them.
+     */
+    Scalar transmissibility(const Element& element, unsigned neighborLocalIdx) const
+    {
+        assert(neighborLocalIdx > 0);
+        return pffDofData_.get(element, neighborLocalIdx).transmissibility;
+    }
+
     /*!
      * \copydoc EclTransmissiblity::diffusivity
      */
@@ -1399,6 +1538,10 @@ public:
 
     /*!
      * \brief Return a reference to the object that handles the "raw" transmissibilities.
+     *
+     * The quantities of the intersections between two elements are released at the end
+     * of finishInit() and after each GEO_MODIFIER update, only the quantities of the
+     * boundary segments and the permeabilities stay available.
      */
     const typename Vanguard::TransmissibilityType& eclTransmissibilities() const
     { return transmissibilities_; }
@@ -1409,6 +1552,19 @@ public:
     Scalar thresholdPressure(unsigned elem1Idx, unsigned elem2Idx) const
     { return thresholdPressures_.thresholdPressure(elem1Idx, elem2Idx); }
 
+    /*!
+     * \brief Returns the threshold pressure of the connection between the center DOF of
+     *        an element context and one of its neighbors.
+     */
+    template <class Context>
+    Scalar thresholdPressure(const Context& context,
+                             [[maybe_unused]] unsigned fromDofLocalIdx,
+                             unsigned toDofLocalIdx) const
+    {
+        assert(fromDofLocalIdx == 0);
+        return pffDofData_.get(context.element(), toDofLocalIdx).thresholdPressure;
+    }
+
     const EclThresholdPressure<TypeTag>& thresholdPressure() const
     { return thresholdPressures_; }
 
@@ -1446,6 +1602,19 @@ public:
         return this->simulator().vanguard().cellCenterDepth(globalSpaceIdx);
     }
 
+    /*!
+     * \brief Returns the depth of the center DOF of an element context minus the depth
+     *        of one of its neighbors [m]
+     */
+    template <class Context>
+    Scalar depthDifference(const Context& context,
+                           [[maybe_unused]] unsigned fromDofLocalIdx,
+                           unsigned toDofLocalIdx) const
+    {
+        assert(fromDofLocalIdx == 0);
+        return pffDofData_.get(context.element(), toDofLocalIdx).depthDifference;
+    }
+
 
     /*!
      * \copydoc BlackoilProblem::rockCompressibility
@@ -1798,6 +1967,11 @@ public:
      */
     void initialSolutionApplied()
     {
+        // the checkpoint overrides the solution which was derived from the initial
+        // fluid states
+        if (checkpoint_)
+            applyCheckpoint_();
+
         // initialize the wells. Note that this needs to be done after initializing the
         // intrinsic permeabilities and the after applying the initial solution because
         // the well model uses these...
@@ -1807,6 +1981,7 @@ public:
         // this point, because determining the threshold pressures may require to access
         // the initial solution.
         thresholdPressures_.finishInit();
+        updatePffThresholdPressures_();
 
         updateCompositionChangeLimits_();
 
@@ -1898,6 +2073,27 @@ public:
     const EclipseIO& eclIO() const
     { return eclWriter_->eclIO(); }
 
+    /*!
+     * \brief Set the state of the time step control which is stored in the next
+     *        checkpoint.
+     */
+    void setTimeStepControlState(const std::vector<double>& state)
+    { timeStepControlState_ = state; }
+
+    /*!
+     * \brief Returns the state of the time step control. After a restart from a
+     *        checkpoint, this is the state stored in the checkpoint.
+     */
+    const std::vector<double>& timeStepControlState() const
+    { return timeStepControlState_; }
+
+    /*!
+     * \brief Returns the time at which a restart continues within the restart report
+     *        step, or a negative value if it starts at the beginning of the step.
+     */
+    Scalar subStepRestartTime() const
+    { return subStepRestartTime_; }
+
     bool nonTrivialBoundaryConditions() const
     { return nonTrivialBoundaryConditions_; }
 
@@ -2330,10 +2526,52 @@ private:
                                        schedule.stepLength(restart_step));
             simulator.setEpisodeIndex(restart_step);
         }
+
+        // a checkpoint holds everything which is needed for the restart, so the ECL
+        // restart file is only read if there is none
+        if (enableEclCheckpoint_)
+            openCheckpoint_(initconfig.getRestartRootName(), initconfig.getRestartStep());
+
+        if (checkpoint_)
+            readCheckpointRestart_();
+        else
+            readEclRestartFile_();
+
+        // assign the restart solution to the current solution. note that we still need
+        // to compute real initial solution after this because the initial fluid states
+        // need to be correct for stuff like boundary conditions.
+        auto& sol = this->model().solution(/*timeIdx=*/0);
+        const auto& gridView = this->gridView();
+        ElementContext elemCtx(simulator);
+        auto elemIt = gridView.template begin</*codim=*/0>();
+        const auto& elemEndIt = gridView.template end</*codim=*/0>();
+        for (; elemIt != elemEndIt; ++elemIt) {
+            const auto& elem = *elemIt;
+            if (elem.partitionType() != Dune::InteriorEntity)
+                continue;
+
+            elemCtx.updatePrimaryStencil(elem);
+            int elemIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
+            initial(sol[elemIdx], elemCtx, /*spaceIdx=*/0, /*timeIdx=*/0);
+        }
+
+        // make sure that the ghost and overlap entities exhibit the correct
+        // solution. alternatively, this could be done in the loop above by also
+        // considering non-interior elements. Since the initial() method might not work
+        // 100% correctly for such elements, let's play safe and explicitly synchronize
+        // using message passing.
+        this->model().syncOverlap();
+
+        if (!checkpoint_)
+            eclWriter_->endRestart();
+    }
+
+    void readEclRestartFile_()
+    {
+        auto& simulator = this->simulator();
         eclWriter_->beginRestart();
 
-        Scalar dt = std::min(eclWriter_->restartTimeStepSize(), simulator.episodeLength());
-        simulator.setTimeStepSize(dt);
+        setRestartTimeStepSize_(std::min(eclWriter_->restartTimeStepSize(), simulator.episodeLength()));
 
         size_t numElems = this->model().numGridDof();
         initialFluidStates_.resize(numElems);
@@ -2382,6 +2620,19 @@ private:
             // if we need to restart for polymer molecular weight simulation, we need to add related here
         }
 
+        if (tracerModel().numTracers() > 0 && this->gridView().comm().rank() == 0)
+            std::cout << "Warning: Restart is not implemented for the tracer model, it will initialize itself "
+                      << "with the initial tracer concentration.\n"
+                      << std::flush;
+    }
+
+    // set the size of the first time step after a restart and the DRSDT/DRVDT limits
+    // which are derived from it
+    void setRestartTimeStepSize_(Scalar dt)
+    {
+        auto& simulator = this->simulator();
+        simulator.setTimeStepSize(dt);
+
         const int episodeIdx = this->episodeIndex();
         const auto& oilVaporizationControl = simulator.vanguard().schedule()[episodeIdx].oilvap();
         if (this->drsdtActive_(episodeIdx))
@@ -2393,38 +2644,508 @@ private:
             // DRVDT is enabled
             for (size_t pvtRegionIdx = 0; pvtRegionIdx < this->maxDRv_.size(); ++pvtRegionIdx)
                 this->maxDRv_[pvtRegionIdx] = oilVaporizationControl.getMaxDRVDT(pvtRegionIdx)*simulator.timeStepSize();
+    }
 
-        if (tracerModel().numTracers() > 0 && this->gridView().comm().rank() == 0)
-            std::cout << "Warning: Restart is not implemented for the tracer model, it will initialize itself "
-                      << "with the initial tracer concentration.\n"
-                      << std::flush;
+    std::string checkpointFileName_(const std::string& restartBase, int reportStepNum, bool output) const
+    {
+        const auto& ioConfig = this->simulator().vanguard().eclState().getIOConfig();
+        return eclCheckpointFileName(ioConfig.getRestartFileName(restartBase, reportStepNum, output),
+                                     reportStepNum,
+                                     this->gridView().comm().rank());
+    }
 
-        // assign the restart solution to the current solution. note that we still need
-        // to compute real initial solution after this because the initial fluid states
-        // need to be correct for stuff like boundary conditions.
-        auto& sol = this->model().solution(/*timeIdx=*/0);
-        const auto& gridView = this->gridView();
-        ElementContext elemCtx(simulator);
-        auto elemIt = gridView.template begin</*codim=*/0>();
-        const auto& elemEndIt = gridView.template end</*codim=*/0>();
-        for (; elemIt != elemEndIt; ++elemIt) {
-            const auto& elem = *elemIt;
-            if (elem.partitionType() != Dune::InteriorEntity)
+    std::string checkpointMarkerFileName_(const std::string& restartBase, int reportStepNum, bool output) const
+    {
+        const auto& ioConfig = this->simulator().vanguard().eclState().getIOConfig();
+        return eclCheckpointMarkerFileName(ioConfig.getRestartFileName(restartBase, reportStepNum, output),
+                                           reportStepNum);
+    }
+
+    // Returns true on all processes if the condition holds on all of them.
+    bool checkpointAllRanks_(bool condition) const
+    { return this->gridView().comm().min(condition ? 1 : 0) == 1; }
+
+    // Runs a part of writing a checkpoint which may fail on some of the
+    // processes only, and throws on all of them if it failed on any.
+    template <class Operation>
+    void checkpointCollective_(const std::string& what, Operation operation) const
+    {
+        std::string error;
+        try {
+            operation();
+        }
+        catch (const std::exception& e) {
+            error = e.what();
+        }
+        if (!checkpointAllRanks_(error.empty()))
+            throw std::runtime_error(what + " failed" + (error.empty() ? " on another process" : ": " + error));
+    }
+
+    // The parts of the restart values which do not consist of per cell arrays.
+    struct CheckpointRestartValues_
+    {
+        data::Aquifers aquifers;
+        std::vector<char> summaryState;
+        std::map<std::string, std::size_t> actionRunCounts;
+        std::map<std::string, std::time_t> actionRunTimes;
+
+        template<class Serializer>
+        void serializeOp(Serializer& serializer)
+        {
+            if (!serializer.isSerializing()) {
+                aquifers.clear();
+                actionRunCounts.clear();
+                actionRunTimes.clear();
+            }
+            serializer(aquifers);
+            serializer(summaryState);
+            serializer(actionRunCounts);
+            serializer(actionRunTimes);
+        }
+    };
+
+    // Calls visit(name, get, set) for each quantity of the initial fluid states, where
+    // get(fluidState) returns the value of the quantity and set(fluidState, value)
+    // changes it.
+    template <class Visitor>
+    static void visitInitialFluidStates_(Visitor&& visit)
+    {
+        for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx) {
+            if (!FluidSystem::phaseIsActive(phaseIdx))
                 continue;
 
-            elemCtx.updatePrimaryStencil(elem);
-            int elemIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
-            initial(sol[elemIdx], elemCtx, /*spaceIdx=*/0, /*timeIdx=*/0);
+            const std::string phase = std::to_string(phaseIdx);
+            visit("INITP" + phase,
+                  [phaseIdx](const InitialFluidState& fs) { return fs.pressure(phaseIdx); },
+                  [phaseIdx](InitialFluidState& fs, Scalar value) { fs.setPressure(phaseIdx, value); });
+            visit("INITS" + phase,
+                  [phaseIdx](const InitialFluidState& fs) { return fs.saturation(phaseIdx); },
+                  [phaseIdx](InitialFluidState& fs, Scalar value) { fs.setSaturation(phaseIdx, value); });
+            visit("INITRHO" + phase,
+                  [phaseIdx](const InitialFluidState& fs) { return fs.density(phaseIdx); },
+                  [phaseIdx](InitialFluidState& fs, Scalar value) { fs.setDensity(phaseIdx, value); });
+            visit("INITINVB" + phase,
+                  [phaseIdx](const InitialFluidState& fs) { return fs.invB(phaseIdx); },
+                  [phaseIdx](InitialFluidState& fs, Scalar value) { fs.setInvB(phaseIdx, value); });
+            if constexpr (enableEnergy)
+                visit("INITH" + phase,
+                      [phaseIdx](const InitialFluidState& fs) { return fs.enthalpy(phaseIdx); },
+                      [phaseIdx](InitialFluidState& fs, Scalar value) { fs.setEnthalpy(phaseIdx, value); });
         }
 
-        // make sure that the ghost and overlap entities exhibit the correct
-        // solution. alternatively, this could be done in the loop above by also
-        // considering non-interior elements. Since the initial() method might not work
-        // 100% correctly for such elements, let's play safe and explicitly synchronize
-        // using message passing.
-        this->model().syncOverlap();
+        if constexpr (enableTemperature || enableEnergy)
+            visit("INITT",
+                  [](const InitialFluidState& fs) { return fs.temperature(/*phaseIdx=*/0); },
+                  [](InitialFluidState& fs, Scalar value) { fs.setTemperature(value); });
+
+        if constexpr (Indices::gasEnabled) {
+            visit("INITRS",
+                  [](const InitialFluidState& fs) { return fs.Rs(); },
+                  [](InitialFluidState& fs, Scalar value) { fs.setRs(value); });
+            visit("INITRV",
+                  [](const InitialFluidState& fs) { return fs.Rv(); },
+                  [](InitialFluidState& fs, Scalar value) { fs.setRv(value); });
+        }
 
-        eclWriter_->endRestart();
+        if constexpr (enableBrine)
+            visit("INITSALT",
+                  [](const InitialFluidState& fs) { return fs.saltConcentration(); },
+                  [](InitialFluidState& fs, Scalar value) { fs.setSaltConcentration(value); });
+    }
+
+    // The checkpoint holds everything which is needed to continue the simulation
+    // bit-identically: the raw primary variables and their meanings, the history
+    // dependent quantities of the cells, the initial fluid states, the tracer
+    // concentrations, the state of the wells, groups and aquifers, the summary and
+    // action states and the state of the time stepping.
+    //
+    // The files of all processes are only usable together. The marker file of the
+    // checkpoint is removed before any of them is replaced, and written again once
+    // all of them are in place.
+    void writeCheckpoint_(int reportStepNum, bool isSubStep) const
+    {
+        const auto& simulator = this->simulator();
+        const auto& ioConfig = simulator.vanguard().eclState().getIOConfig();
+        const int rank = this->gridView().comm().rank();
+        const std::string fileName = checkpointFileName_(ioConfig.fullBasePath(), reportStepNum, /*output=*/true);
+        const std::string markerFileName = checkpointMarkerFileName_(ioConfig.fullBasePath(), reportStepNum,
+                                                                     /*output=*/true);
+
+        std::unique_ptr<EclCheckpointWriter> writer;
+        checkpointCollective_("Writing checkpoint file " + fileName, [&]()
+        {
+            writer = std::make_unique<EclCheckpointWriter>(fileName);
+            writeCheckpointSections_(*writer, isSubStep);
+            if (rank == 0)
+                std::remove(markerFileName.c_str());
+        });
+
+        checkpointCollective_("Writing checkpoint file " + fileName, [&writer]()
+        {
+            writer->close();
+        });
+
+        checkpointCollective_("Writing checkpoint marker file " + markerFileName, [&]()
+        {
+            if (rank != 0)
+                return;
+
+            EclCheckpointWriter marker(markerFileName);
+            marker.write("NRANKS", std::vector<int>{this->gridView().comm().size()});
+            marker.write("TIME", std::vector<Scalar>{simulator.time() + simulator.timeStepSize()});
+            marker.write("SUBSTEP", std::vector<int>{isSubStep ? 1 : 0});
+            marker.close();
+        });
+    }
+
+    void writeCheckpointSections_(EclCheckpointWriter& writer, bool isSubStep) const
+    {
+        const auto& simulator = this->simulator();
+        const auto& vanguard = simulator.vanguard();
+
+        const auto& sol = this->model().solution(/*timeIdx=*/0);
+        const std::size_t numDof = this->model().numGridDof();
+        std::vector<int> cartesianIndices(numDof);
+        std::vector<Scalar> primaryVars(numDof*numEq);
+        std::vector<int> primaryVarsMeanings(numDof);
+        std::vector<unsigned> pvtRegions(numDof);
+        for (std::size_t dofIdx = 0; dofIdx < numDof; ++dofIdx) {
+            cartesianIndices[dofIdx] = vanguard.cartesianIndex(dofIdx);
+            for (unsigned eqIdx = 0; eqIdx < numEq; ++eqIdx)
+                primaryVars[dofIdx*numEq + eqIdx] = sol[dofIdx][eqIdx];
+            primaryVarsMeanings[dofIdx] = static_cast<int>(sol[dofIdx].primaryVarsMeaning());
+            pvtRegions[dofIdx] = sol[dofIdx].pvtRegionIndex();
+        }
+        writer.write("CARTIDX", cartesianIndices);
+        writer.write("PRIMVARS", primaryVars);
+        writer.write("PVMEANING", primaryVarsMeanings);
+        writer.write("PVTREGION", pvtRegions);
+
+        // the time at which the simulation continues and the size of its next step
+        writer.write("TIME", std::vector<Scalar>{simulator.time() + simulator.timeStepSize()});
+        writer.write("SUBSTEP", std::vector<int>{isSubStep ? 1 : 0});
+        writer.write("DTNEXT", std::vector<Scalar>{this->nextTimeStepSize()});
+        writer.write("TSCTRL", timeStepControlState_);
+
+        auto writeIfUsed = [&writer](const std::string& name, const std::vector<Scalar>& values)
+        {
+            if (!values.empty())
+                writer.write(name, values);
+        };
+        writeIfUsed("SOMAX", this->maxOilSaturation_);
+        writeIfUsed("SWMAX", this->maxWaterSaturation_);
+        writeIfUsed("POMIN", this->minOilPressure_);
+        writeIfUsed("POLYADS", this->maxPolymerAdsorption_);
+        writeIfUsed("LASTRS", this->lastRs_);
+        writeIfUsed("LASTRV", this->lastRv_);
+        writeIfUsed("SSOL", this->solventSaturation_);
+        writeIfUsed("SPOLY", this->polymerConcentration_);
+        writeIfUsed("SPOLYMW", this->polymerMoleWeight_);
+        writeIfUsed("THPRES", thresholdPressures_.data());
+
+        const auto& matLawManager = this->materialLawManager();
+        if (matLawManager->enableHysteresis()) {
+            std::vector<Scalar> pcSwMdcOw(numDof), krnSwMdcOw(numDof);
+            std::vector<Scalar> pcSwMdcGo(numDof), krnSwMdcGo(numDof);
+            for (std::size_t dofIdx = 0; dofIdx < numDof; ++dofIdx) {
+                matLawManager->oilWaterHysteresisParams(pcSwMdcOw[dofIdx], krnSwMdcOw[dofIdx], dofIdx);
+                matLawManager->gasOilHysteresisParams(pcSwMdcGo[dofIdx], krnSwMdcGo[dofIdx], dofIdx);
+            }
+            writer.write("PCSWM_OW", pcSwMdcOw);
+            writer.write("KRNSW_OW", krnSwMdcOw);
+            writer.write("PCSWM_GO", pcSwMdcGo);
+            writer.write("KRNSW_GO", krnSwMdcGo);
+        }
+
+        if (vanguard.eclState().fieldProps().has_double("SWATINIT")) {
+            std::vector<Scalar> maxPcow(numDof);
+            for (std::size_t dofIdx = 0; dofIdx < numDof; ++dofIdx)
+                maxPcow[dofIdx] = matLawManager->oilWaterScaledEpsInfoDrainage(dofIdx).maxPcow;
+            writer.write("PPCW", maxPcow);
+        }
+
+        if (enableDriftCompensation_) {
+            std::vector<Scalar> drift(numDof*numEq);
+            for (std::size_t dofIdx = 0; dofIdx < numDof; ++dofIdx)
+                for (unsigned eqIdx = 0; eqIdx < numEq; ++eqIdx)
+                    drift[dofIdx*numEq + eqIdx] = drift_[dofIdx][eqIdx];
+            writer.write("DRIFT", drift);
+        }
+
+        visitInitialFluidStates_([this, &writer, numDof](const std::string& name, auto get, auto)
+        {
+            std::vector<Scalar> values(numDof);
+            for (std::size_t dofIdx = 0; dofIdx < numDof; ++dofIdx)
+                values[dofIdx] = get(initialFluidStates_[dofIdx]);
+            writer.write(name, values);
+        });
+
+        for (int tracerIdx = 0; tracerIdx < tracerModel_.numTracers(); ++tracerIdx) {
+            const auto& concentration = tracerModel_.tracerConcentrations(tracerIdx);
+            std::vector<Scalar> values(concentration.size());
+            for (std::size_t dofIdx = 0; dofIdx < values.size(); ++dofIdx)
+                values[dofIdx] = concentration[dofIdx];
+            writer.write("TR_" + tracerModel_.tracerName(tracerIdx), values);
+        }
+
+        writer.write("WELLSTATE", wellModel_.packCheckpoint());
+
+        CheckpointRestartValues_ restartValues;
+        if (enableAquifers_)
+            restartValues.aquifers = aquiferModel_.aquiferData();
+        restartValues.summaryState = vanguard.summaryState().serialize();
+        const auto& actionState = vanguard.actionState();
+        for (const auto& action : vanguard.schedule()[this->episodeIndex()].actions()) {
+            const auto runCount = actionState.run_count(action);
+            if (runCount == 0)
+                continue;
+
+            restartValues.actionRunCounts[action.name()] = runCount;
+            restartValues.actionRunTimes[action.name()] = actionState.run_time(action);
+        }
+
+        EclMpiSerializer serializer(Dune::MPIHelper::getLocalCommunicator());
+        serializer.pack(restartValues);
+        const auto& buffer = serializer.buffer();
+        writer.write("RESTARTVAL", std::vector<char>(buffer.begin(), buffer.begin() + serializer.position()));
+    }
+
+    // All processes restart from the checkpoint, or none of them does. A checkpoint
+    // whose marker file or file of any process is missing, or whose files belong to
+    // different steps, was not written completely and is not used.
+    void openCheckpoint_(const std::string& restartRootName, int restartStep)
+    {
+        const auto& comm = this->gridView().comm();
+        const std::string fileName = checkpointFileName_(restartRootName, restartStep, /*output=*/false);
+        const std::string markerFileName = checkpointMarkerFileName_(restartRootName, restartStep,
+                                                                     /*output=*/false);
+        if (!checkpointAllRanks_(filesystem::exists(markerFileName))) {
+            OpmLog::warning("Checkpoint marker file " + markerFileName + " does not exist, "
+                            "restarting from the ECL restart file");
+            return;
+        }
+
+        std::unique_ptr<EclCheckpointReader> checkpoint;
+        bool sameRanks = false;
+        bool sameStep = false;
+        bool samePartitioning = false;
+        Scalar time = 0.0;
+        std::string error;
+        try {
+            const EclCheckpointReader marker(markerFileName);
+            sameRanks = marker.read<int>("NRANKS") == std::vector<int>{comm.size()};
+            if (sameRanks && filesystem::exists(fileName)) {
+                checkpoint = std::make_unique<EclCheckpointReader>(fileName);
+                time = checkpoint->read<Scalar>("TIME").at(0);
+                sameStep = marker.read<Scalar>("TIME") == checkpoint->read<Scalar>("TIME")
+                    && marker.read<int>("SUBSTEP") == checkpoint->read<int>("SUBSTEP");
+
+                // make sure that the checkpoint belongs to the same partitioning of the grid
+                const auto& vanguard = this->simulator().vanguard();
+                const auto cartesianIndices = checkpoint->read<int>("CARTIDX");
+                samePartitioning = cartesianIndices.size() == this->model().numGridDof();
+                for (std::size_t dofIdx = 0; samePartitioning && dofIdx < cartesianIndices.size(); ++dofIdx)
+                    samePartitioning = cartesianIndices[dofIdx] == static_cast<int>(vanguard.cartesianIndex(dofIdx));
+            }
+        }
+        catch (const std::exception& e) {
+            error = e.what();
+        }
+
+        if (!checkpointAllRanks_(error.empty()))
+            throw std::runtime_error("Reading checkpoint " + markerFileName + " failed"
+                                     + (error.empty() ? " on another process" : ": " + error));
+
+        if (!checkpointAllRanks_(sameRanks))
+            throw std::runtime_error("Checkpoint " + markerFileName + " was written by a different "
+                                     "number of processes");
+
+        if (!checkpointAllRanks_(checkpoint != nullptr && sameStep) || comm.min(time) != comm.max(time)) {
+            OpmLog::warning("Checkpoint " + markerFileName + " is incomplete, "
+                            "restarting from the ECL restart file");
+            return;
+        }
+
+        if (!checkpointAllRanks_(samePartitioning))
+            throw std::runtime_error("Checkpoint " + markerFileName + " was written for a different "
+                                     "grid or partitioning");
+
+        checkpoint_ = std::move(checkpoint);
+        OpmLog::info("Restarting from checkpoint " + markerFileName);
+    }
+
+    // Set up everything which the ECL restart file would provide from the checkpoint.
+    // The primary variables, the polymer adsorption, the tracers and the drift are
+    // applied by applyCheckpoint_() once the models are initialized.
+    void readCheckpointRestart_()
+    {
+        auto& simulator = this->simulator();
+        const std::size_t numElems = this->model().numGridDof();
+
+        // the initial fluid states are those of the original run, they are used for
+        // the boundary conditions
+        initialFluidStates_.resize(numElems);
+        for (std::size_t elemIdx = 0; elemIdx < numElems; ++elemIdx)
+            initialFluidStates_[elemIdx].setPvtRegionIndex(pvtRegionIndex(elemIdx));
+        visitInitialFluidStates_([this, numElems](const std::string& name, auto, auto set)
+        {
+            const auto values = checkpoint_->read<Scalar>(name);
+            if (values.size() != numElems)
+                throw std::runtime_error("Initial fluid state " + name + " of the checkpoint "
+                                         "does not match the grid");
+            for (std::size_t elemIdx = 0; elemIdx < numElems; ++elemIdx)
+                set(initialFluidStates_[elemIdx], values[elemIdx]);
+        });
+
+        if constexpr (enableSolvent)
+            this->solventSaturation_.resize(numElems, 0.0);
+        if constexpr (enablePolymer)
+            this->polymerConcentration_.resize(numElems, 0.0);
+        if constexpr (enablePolymerMolarWeight)
+            this->polymerMoleWeight_.resize(numElems, 0.0);
+        readCheckpointHistory_();
+
+        if (checkpoint_->has("PPCW")) {
+            const auto maxPcow = checkpoint_->read<Scalar>("PPCW");
+            for (std::size_t elemIdx = 0; elemIdx < maxPcow.size(); ++elemIdx)
+                this->materialLawManager()->oilWaterScaledEpsInfoDrainagePointerReferenceHack(elemIdx)->maxPcow = maxPcow[elemIdx];
+        }
+
+        const auto& inputThpres = simulator.vanguard().eclState().getSimulationConfig().getThresholdPressure();
+        if (inputThpres.active() && checkpoint_->has("THPRES"))
+            thresholdPressures_.setFromRestart(checkpoint_->read<Scalar>("THPRES"));
+
+        // within a report step, the time stepping continues with the estimate for the
+        // next sub step, which is limited to the remaining part of the step by the
+        // time stepper
+        const bool isSubStep = checkpoint_->read<int>("SUBSTEP")[0] != 0;
+        Scalar dt = checkpoint_->read<Scalar>("DTNEXT")[0];
+        if (!isSubStep)
+            dt = std::min(dt, simulator.episodeLength());
+        setRestartTimeStepSize_(dt);
+        timeStepControlState_ = checkpoint_->read<double>("TSCTRL");
+
+        // the well state of a checkpoint written within the report step replaces the
+        // one set up at the beginning of the step, see beginEpisode()
+        auto wellState = checkpoint_->read<char>("WELLSTATE");
+        if (isSubStep) {
+            wellModel_.initFromCheckpoint(std::vector<char>{});
+            subStepWellState_ = std::move(wellState);
+        }
+        else
+            wellModel_.initFromCheckpoint(wellState);
+
+        CheckpointRestartValues_ restartValues;
+        EclMpiSerializer serializer(Dune::MPIHelper::getLocalCommunicator());
+        serializer.setBuffer(checkpoint_->read<char>("RESTARTVAL"));
+        serializer.unpack(restartValues);
+
+        if (!restartValues.aquifers.empty())
+            aquiferModel_.initFromRestart(restartValues.aquifers);
+
+        simulator.vanguard().summaryState().deserialize(restartValues.summaryState);
+
+        auto& actionState = simulator.vanguard().actionState();
+        for (const auto& action : simulator.vanguard().schedule()[this->episodeIndex()].actions()) {
+            const auto runCount = restartValues.actionRunCounts.find(action.name());
+            if (runCount == restartValues.actionRunCounts.end())
+                continue;
+
+            const auto runTime = restartValues.actionRunTimes.at(action.name());
+            for (std::size_t run = 0; run < runCount->second; ++run)
+                actionState.add_run(action, runTime);
+        }
+
+        if (isSubStep) {
+            subStepRestartTime_ = checkpoint_->read<Scalar>("TIME")[0];
+            simulator.setTime(subStepRestartTime_);
+        }
+    }
+
+    // Only the history dependent quantities are taken from the checkpoint. The
+    // DRSDT/DRVDT limits are derived from the size of the first time step after
+    // the restart and have already been recomputed by the caller.
+    void readCheckpointHistory_()
+    {
+        auto readIfUsed = [this](const std::string& name, std::vector<Scalar>& values)
+        {
+            if (!values.empty() && checkpoint_->has(name))
+                checkpoint_->read(name, values.data(), values.size());
+        };
+        readIfUsed("SOMAX", this->maxOilSaturation_);
+        readIfUsed("SWMAX", this->maxWaterSaturation_);
+        readIfUsed("POMIN", this->minOilPressure_);
+        readIfUsed("LASTRS", this->lastRs_);
+        readIfUsed("LASTRV", this->lastRv_);
+        readIfUsed("SSOL", this->solventSaturation_);
+        readIfUsed("SPOLY", this->polymerConcentration_);
+        readIfUsed("SPOLYMW", this->polymerMoleWeight_);
+
+        auto matLawManager = this->materialLawManager();
+        if (matLawManager->enableHysteresis() && checkpoint_->has("PCSWM_OW")) {
+            const auto pcSwMdcOw = checkpoint_->read<Scalar>("PCSWM_OW");
+            const auto krnSwMdcOw = checkpoint_->read<Scalar>("KRNSW_OW");
+            const auto pcSwMdcGo = checkpoint_->read<Scalar>("PCSWM_GO");
+            const auto krnSwMdcGo = checkpoint_->read<Scalar>("KRNSW_GO");
+            for (std::size_t dofIdx = 0; dofIdx < pcSwMdcOw.size(); ++dofIdx) {
+                matLawManager->setOilWaterHysteresisParams(pcSwMdcOw[dofIdx], krnSwMdcOw[dofIdx], dofIdx);
+                matLawManager->setGasOilHysteresisParams(pcSwMdcGo[dofIdx], krnSwMdcGo[dofIdx], dofIdx);
+            }
+        }
+    }
+
+    void applyCheckpoint_()
+    {
+        // the polymer adsorption and the tracers are only set up after the restart
+        // solution has been read
+        if (!this->maxPolymerAdsorption_.empty() && checkpoint_->has("POLYADS"))
+            checkpoint_->read("POLYADS", this->maxPolymerAdsorption_.data(), this->maxPolymerAdsorption_.size());
+
+        for (int tracerIdx = 0; tracerIdx < tracerModel_.numTracers(); ++tracerIdx) {
+            const std::string name = "TR_" + tracerModel_.tracerName(tracerIdx);
+            if (!checkpoint_->has(name))
+                continue;
+
+            auto concentration = tracerModel_.tracerConcentrations(tracerIdx);
+            const auto values = checkpoint_->read<Scalar>(name);
+            if (values.size() != concentration.size())
+                throw std::runtime_error("Tracer " + tracerModel_.tracerName(tracerIdx) + " of the checkpoint "
+                                         "does not match the grid");
+            for (std::size_t dofIdx = 0; dofIdx < values.size(); ++dofIdx)
+                concentration[dofIdx] = values[dofIdx];
+            tracerModel_.setTracerConcentrations(tracerIdx, concentration);
+        }
+
+        // the drift is reset when the model is initialized
+        if (enableDriftCompensation_ && checkpoint_->has("DRIFT")) {
+            const auto drift = checkpoint_->read<Scalar>("DRIFT");
+            if (drift.size() != drift_.size()*numEq)
+                throw std::runtime_error("The drift of the checkpoint does not match the grid");
+            for (std::size_t dofIdx = 0; dofIdx < drift_.size(); ++dofIdx)
+                for (unsigned eqIdx = 0; eqIdx < numEq; ++eqIdx)
+                    drift_[dofIdx][eqIdx] = drift[dofIdx*numEq + eqIdx];
+        }
+
+        const std::size_t numDof = this->model().numGridDof();
+        std::vector<Scalar> primaryVars(numDof*numEq);
+        std::vector<int> primaryVarsMeanings(numDof);
+        std::vector<unsigned> pvtRegions(numDof);
+        checkpoint_->read("PRIMVARS", primaryVars.data(), primaryVars.size());
+        checkpoint_->read("PVMEANING", primaryVarsMeanings.data(), primaryVarsMeanings.size());
+        checkpoint_->read("PVTREGION", pvtRegions.data(), pvtRegions.size());
+
+        auto& sol = this->model().solution(/*timeIdx=*/0);
+        for (std::size_t dofIdx = 0; dofIdx < numDof; ++dofIdx) {
+            auto& priVars = sol[dofIdx];
+            priVars.setPvtRegionIndex(pvtRegions[dofIdx]);
+            priVars.setPrimaryVarsMeaning(static_cast<typename PrimaryVariables::PrimaryVarsMeaning>(primaryVarsMeanings[dofIdx]));
+            for (unsigned eqIdx = 0; eqIdx < numEq; ++eqIdx)
+                priVars[eqIdx] = primaryVars[dofIdx*numEq + eqIdx];
+        }
+        this->model().solution(/*timeIdx=*/1) = sol;
+        this->model().invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
+
+        checkpoint_.reset();
     }
 
     void processRestartSaturations_(InitialFluidState& elemFluidState, Scalar& solventSaturation)
@@ -2647,15 +3368,22 @@ private:
         }
     }
 
+    // the static data of the connections between an element and its neighbors. this
+    // is the only copy of the interior transmissibilities which is kept after
+    // initialization.
     struct PffDofData_
     {
         ConditionalStorage<enableEnergy, Scalar> thermalHalfTransIn;
         ConditionalStorage<enableEnergy, Scalar> thermalHalfTransOut;
         ConditionalStorage<enableDiffusion, Scalar> diffusivity;
         Scalar transmissibility;
+        Scalar thresholdPressure;
+        Scalar depthDifference;
     };
 
-    // update the prefetch friendly data object
+    // update the prefetch friendly data object. the threshold pressures are set
+    // separately by updatePffThresholdPressures_() because they are only known
+    // once the initial solution has been applied.
     void updatePffDofData_()
     {
         const auto& distFn =
@@ -2670,6 +3398,14 @@ private:
             if (localDofIdx != 0) {
                 unsigned globalCenterElemIdx = elementMapper.index(stencil.entity(/*dofIdx=*/0));
                 dofData.transmissibility = transmissibilities_.transmissibility(globalCenterElemIdx, globalElemIdx);
+                dofData.thresholdPressure = 0.0;
+
+                // ECL defines the depth of a cell as the average depth of its corners
+                // which is slightly different from the depth of the centroid, so ask
+                // the vanguard for it.
+                const auto& vanguard = this->simulator().vanguard();
+                dofData.depthDifference =
+                    vanguard.cellCenterDepth(globalCenterElemIdx) - vanguard.cellCenterDepth(globalElemIdx);
 
                 if constexpr (enableEnergy) {
                     *dofData.thermalHalfTransIn = transmissibilities_.thermalHalfTrans(globalCenterElemIdx, globalElemIdx);
@@ -2683,6 +3419,26 @@ private:
         pffDofData_.update(distFn);
     }
 
+    void updatePffThresholdPressures_()
+    {
+        const auto& distFn =
+            [this](PffDofData_& dofData,
+                   const Stencil& stencil,
+                   unsigned localDofIdx)
+            -> void
+        {
+            if (localDofIdx == 0)
+                return;
+
+            const auto& elementMapper = this->model().elementMapper();
+            unsigned globalElemIdx = elementMapper.index(stencil.entity(localDofIdx));
+            unsigned globalCenterElemIdx = elementMapper.index(stencil.entity(/*dofIdx=*/0));
+            dofData.thresholdPressure = thresholdPressures_.thresholdPressure(globalCenterElemIdx, globalElemIdx);
+        };
+
+        pffDofData_.update(distFn);
+    }
+
     void readBoundaryConditions_()
     {
         nonTrivialBoundaryConditions_ = false;
@@ -2886,6 +3642,14 @@ private:
     bool enableEclOutput_;
     std::unique_ptr<EclWriterType> eclWriter_;
 
+    bool enableEclCheckpoint_;
+    int eclCheckpointInterval_;
+    bool eclCheckpointSubSteps_;
+    std::unique_ptr<EclCheckpointReader> checkpoint_;
+    std::vector<double> timeStepControlState_;
+    Scalar subStepRestartTime_ = -1.0;
+    std::vector<char> subStepWellState_;
+
     PffGridVector<GridView, Stencil, PffDofData_, DofMapper> pffDofData_;
     TracerModel tracerModel_;
 
@@ -31,12 +31,17 @@
 #include <opm/models/utils/propertysystem.hh>
 #include <opm/models/discretization/common/fvbaseproperties.hh>
 #include <opm/models/common/multiphasebaseproperties.hh>
+#include <opm/models/parallel/threadedentityiterator.hh>
 #include <ebos/eclgenericthresholdpressure.hh>
 
 #include <opm/material/densead/Evaluation.hpp>
 #include <opm/material/densead/Math.hpp>
 
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <exception>
+#include <mutex>
 #include <vector>
 
 namespace Opm {
@@ -63,12 +68,14 @@ class EclThresholdPressure : public EclGenericThresholdPressure<GetPropType<Type
                                                  GetPropType<TypeTag, Properties::Scalar>>;
     using Simulator = GetPropType<TypeTag, Properties::Simulator>;
     using Scalar = GetPropType<TypeTag, Properties::Scalar>;
-    using Evaluation = GetPropType<TypeTag, Properties::Evaluation>;
-    using ElementContext = GetPropType<TypeTag, Properties::ElementContext>;
     using FluidSystem = GetPropType<TypeTag, Properties::FluidSystem>;
+    using GridView = GetPropType<TypeTag, Properties::GridView>;
+    using MaterialLaw = GetPropType<TypeTag, Properties::MaterialLaw>;
+    using ThreadManager = GetPropType<TypeTag, Properties::ThreadManager>;
 
     enum { enableExperiments = getPropValue<TypeTag, Properties::EnableExperiments>() };
     enum { numPhases = FluidSystem::numPhases };
+    enum { dimWorld = GridView::dimensionworld };
 
 public:
     EclThresholdPressure(const Simulator& simulator)
@@ -98,72 +105,145 @@ private:
     // compute the defaults of the threshold pressures using the initial condition
     void computeDefaultThresholdPressures_()
     {
-        const auto& vanguard = simulator_.vanguard();
-        const auto& gridView = vanguard.gridView();
+        const auto& gridView = simulator_.vanguard().gridView();
 
-        typedef MathToolbox<Evaluation> Toolbox;
         // loop over the whole grid and compute the maximum gravity adjusted pressure
-        // difference between two EQUIL regions.
-        auto elemIt = gridView.template begin</*codim=*/ 0>();
-        const auto& elemEndIt = gridView.template end</*codim=*/ 0>();
-        ElementContext elemCtx(simulator_);
-        for (; elemIt != elemEndIt; ++elemIt) {
-
-            const auto& elem = *elemIt;
-            if (elem.partitionType() != Dune::InteriorEntity)
+        // difference between two EQUIL regions. Only the faces between different
+        // EQUIL regions contribute, so these are visited directly and the pressure
+        // differences are computed from the initial fluid states instead of
+        // evaluating the full element contexts. Each thread accumulates the maxima
+        // in its own table.
+        std::vector<std::vector<Scalar>> threadThpres(ThreadManager::maxThreads(),
+                                                      std::vector<Scalar>(this->thpresDefault_.size(), 0.0));
+
+        std::mutex exceptionLock;
+        std::exception_ptr exceptionPtr = nullptr;
+        ThreadedEntityIterator<GridView, /*codim=*/0> threadedElemIt(gridView);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            auto& thpres = threadThpres[ThreadManager::threadId()];
+            auto elemIt = threadedElemIt.beginParallel();
+            try {
+                for (; !threadedElemIt.isFinished(elemIt); elemIt = threadedElemIt.increment()) {
+                    const auto& elem = *elemIt;
+                    if (elem.partitionType() != Dune::InteriorEntity)
+                        continue;
+
+                    updateDefaultThresholdPressures_(elem, thpres);
+                }
+            }
+            // exceptions must not escape the parallel block, so remember the
+            // exception and rethrow it once all threads are done.
+            catch (...) {
+                std::lock_guard<std::mutex> take(exceptionLock);
+                exceptionPtr = std::current_exception();
+                threadedElemIt.setFinished();
+            }
+        }
+
+        if (exceptionPtr)
+            std::rethrow_exception(exceptionPtr);
+
+        for (const auto& thpres : threadThpres)
+            for (unsigned i = 0; i < this->thpresDefault_.size(); ++i)
+                this->thpresDefault_[i] = std::max(this->thpresDefault_[i], thpres[i]);
+
+        // make sure that the threshold pressures is consistent for parallel
+        // runs. (i.e. take the maximum of all processes)
+        gridView.comm().max(this->thpresDefault_.data(), this->thpresDefault_.size());
+    }
+
+    // update the maximum pressure differences over the faces of an element which
+    // are at the boundary between EQUIL regions
+    template <class Element>
+    void updateDefaultThresholdPressures_(const Element& elem, std::vector<Scalar>& thpres) const
+    {
+        const auto& problem = simulator_.problem();
+        const auto& vanguard = simulator_.vanguard();
+        const auto& gridView = vanguard.gridView();
+        const auto& elementMapper = simulator_.model().elementMapper();
+        const Scalar g = problem.gravity()[dimWorld - 1];
+
+        const unsigned insideElemIdx = elementMapper.index(elem);
+        const unsigned equilRegionInside = this->elemEquilRegion_[insideElemIdx];
+
+        // the index of the neighbor in the element's stencil. the interior
+        // transmissibilities are only stored per stencil entry once the problem
+        // has been initialized.
+        unsigned neighborLocalIdx = 0;
+        auto isIt = gridView.ibegin(elem);
+        const auto& isEndIt = gridView.iend(elem);
+        for (; isIt != isEndIt; ++isIt) {
+            const auto& intersection = *isIt;
+            if (!intersection.neighbor())
                 continue;
 
-            elemCtx.updateAll(elem);
-            const auto& stencil = elemCtx.stencil(/*timeIdx=*/0);
+            ++neighborLocalIdx;
+            const unsigned outsideElemIdx = elementMapper.index(intersection.outside());
+            const unsigned equilRegionOutside = this->elemEquilRegion_[outsideElemIdx];
 
-            for (unsigned scvfIdx = 0; scvfIdx < stencil.numInteriorFaces(); ++ scvfIdx) {
-                const auto& face = stencil.interiorFace(scvfIdx);
+            if (equilRegionInside == equilRegionOutside)
+                // the current face is not at the boundary between EQUIL regions!
+                continue;
 
-                unsigned i = face.interiorIndex();
-                unsigned j = face.exteriorIndex();
+            // don't include connections with negligible flow
+            const Scalar trans = problem.transmissibility(elem, neighborLocalIdx);
+            const Scalar faceArea = intersection.geometry().volume();
+            if (std::abs(faceArea*trans) < 1e-18)
+                continue;
 
-                unsigned insideElemIdx = elemCtx.globalSpaceIndex(i, /*timeIdx=*/0);
-                unsigned outsideElemIdx = elemCtx.globalSpaceIndex(j, /*timeIdx=*/0);
+            const Scalar distZ = vanguard.cellCenterDepth(insideElemIdx) - vanguard.cellCenterDepth(outsideElemIdx);
+            const Scalar pth = maxPressureDifference_(insideElemIdx, outsideElemIdx, distZ*g);
 
-                unsigned equilRegionInside = this->elemEquilRegion_[insideElemIdx];
-                unsigned equilRegionOutside = this->elemEquilRegion_[outsideElemIdx];
+            const int offset1 = equilRegionInside*this->numEquilRegions_ + equilRegionOutside;
+            const int offset2 = equilRegionOutside*this->numEquilRegions_ + equilRegionInside;
 
-                if (equilRegionInside == equilRegionOutside)
-                    // the current face is not at the boundary between EQUIL regions!
-                    continue;
+            thpres[offset1] = std::max(thpres[offset1], pth);
+            thpres[offset2] = std::max(thpres[offset2], pth);
+        }
+    }
 
-                // don't include connections with negligible flow
-                const Evaluation& trans = simulator_.problem().transmissibility(elemCtx, i, j);
-                Scalar faceArea = face.area();
-                if (std::abs(faceArea*getValue(trans)) < 1e-18)
-                    continue;
+    // determine the maximum difference of the pressure of any mobile phase
+    // between two elements. this corresponds to the pressure differences which
+    // are used by the flux module.
+    Scalar maxPressureDifference_(unsigned insideElemIdx, unsigned outsideElemIdx, Scalar gDistZ) const
+    {
+        const auto& problem = simulator_.problem();
+        const auto& fsIn = problem.initialFluidState(insideElemIdx);
+        const auto& fsEx = problem.initialFluidState(outsideElemIdx);
+
+        std::array<Scalar, numPhases> krIn;
+        std::array<Scalar, numPhases> krEx;
+        MaterialLaw::relativePermeabilities(krIn, problem.materialLawParams(insideElemIdx), fsIn);
+        MaterialLaw::relativePermeabilities(krEx, problem.materialLawParams(outsideElemIdx), fsEx);
+
+        const unsigned pvtRegionIn = problem.pvtRegionIndex(insideElemIdx);
+        const unsigned pvtRegionEx = problem.pvtRegionIndex(outsideElemIdx);
+        const Scalar thpres = this->thresholdPressure(insideElemIdx, outsideElemIdx);
+
+        Scalar pth = 0.0;
+        for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx) {
+            if (!FluidSystem::phaseIsActive(phaseIdx))
+                continue;
 
-                // determine the maximum difference of the pressure of any phase over the
-                // intersection
-                Scalar pth = 0.0;
-                const auto& extQuants = elemCtx.extensiveQuantities(scvfIdx, /*timeIdx=*/0);
-                for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx) {
-                    unsigned upIdx = extQuants.upstreamIndex(phaseIdx);
-                    const auto& up = elemCtx.intensiveQuantities(upIdx, /*timeIdx=*/0);
+            const Scalar rhoIn = FluidSystem::density(fsIn, phaseIdx, pvtRegionIn);
+            const Scalar rhoEx = FluidSystem::density(fsEx, phaseIdx, pvtRegionEx);
+            const Scalar rhoAvg = (rhoIn + rhoEx)/2;
 
-                    if (up.mobility(phaseIdx) > 0.0) {
-                        Scalar phaseVal = Toolbox::value(extQuants.pressureDifference(phaseIdx));
-                        pth = std::max(pth, std::abs(phaseVal));
-                    }
-                }
+            const Scalar pressureDifference =
+                fsEx.pressure(phaseIdx) + rhoAvg*gDistZ - fsIn.pressure(phaseIdx);
 
-                int offset1 = equilRegionInside*this->numEquilRegions_ + equilRegionOutside;
-                int offset2 = equilRegionOutside*this->numEquilRegions_ + equilRegionInside;
+            // only consider phases which are mobile in the upstream element
+            const Scalar krUp = (pressureDifference > 0.0) ? krEx[phaseIdx] : krIn[phaseIdx];
+            if (!(krUp > 0.0))
+                continue;
 
-                this->thpresDefault_[offset1] = std::max(this->thpresDefault_[offset1], pth);
-                this->thpresDefault_[offset2] = std::max(this->thpresDefault_[offset2], pth);
-            }
+            pth = std::max(pth, std::abs(pressureDifference) - thpres);
         }
 
-        // make sure that the threshold pressures is consistent for parallel
-        // runs. (i.e. take the maximum of all processes)
-        for (unsigned i = 0; i < this->thpresDefault_.size(); ++i)
-            this->thpresDefault_[i] = gridView.comm().max(this->thpresDefault_[i]);
+        return pth;
     }
 
     const Simulator& simulator_;
@@ -30,9 +30,14 @@
 
 #include <ebos/eclgenerictracermodel.hh>
 
+#include <opm/models/parallel/threadedentityiterator.hh>
 #include <opm/models/utils/propertysystem.hh>
 
+#include <algorithm>
+#include <exception>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace Opm::Properties {
@@ -50,8 +55,6 @@ namespace Opm {
  * \ingroup EclBlackOilSimulator
  *
  * \brief A class which handles tracers as specified in by ECL
- *
- * TODO: MPI parallelism.
  */
 template <class TypeTag>
 class EclTracerModel : public EclGenericTracerModel<GetPropType<TypeTag, Properties::Grid>,
@@ -105,11 +108,26 @@ public:
     {
         bool enabled = EWOMS_GET_PARAM(TypeTag, bool, EnableTracerModel);
         this->doInit(enabled, simulator_.model().numGridDof(),
-                     gasPhaseIdx, oilPhaseIdx, waterPhaseIdx);
+                     gasPhaseIdx, oilPhaseIdx, waterPhaseIdx,
+                     simulator_.vanguard().cellCenterDepths());
 
         prepareTracerBatches();
     }
 
+    /*!
+     * \brief Overwrite the concentrations of a tracer, e.g. when restarting
+     */
+    void setTracerConcentrations(int tracerIdx, const TracerVector& concentration)
+    {
+        this->tracerConcentration_[tracerIdx] = concentration;
+        for (auto* tr : {&wat_, &oil_, &gas_}) {
+            for (int tIdx = 0; tIdx < tr->numTracer(); ++tIdx) {
+                if (tr->idx_[tIdx] == tracerIdx)
+                    tr->setConcentration(tIdx, concentration);
+            }
+        }
+    }
+
     void beginTimeStep()
     {
         if (this->numTracers()==0)
@@ -225,85 +243,125 @@ protected:
         // Compare also advanceTracerFields(...) below.
 
         (*this->tracerMatrix_) = 0.0;
-        for (int tIdx =0; tIdx < tr.numTracer(); ++tIdx)
-            tr.residual_[tIdx] = 0.0;
-
-        ElementContext elemCtx(simulator_);
-        auto elemIt = simulator_.gridView().template begin</*codim=*/0>();
-        auto elemEndIt = simulator_.gridView().template end</*codim=*/0>();
-        for (; elemIt != elemEndIt; ++ elemIt) {
-            elemCtx.updateAll(*elemIt);
-
-            Scalar extrusionFactor =
-                    elemCtx.intensiveQuantities(/*dofIdx=*/ 0, /*timeIdx=*/0).extrusionFactor();
-            Valgrind::CheckDefined(extrusionFactor);
-            assert(isfinite(extrusionFactor));
-            assert(extrusionFactor > 0.0);
-            Scalar scvVolume =
-                    elemCtx.stencil(/*timeIdx=*/0).subControlVolume(/*dofIdx=*/ 0).volume()
-                    * extrusionFactor;
-            Scalar dt = elemCtx.simulator().timeStepSize();
-
-            size_t I = elemCtx.globalSpaceIndex(/*dofIdx=*/ 0, /*timIdx=*/0);
-            size_t I1 = elemCtx.globalSpaceIndex(/*dofIdx=*/ 0, /*timIdx=*/1);
-
-            Scalar storageOfTimeIndex1[tr.numTracer()];
-            if (elemCtx.enableStorageCache()) {
-                for (int tIdx =0; tIdx < tr.numTracer(); ++tIdx) {
-                    storageOfTimeIndex1[tIdx] = tr.storageOfTimeIndex1_[tIdx][I];
+        std::fill(tr.residual_.begin(), tr.residual_.end(), 0.0);
+
+        // Every element only writes the residual and the matrix column of its
+        // own degree of freedom, so the elements can be assembled by all
+        // threads at once.
+        std::mutex exceptionLock;
+        std::exception_ptr exceptionPtr = nullptr;
+        ThreadedEntityIterator<GridView, /*codim=*/0> threadedElemIt(simulator_.gridView());
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            ElementContext elemCtx(simulator_);
+            auto elemIt = threadedElemIt.beginParallel();
+            try {
+                for (; !threadedElemIt.isFinished(elemIt); elemIt = threadedElemIt.increment()) {
+                    elemCtx.updateAll(*elemIt);
+                    assembleElement_(tr, elemCtx);
                 }
             }
-            else {
-                Scalar fVolume1;
-                computeVolume_(fVolume1, tr.phaseIdx_, elemCtx, 0, /*timIdx=*/1);
-                for (int tIdx =0; tIdx < tr.numTracer(); ++tIdx) {
-                    storageOfTimeIndex1[tIdx] = fVolume1*tr.concentrationInitial_[tIdx][I1];
-                }
+            // exceptions must not escape the parallel block, so remember the
+            // exception and rethrow it once all threads are done.
+            catch (...) {
+                std::lock_guard<std::mutex> take(exceptionLock);
+                exceptionPtr = std::current_exception();
+                threadedElemIt.setFinished();
             }
+        }
 
-            TracerEvaluation fVolume;
-            computeVolume_(fVolume, tr.phaseIdx_, elemCtx, 0, /*timIdx=*/0);
-            for (int tIdx =0; tIdx < tr.numTracer(); ++tIdx) {
-                Scalar storageOfTimeIndex0 = fVolume.value()*tr.concentration_[tIdx][I];
-                Scalar localStorage = (storageOfTimeIndex0 - storageOfTimeIndex1[tIdx]) * scvVolume/dt;
-                tr.residual_[tIdx][I][0] += localStorage; //residual + flux
+        if (exceptionPtr)
+            std::rethrow_exception(exceptionPtr);
+
+        assembleWellTerms_(tr);
+    }
+
+    // assemble the storage and flux terms of a single element
+    template <class TrRe>
+    void assembleElement_(TrRe & tr, const ElementContext& elemCtx)
+    {
+        // All tracers of the batch share the matrix, and their values are stored
+        // with the tracer index as the fastest running index. The loops over the
+        // tracers below thus run over contiguous memory.
+        const int numTracer = tr.numTracer();
+
+        Scalar extrusionFactor =
+                elemCtx.intensiveQuantities(/*dofIdx=*/ 0, /*timeIdx=*/0).extrusionFactor();
+        Valgrind::CheckDefined(extrusionFactor);
+        assert(isfinite(extrusionFactor));
+        assert(extrusionFactor > 0.0);
+        Scalar scvVolume =
+                elemCtx.stencil(/*timeIdx=*/0).subControlVolume(/*dofIdx=*/ 0).volume()
+                * extrusionFactor;
+        Scalar dt = elemCtx.simulator().timeStepSize();
+
+        size_t I = elemCtx.globalSpaceIndex(/*dofIdx=*/ 0, /*timIdx=*/0);
+        size_t I1 = elemCtx.globalSpaceIndex(/*dofIdx=*/ 0, /*timIdx=*/1);
+
+        Scalar* residual = &tr.residual_[I*numTracer];
+        const Scalar* concentration = &tr.concentration_[I*numTracer];
+
+        TracerEvaluation fVolume;
+        computeVolume_(fVolume, tr.phaseIdx_, elemCtx, 0, /*timIdx=*/0);
+        if (elemCtx.enableStorageCache()) {
+            const Scalar* storageOfTimeIndex1 = &tr.storageOfTimeIndex1_[I*numTracer];
+            for (int tIdx =0; tIdx < numTracer; ++tIdx) {
+                Scalar storageOfTimeIndex0 = fVolume.value()*concentration[tIdx];
+                residual[tIdx] += (storageOfTimeIndex0 - storageOfTimeIndex1[tIdx]) * scvVolume/dt;
             }
-            (*this->tracerMatrix_)[I][I][0][0] += fVolume.derivative(0) * scvVolume/dt;
-
-            size_t numInteriorFaces = elemCtx.numInteriorFaces(/*timIdx=*/0);
-            for (unsigned scvfIdx = 0; scvfIdx < numInteriorFaces; scvfIdx++) {
-                TracerEvaluation flux;
-                const auto& face = elemCtx.stencil(0).interiorFace(scvfIdx);
-                unsigned j = face.exteriorIndex();
-                unsigned J = elemCtx.globalSpaceIndex(/*dofIdx=*/ j, /*timIdx=*/0);
-                bool isUpF;
-                computeFlux_(flux, isUpF, tr.phaseIdx_, elemCtx, scvfIdx, 0);
-                int globalUpIdx = isUpF ? I : J;
-                for (int tIdx =0; tIdx < tr.numTracer(); ++tIdx) {
-                    tr.residual_[tIdx][I][0] += flux.value()*tr.concentration_[tIdx][globalUpIdx]; //residual + flux
-                }
-                if (isUpF) {
-                    (*this->tracerMatrix_)[J][I][0][0] = -flux.derivative(0);
-                    (*this->tracerMatrix_)[I][I][0][0] += flux.derivative(0);
-                }
+        }
+        else {
+            Scalar fVolume1;
+            computeVolume_(fVolume1, tr.phaseIdx_, elemCtx, 0, /*timIdx=*/1);
+            const Scalar* concentrationInitial = &tr.concentrationInitial_[I1*numTracer];
+            for (int tIdx =0; tIdx < numTracer; ++tIdx) {
+                Scalar storageOfTimeIndex0 = fVolume.value()*concentration[tIdx];
+                Scalar storageOfTimeIndex1 = fVolume1*concentrationInitial[tIdx];
+                residual[tIdx] += (storageOfTimeIndex0 - storageOfTimeIndex1) * scvVolume/dt;
+            }
+        }
+        (*this->tracerMatrix_)[I][I][0][0] += fVolume.derivative(0) * scvVolume/dt;
+
+        size_t numInteriorFaces = elemCtx.numInteriorFaces(/*timIdx=*/0);
+        for (unsigned scvfIdx = 0; scvfIdx < numInteriorFaces; scvfIdx++) {
+            TracerEvaluation flux;
+            const auto& face = elemCtx.stencil(0).interiorFace(scvfIdx);
+            unsigned j = face.exteriorIndex();
+            unsigned J = elemCtx.globalSpaceIndex(/*dofIdx=*/ j, /*timIdx=*/0);
+            bool isUpF;
+            computeFlux_(flux, isUpF, tr.phaseIdx_, elemCtx, scvfIdx, 0);
+            int globalUpIdx = isUpF ? I : J;
+            const Scalar* upConcentration = &tr.concentration_[globalUpIdx*numTracer];
+            for (int tIdx =0; tIdx < numTracer; ++tIdx) {
+                residual[tIdx] += flux.value()*upConcentration[tIdx]; //residual + flux
+            }
+            if (isUpF) {
+                (*this->tracerMatrix_)[J][I][0][0] = -flux.derivative(0);
+                (*this->tracerMatrix_)[I][I][0][0] += flux.derivative(0);
             }
-
         }
+    }
 
-        // Wells  terms
+    template <class TrRe>
+    void assembleWellTerms_(TrRe & tr)
+    {
+        const int numTracer = tr.numTracer();
         const int episodeIdx = simulator_.episodeIndex();
         const auto& wells = simulator_.vanguard().schedule().getWells(episodeIdx);
         for (const auto& well : wells) {
 
-            for (int tIdx =0; tIdx < tr.numTracer(); ++tIdx) {
+            for (int tIdx =0; tIdx < numTracer; ++tIdx) {
                 this->wellTracerRate_[std::make_pair(well.name(),this->tracerNames_[tr.idx_[tIdx]])] = 0.0;
             }
 
-            if (well.getStatus() == Well::Status::SHUT)
+            // wells of other processes are handled there
+            if (well.getStatus() == Well::Status::SHUT || !simulator_.problem().wellModel().hasWell(well.name()))
                 continue;
 
-            double wtracer[tr.numTracer()];
-            for (int tIdx =0; tIdx < tr.numTracer(); ++tIdx) {
+            std::vector<double> wtracer(numTracer);
+            for (int tIdx =0; tIdx < numTracer; ++tIdx) {
                 wtracer[tIdx] = well.getTracerProperties().getConcentration(this->tracerNames_[tr.idx_[tIdx]]);
             }
 
@@ -318,17 +376,22 @@ protected:
                 cartesianCoordinate[2] = connection.getK();
                 const size_t cartIdx = simulator_.vanguard().cartesianIndex(cartesianCoordinate);
                 const int I = this->cartToGlobal_[cartIdx];
+                if (I < 0)
+                    continue;
+
                 Scalar rate = simulator_.problem().wellModel().well(well.name())->volumetricSurfaceRateForConnection(I, tr.phaseIdx_);
+                Scalar* residual = &tr.residual_[I*numTracer];
                 if (rate > 0) {
-                    for (int tIdx =0; tIdx < tr.numTracer(); ++tIdx) {
-                        tr.residual_[tIdx][I][0] -= rate*wtracer[tIdx];
+                    for (int tIdx =0; tIdx < numTracer; ++tIdx) {
+                        residual[tIdx] -= rate*wtracer[tIdx];
                         // Store _injector_ tracer rate for reporting
                         this->wellTracerRate_.at(std::make_pair(well.name(),this->tracerNames_[tr.idx_[tIdx]])) += rate*wtracer[tIdx];
                     }
                 }
                 else if (rate < 0) {
-                    for (int tIdx =0; tIdx < tr.numTracer(); ++tIdx) {
-                        tr.residual_[tIdx][I][0] -= rate*tr.concentration_[tIdx][I];
+                    const Scalar* concentration = &tr.concentration_[I*numTracer];
+                    for (int tIdx =0; tIdx < numTracer; ++tIdx) {
+                        residual[tIdx] -= rate*concentration[tIdx];
                     }
                     (*this->tracerMatrix_)[I][I][0][0] -= rate*variable<TracerEvaluation>(1.0, 0).derivative(0);
                 }
@@ -344,18 +407,37 @@ protected:
 
         tr.concentrationInitial_ = tr.concentration_;
 
-        ElementContext elemCtx(simulator_);
-        auto elemIt = simulator_.gridView().template begin</*codim=*/0>();
-        auto elemEndIt = simulator_.gridView().template end</*codim=*/0>();
-        for (; elemIt != elemEndIt; ++ elemIt) {
-            elemCtx.updateAll(*elemIt);
-            int globalDofIdx = elemCtx.globalSpaceIndex(0, /*timIdx=*/0);
-            Scalar fVolume;
-            computeVolume_(fVolume, tr.phaseIdx_, elemCtx, 0, /*timIdx=*/0);
-            for (int tIdx =0; tIdx < tr.numTracer(); ++tIdx) {
-                tr.storageOfTimeIndex1_[tIdx][globalDofIdx] = fVolume*tr.concentrationInitial_[tIdx][globalDofIdx];
+        const int numTracer = tr.numTracer();
+        std::mutex exceptionLock;
+        std::exception_ptr exceptionPtr = nullptr;
+        ThreadedEntityIterator<GridView, /*codim=*/0> threadedElemIt(simulator_.gridView());
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            ElementContext elemCtx(simulator_);
+            auto elemIt = threadedElemIt.beginParallel();
+            try {
+                for (; !threadedElemIt.isFinished(elemIt); elemIt = threadedElemIt.increment()) {
+                    elemCtx.updateAll(*elemIt);
+                    int globalDofIdx = elemCtx.globalSpaceIndex(0, /*timIdx=*/0);
+                    Scalar fVolume;
+                    computeVolume_(fVolume, tr.phaseIdx_, elemCtx, 0, /*timIdx=*/0);
+                    const size_t offset = globalDofIdx*numTracer;
+                    for (int tIdx =0; tIdx < numTracer; ++tIdx) {
+                        tr.storageOfTimeIndex1_[offset + tIdx] = fVolume*tr.concentrationInitial_[offset + tIdx];
+                    }
+                }
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> take(exceptionLock);
+                exceptionPtr = std::current_exception();
+                threadedElemIt.setFinished();
             }
         }
+
+        if (exceptionPtr)
+            std::rethrow_exception(exceptionPtr);
     }
 
     template <class TrRe>
@@ -366,28 +448,29 @@ protected:
 
         // Note that we solve for a concentration update (compared to previous time step)
         // Confer also assembleTracerEquations_(...) above.
-        std::vector<TracerVector> dx(tr.concentration_);
-        for (int tIdx =0; tIdx < tr.numTracer(); ++tIdx)
-            dx[tIdx] = 0.0;
+        const int numTracer = tr.numTracer();
+        std::vector<Scalar> dx(tr.concentration_.size(), 0.0);
 
         assembleTracerEquations_(tr);
+        this->makeOverlapRowsInvalid_(*this->tracerMatrix_, tr.residual_, numTracer);
 
-        bool converged = this->linearSolveBatchwise_(*this->tracerMatrix_, dx, tr.residual_);
-        if (!converged)
+        bool converged = this->linearSolveInterleaved_(*this->tracerMatrix_, dx, tr.residual_, numTracer);
+        if (!converged && simulator_.gridView().comm().rank() == 0)
             std::cout << "### Tracer model: Warning, linear solver did not converge. ###" << std::endl;
 
-        for (int tIdx =0; tIdx < tr.numTracer(); ++tIdx) {
-            tr.concentration_[tIdx] -= dx[tIdx];
-            // Tracer concentrations for restart report
-            this->tracerConcentration_[tr.idx_[tIdx]] = tr.concentration_[tIdx];
-        }
+        for (size_t i = 0; i < dx.size(); ++i)
+            tr.concentration_[i] -= dx[i];
+
+        // Tracer concentrations for restart report
+        for (int tIdx =0; tIdx < numTracer; ++tIdx)
+            tr.getConcentration(tIdx, this->tracerConcentration_[tr.idx_[tIdx]]);
 
         // Store _producer_ tracer rate for reporting
         const int episodeIdx = simulator_.episodeIndex();
         const auto& wells = simulator_.vanguard().schedule().getWells(episodeIdx);
         for (const auto& well : wells) {
 
-            if (well.getStatus() == Well::Status::SHUT)
+            if (well.getStatus() == Well::Status::SHUT || !simulator_.problem().wellModel().hasWell(well.name()))
                 continue;
 
             std::array<int, 3> cartesianCoordinate;
@@ -401,10 +484,13 @@ protected:
                 cartesianCoordinate[2] = connection.getK();
                 const size_t cartIdx = simulator_.vanguard().cartesianIndex(cartesianCoordinate);
                 const int I = this->cartToGlobal_[cartIdx];
+                if (I < 0)
+                    continue;
+
                 Scalar rate = simulator_.problem().wellModel().well(well.name())->volumetricSurfaceRateForConnection(I, tr.phaseIdx_);
                 if (rate < 0 && well.isProducer()) { //Injection rates already reported during assembly
-                    for (int tIdx =0; tIdx < tr.numTracer(); ++tIdx) {
-                        this->wellTracerRate_.at(std::make_pair(well.name(),this->tracerNames_[tr.idx_[tIdx]])) += rate*tr.concentration_[tIdx][I];
+                    for (int tIdx =0; tIdx < numTracer; ++tIdx) {
+                        this->wellTracerRate_.at(std::make_pair(well.name(),this->tracerNames_[tr.idx_[tIdx]])) += rate*tr.concentration_[I*numTracer + tIdx];
                     }
                 }
             }
@@ -454,14 +540,17 @@ protected:
     // is active, the template argument is intended to support future extension to these 
     // scenarios by supplying an extended vector type.
  
+    // The values of all tracers of a batch are stored in one array each, with the
+    // tracer index as the fastest running index: the value of tracer tIdx in
+    // degree of freedom dofIdx is located at dofIdx*numTracer() + tIdx.
     template <typename TV>
     struct TracerBatch {
       std::vector<int> idx_;
       const int phaseIdx_;
-      std::vector<TV> concentrationInitial_;
-      std::vector<TV> concentration_;
-      std::vector<TV> storageOfTimeIndex1_;
-      std::vector<TV> residual_;
+      std::vector<Scalar> concentrationInitial_;
+      std::vector<Scalar> concentration_;
+      std::vector<Scalar> storageOfTimeIndex1_;
+      std::vector<Scalar> residual_;
 
       TracerBatch(int phaseIdx) : phaseIdx_(phaseIdx) {}
 
@@ -469,12 +558,36 @@ protected:
 
       void addTracer(const int idx, const TV & concentration)
       {
-          int numGridDof = concentration.size();
+          const size_t numGridDof = concentration.size();
+          const size_t oldNumTracer = numTracer();
           idx_.emplace_back(idx);
-          concentrationInitial_.emplace_back(concentration);
-          concentration_.emplace_back(concentration);
-          storageOfTimeIndex1_.emplace_back(numGridDof);
-          residual_.emplace_back(numGridDof);
+          const size_t newNumTracer = numTracer();
+
+          std::vector<Scalar> newConcentration(numGridDof*newNumTracer);
+          for (size_t dofIdx = 0; dofIdx < numGridDof; ++dofIdx) {
+              for (size_t tIdx = 0; tIdx < oldNumTracer; ++tIdx)
+                  newConcentration[dofIdx*newNumTracer + tIdx] = concentration_[dofIdx*oldNumTracer + tIdx];
+              newConcentration[dofIdx*newNumTracer + oldNumTracer] = concentration[dofIdx];
+          }
+
+          concentrationInitial_ = newConcentration;
+          concentration_ = std::move(newConcentration);
+          storageOfTimeIndex1_.assign(numGridDof*newNumTracer, 0.0);
+          residual_.assign(numGridDof*newNumTracer, 0.0);
+      }
+
+      void setConcentration(const int tIdx, const TV & concentration)
+      {
+          const int num = numTracer();
+          for (size_t dofIdx = 0; dofIdx < concentration.size(); ++dofIdx)
+              concentration_[dofIdx*num + tIdx] = concentration[dofIdx];
+      }
+
+      void getConcentration(const int tIdx, TV & concentration) const
+      {
+          const int num = numTracer();
+          for (size_t dofIdx = 0; dofIdx < concentration.size(); ++dofIdx)
+              concentration[dofIdx] = concentration_[dofIdx*num + tIdx];
       }
     };
 
@@ -0,0 +1,350 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/**
+ * \file
+ *
+ * \copydoc Opm::EclTracerSweepSolver
+ */
+#ifndef EWOMS_ECL_TRACER_SWEEP_SOLVER_HH
+#define EWOMS_ECL_TRACER_SWEEP_SOLVER_HH
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace Opm {
+
+/*!
+ * \brief Direct solver for the linear systems of the tracer model.
+ *
+ * With single point upwinding, the equation of a cell only depends on the
+ * cell itself and on its upstream neighbors. Ordering the cells along the
+ * flow thus makes the system matrix block triangular, where the diagonal
+ * blocks are the strongly connected components of the upwind graph. Most of
+ * them consist of a single cell; larger ones only show up where the flow
+ * field contains cycles.
+ *
+ * update() determines the components using Tarjan's algorithm. solve() then
+ * visits them in topological order, i.e. upstream first, and solves each
+ * block exactly. All right hand sides are treated in the same sweep; they are
+ * stored interleaved, i.e. with the index of the right hand side as the
+ * fastest running index, so the innermost loops run over contiguous memory.
+ *
+ * The matrix type is expected to provide the interface of a Dune::BCRSMatrix
+ * with 1x1 blocks.
+ */
+template <class Scalar>
+class EclTracerSweepSolver
+{
+public:
+    /*!
+     * \brief Create a solver.
+     *
+     * \param maxBlockSize The largest strongly connected component which is
+     *                     solved by dense Gaussian elimination.
+     */
+    explicit EclTracerSweepSolver(std::size_t maxBlockSize = 200)
+        : maxBlockSize_(maxBlockSize)
+    {}
+
+    /*!
+     * \brief Compute the solve order for the non-zero pattern of a matrix.
+     *
+     * Returns false if the matrix contains a strongly connected component
+     * with more than maxBlockSize cells. In this case, the system should be
+     * handed to an iterative solver instead.
+     */
+    template <class Matrix>
+    bool update(const Matrix& M)
+    {
+        const std::size_t n = M.N();
+
+        // the upwind graph: an edge from a cell to every cell its equation
+        // depends on. explicit zeros in the sparsity pattern are ignored.
+        adjStart_.assign(n + 1, 0);
+        adj_.clear();
+        for (std::size_t rowIdx = 0; rowIdx < n; ++rowIdx) {
+            const auto& row = M[rowIdx];
+            for (auto colIt = row.begin(); colIt != row.end(); ++colIt) {
+                const std::size_t colIdx = colIt.index();
+                if (colIdx != rowIdx && (*colIt)[0][0] != 0.0)
+                    adj_.push_back(colIdx);
+            }
+            adjStart_[rowIdx + 1] = adj_.size();
+        }
+
+        computeComponents_(n);
+
+        maxComponentSize_ = 0;
+        for (std::size_t compIdx = 0; compIdx + 1 < compStart_.size(); ++compIdx)
+            maxComponentSize_ = std::max(maxComponentSize_,
+                                         compStart_[compIdx + 1] - compStart_[compIdx]);
+
+        return maxComponentSize_ <= maxBlockSize_;
+    }
+
+    /*!
+     * \brief Solve M X = B for numRhs right hand sides at once.
+     *
+     * Entry (i, k) of X and B is stored at i*numRhs + k. update() must have
+     * been called for the sparsity pattern of M. Returns false if one of the
+     * diagonal blocks is singular.
+     */
+    template <class Matrix>
+    bool solve(const Matrix& M,
+               std::vector<Scalar>& x,
+               const std::vector<Scalar>& b,
+               std::size_t numRhs)
+    {
+        localIdx_.assign(M.N(), -1);
+
+        for (std::size_t compIdx = 0; compIdx + 1 < compStart_.size(); ++compIdx) {
+            const std::size_t begin = compStart_[compIdx];
+            const std::size_t end = compStart_[compIdx + 1];
+
+            if (end - begin == 1) {
+                // the common case: all upstream values are known already
+                const std::size_t rowIdx = order_[begin];
+                Scalar diag = 0.0;
+                Scalar* xRow = &x[rowIdx*numRhs];
+                const Scalar* bRow = &b[rowIdx*numRhs];
+                for (std::size_t rhsIdx = 0; rhsIdx < numRhs; ++rhsIdx)
+                    xRow[rhsIdx] = bRow[rhsIdx];
+
+                const auto& row = M[rowIdx];
+                for (auto colIt = row.begin(); colIt != row.end(); ++colIt) {
+                    const std::size_t colIdx = colIt.index();
+                    const Scalar value = (*colIt)[0][0];
+                    if (colIdx == rowIdx)
+                        diag = value;
+                    else if (value != 0.0) {
+                        const Scalar* xCol = &x[colIdx*numRhs];
+                        for (std::size_t rhsIdx = 0; rhsIdx < numRhs; ++rhsIdx)
+                            xRow[rhsIdx] -= value*xCol[rhsIdx];
+                    }
+                }
+
+                if (diag == 0.0)
+                    return false;
+
+                for (std::size_t rhsIdx = 0; rhsIdx < numRhs; ++rhsIdx)
+                    xRow[rhsIdx] /= diag;
+            }
+            else if (!solveBlock_(M, x, b, numRhs, begin, end))
+                return false;
+        }
+
+        return true;
+    }
+
+    /*!
+     * \brief The number of cells of the largest strongly connected component
+     *        found by the last call to update().
+     */
+    std::size_t maxComponentSize() const
+    { return maxComponentSize_; }
+
+    /*!
+     * \brief The number of strongly connected components found by the last
+     *        call to update().
+     */
+    std::size_t numComponents() const
+    { return compStart_.empty() ? 0 : compStart_.size() - 1; }
+
+private:
+    // Tarjan's algorithm. Components are emitted once everything reachable
+    // from them has been emitted, which is exactly the order in which they
+    // have to be solved. The depth first search is done with an explicit
+    // stack since the upwind graph of a large model is far too deep for
+    // recursion.
+    void computeComponents_(std::size_t n)
+    {
+        constexpr std::size_t unvisited = static_cast<std::size_t>(-1);
+
+        order_.clear();
+        order_.reserve(n);
+        compStart_.assign(1, 0);
+
+        std::vector<std::size_t> index(n, unvisited);
+        std::vector<std::size_t> lowLink(n, 0);
+        std::vector<bool> onStack(n, false);
+        std::vector<std::size_t> stack;
+        std::vector<std::pair<std::size_t, std::size_t>> callStack;
+        std::size_t nextIndex = 0;
+
+        for (std::size_t startIdx = 0; startIdx < n; ++startIdx) {
+            if (index[startIdx] != unvisited)
+                continue;
+
+            index[startIdx] = lowLink[startIdx] = nextIndex++;
+            stack.push_back(startIdx);
+            onStack[startIdx] = true;
+            callStack.emplace_back(startIdx, adjStart_[startIdx]);
+
+            while (!callStack.empty()) {
+                const std::size_t cellIdx = callStack.back().first;
+                std::size_t& edgeIdx = callStack.back().second;
+
+                if (edgeIdx < adjStart_[cellIdx + 1]) {
+                    const std::size_t nbIdx = adj_[edgeIdx++];
+                    if (index[nbIdx] == unvisited) {
+                        index[nbIdx] = lowLink[nbIdx] = nextIndex++;
+                        stack.push_back(nbIdx);
+                        onStack[nbIdx] = true;
+                        callStack.emplace_back(nbIdx, adjStart_[nbIdx]);
+                    }
+                    else if (onStack[nbIdx])
+                        lowLink[cellIdx] = std::min(lowLink[cellIdx], index[nbIdx]);
+                    continue;
+                }
+
+                // all neighbors are done. if the cell is the root of a
+                // component, the component is on top of the stack.
+                if (lowLink[cellIdx] == index[cellIdx]) {
+                    std::size_t memberIdx;
+                    do {
+                        memberIdx = stack.back();
+                        stack.pop_back();
+                        onStack[memberIdx] = false;
+                        order_.push_back(memberIdx);
+                    } while (memberIdx != cellIdx);
+                    compStart_.push_back(order_.size());
+                }
+
+                callStack.pop_back();
+                if (!callStack.empty()) {
+                    const std::size_t parentIdx = callStack.back().first;
+                    lowLink[parentIdx] = std::min(lowLink[parentIdx], lowLink[cellIdx]);
+                }
+            }
+        }
+    }
+
+    // solve the equations of a cycle with Gaussian elimination. the values of
+    // the cells outside of the component are either upstream and thus known,
+    // or downstream and thus do not appear in these equations.
+    template <class Matrix>
+    bool solveBlock_(const Matrix& M,
+                     std::vector<Scalar>& x,
+                     const std::vector<Scalar>& b,
+                     std::size_t numRhs,
+                     std::size_t begin,
+                     std::size_t end)
+    {
+        const std::size_t size = end - begin;
+
+        for (std::size_t i = 0; i < size; ++i)
+            localIdx_[order_[begin + i]] = static_cast<long>(i);
+
+        block_.assign(size*size, 0.0);
+        rhs_.resize(size*numRhs);
+        for (std::size_t i = 0; i < size; ++i) {
+            const std::size_t rowIdx = order_[begin + i];
+            for (std::size_t rhsIdx = 0; rhsIdx < numRhs; ++rhsIdx)
+                rhs_[i*numRhs + rhsIdx] = b[rowIdx*numRhs + rhsIdx];
+
+            const auto& row = M[rowIdx];
+            for (auto colIt = row.begin(); colIt != row.end(); ++colIt) {
+                const std::size_t colIdx = colIt.index();
+                const Scalar value = (*colIt)[0][0];
+                if (localIdx_[colIdx] >= 0)
+                    block_[i*size + localIdx_[colIdx]] += value;
+                else if (value != 0.0) {
+                    for (std::size_t rhsIdx = 0; rhsIdx < numRhs; ++rhsIdx)
+                        rhs_[i*numRhs + rhsIdx] -= value*x[colIdx*numRhs + rhsIdx];
+                }
+            }
+        }
+
+        for (std::size_t i = 0; i < size; ++i)
+            localIdx_[order_[begin + i]] = -1;
+
+        // forward elimination with partial pivoting
+        for (std::size_t k = 0; k < size; ++k) {
+            std::size_t pivot = k;
+            for (std::size_t i = k + 1; i < size; ++i)
+                if (std::abs(block_[i*size + k]) > std::abs(block_[pivot*size + k]))
+                    pivot = i;
+
+            if (block_[pivot*size + k] == 0.0)
+                return false;
+
+            if (pivot != k) {
+                for (std::size_t j = 0; j < size; ++j)
+                    std::swap(block_[k*size + j], block_[pivot*size + j]);
+                for (std::size_t rhsIdx = 0; rhsIdx < numRhs; ++rhsIdx)
+                    std::swap(rhs_[k*numRhs + rhsIdx], rhs_[pivot*numRhs + rhsIdx]);
+            }
+
+            for (std::size_t i = k + 1; i < size; ++i) {
+                const Scalar factor = block_[i*size + k]/block_[k*size + k];
+                if (factor == 0.0)
+                    continue;
+                for (std::size_t j = k; j < size; ++j)
+                    block_[i*size + j] -= factor*block_[k*size + j];
+                for (std::size_t rhsIdx = 0; rhsIdx < numRhs; ++rhsIdx)
+                    rhs_[i*numRhs + rhsIdx] -= factor*rhs_[k*numRhs + rhsIdx];
+            }
+        }
+
+        // back substitution
+        for (std::size_t k = size; k-- > 0;) {
+            for (std::size_t rhsIdx = 0; rhsIdx < numRhs; ++rhsIdx) {
+                Scalar value = rhs_[k*numRhs + rhsIdx];
+                for (std::size_t j = k + 1; j < size; ++j)
+                    value -= block_[k*size + j]*rhs_[j*numRhs + rhsIdx];
+                rhs_[k*numRhs + rhsIdx] = value/block_[k*size + k];
+            }
+        }
+
+        for (std::size_t i = 0; i < size; ++i) {
+            const std::size_t rowIdx = order_[begin + i];
+            for (std::size_t rhsIdx = 0; rhsIdx < numRhs; ++rhsIdx)
+                x[rowIdx*numRhs + rhsIdx] = rhs_[i*numRhs + rhsIdx];
+        }
+
+        return true;
+    }
+
+    std::size_t maxBlockSize_;
+    std::size_t maxComponentSize_ = 0;
+
+    // the upwind graph in compressed row format
+    std::vector<std::size_t> adjStart_;
+    std::vector<std::size_t> adj_;
+
+    // the cells in solve order and the start of each component therein
+    std::vector<std::size_t> order_;
+    std::vector<std::size_t> compStart_;
+
+    // scratch space of solve()
+    std::vector<long> localIdx_;
+    std::vector<Scalar> block_;
+    std::vector<Scalar> rhs_;
+};
+
+} // namespace Opm
+
+#endif
@@ -44,11 +44,20 @@
 
 #include <fmt/format.h>
 
+#include <opm/models/parallel/threadedentityiterator.hh>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <exception>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
+#include <string>
 
 namespace {
 
@@ -107,6 +116,7 @@ template<class Grid, class GridView, class ElementMapper, class Scalar>
 Scalar EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
 transmissibility(unsigned elemIdx1, unsigned elemIdx2) const
 {
+    checkInteriorAvailable_("transmissibility()");
     return trans_.at(isId(elemIdx1, elemIdx2));
 }
 
@@ -121,6 +131,7 @@ template<class Grid, class GridView, class ElementMapper, class Scalar>
 Scalar EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
 thermalHalfTrans(unsigned insideElemIdx, unsigned outsideElemIdx) const
 {
+    checkInteriorAvailable_("thermalHalfTrans()");
     return thermalHalfTrans_.at(directionalIsId(insideElemIdx, outsideElemIdx));
 }
 
@@ -135,6 +146,7 @@ template<class Grid, class GridView, class ElementMapper, class Scalar>
 Scalar EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
 diffusivity(unsigned elemIdx1, unsigned elemIdx2) const
 {
+    checkInteriorAvailable_("diffusivity()");
     if (diffusivity_.empty())
         return 0.0;
 
@@ -142,10 +154,34 @@ diffusivity(unsigned elemIdx1, unsigned elemIdx2) const
 
 }
 
+template<class Grid, class GridView, class ElementMapper, class Scalar>
+void EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
+releaseInteriorTransmissibilities()
+{
+    // swap with empty maps, clear() would keep the bucket arrays
+    std::unordered_map<std::uint64_t, Scalar>().swap(trans_);
+    std::unordered_map<std::uint64_t, Scalar>().swap(thermalHalfTrans_);
+    std::unordered_map<std::uint64_t, Scalar>().swap(diffusivity_);
+    interiorReleased_ = true;
+}
+
+template<class Grid, class GridView, class ElementMapper, class Scalar>
+void EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
+checkInteriorAvailable_(const char* accessor) const
+{
+    // the per-face maps are empty after the release, so a lookup would throw
+    // std::out_of_range without saying why
+    if (interiorReleased_)
+        throw std::logic_error(std::string("EclTransmissibility::") + accessor
+                               + " was called after the interior transmissibilities were released."
+                               " Use the per-connection data of the problem instead.");
+}
+
 template<class Grid, class GridView, class ElementMapper, class Scalar>
 void EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
 update(bool global)
 {
+    interiorReleased_ = false;
     const auto& cartDims = cartMapper_.cartesianDimensions();
     auto& transMult = eclState_.getTransMult();
     const auto& comm = gridView_.comm();
@@ -164,52 +200,54 @@ update(bool global)
     for (unsigned dimIdx = 0; dimIdx < dimWorld; ++dimIdx)
         axisCentroids[dimIdx].resize(numElements);
 
+    // compute the axis specific "centroids" used for the transmissibilities. for
+    // consistency with the flow simulator, we use the element centers as
+    // computed by opm-parser's Opm::EclipseGrid class for all axes.
     auto elemIt = gridView_.template begin</*codim=*/ 0>();
     const auto& elemEndIt = gridView_.template end</*codim=*/ 0>();
-    size_t centroidIdx = 0;
-    for (; elemIt != elemEndIt; ++elemIt, ++centroidIdx) {
-        const auto& elem = *elemIt;
-        unsigned elemIdx = elemMapper.index(elem);
-
-        // compute the axis specific "centroids" used for the transmissibilities. for
-        // consistency with the flow simulator, we use the element centers as
-        // computed by opm-parser's Opm::EclipseGrid class for all axes.
-        std::array<double, 3> centroid;
-        if (gridView_.comm().rank() == 0) {
-            const auto& eclGrid = eclState_.getInputGrid();
+    if (gridView_.comm().rank() == 0) {
+        // computing the cell centers from the corner point geometry is expensive
+        // for large grids, but the cells are independent of each other.
+        const auto& eclGrid = eclState_.getInputGrid();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (int elemIdx = 0; elemIdx < static_cast<int>(numElements); ++elemIdx) {
             unsigned cartesianCellIdx = cartMapper_.cartesianIndex(elemIdx);
-            centroid = eclGrid.getCellCenter(cartesianCellIdx);
-        } else
+            const std::array<double, 3> centroid = eclGrid.getCellCenter(cartesianCellIdx);
+
+            for (unsigned axisIdx = 0; axisIdx < dimWorld; ++axisIdx)
+                for (unsigned dimIdx = 0; dimIdx < dimWorld; ++dimIdx)
+                    axisCentroids[axisIdx][elemIdx][dimIdx] = centroid[dimIdx];
+        }
+    }
+    else {
+        size_t centroidIdx = 0;
+        for (; elemIt != elemEndIt; ++elemIt, ++centroidIdx) {
+            const auto& elem = *elemIt;
+            unsigned elemIdx = elemMapper.index(elem);
+
+            std::array<double, 3> centroid;
             std::copy(centroids_.begin() + centroidIdx * dimWorld,
                       centroids_.begin() + (centroidIdx + 1) * dimWorld,
                       centroid.begin());
 
-        for (unsigned axisIdx = 0; axisIdx < dimWorld; ++axisIdx)
-            for (unsigned dimIdx = 0; dimIdx < dimWorld; ++dimIdx)
-                axisCentroids[axisIdx][elemIdx][dimIdx] = centroid[dimIdx];
+            for (unsigned axisIdx = 0; axisIdx < dimWorld; ++axisIdx)
+                for (unsigned dimIdx = 0; dimIdx < dimWorld; ++dimIdx)
+                    axisCentroids[axisIdx][elemIdx][dimIdx] = centroid[dimIdx];
+        }
     }
 
-    // reserving some space in the hashmap upfront saves quite a bit of time because
-    // resizes are costly for hashmaps and there would be quite a few of them if we
-    // would not have a rough idea of how large the final map will be (the rough idea
-    // is a conforming Cartesian grid).
     trans_.clear();
-    trans_.reserve(numElements*3*1.05);
-
     transBoundary_.clear();
 
-    // if energy is enabled, let's do the same for the "thermal half transmissibilities"
     if (enableEnergy_) {
         thermalHalfTrans_.clear();
-        thermalHalfTrans_.reserve(numElements*6*1.05);
-
         thermalHalfTransBoundary_.clear();
     }
 
-    // if diffusion is enabled, let's do the same for the "diffusivity"
     if (updateDiffusivity) {
         diffusivity_.clear();
-        diffusivity_.reserve(numElements*3*1.05);
         extractPorosity_();
     }
 
@@ -225,270 +263,355 @@ update(bool global)
         comm.broadcast(&useSmallestMultiplier, 1, 0);
     }
 
-    // compute the transmissibilities for all intersections
-    elemIt = gridView_.template begin</*codim=*/ 0>();
-    for (; elemIt != elemEndIt; ++elemIt) {
-        const auto& elem = *elemIt;
-        unsigned elemIdx = elemMapper.index(elem);
-
-        auto isIt = gridView_.ibegin(elem);
-        const auto& isEndIt = gridView_.iend(elem);
-        unsigned boundaryIsIdx = 0;
-        for (; isIt != isEndIt; ++ isIt) {
-            // store intersection, this might be costly
-            const auto& intersection = *isIt;
-
-            // deal with grid boundaries
-            if (intersection.boundary()) {
-                // compute the transmissibilty for the boundary intersection
-                const auto& geometry = intersection.geometry();
-                const auto& faceCenterInside = geometry.center();
-
-                auto faceAreaNormal = intersection.centerUnitOuterNormal();
-                faceAreaNormal *= geometry.volume();
-
-                Scalar transBoundaryIs;
-                computeHalfTrans_(transBoundaryIs,
-                                  faceAreaNormal,
-                                  intersection.indexInInside(),
-                                  distanceVector_(faceCenterInside,
-                                                  intersection.indexInInside(),
-                                                  elemIdx,
-                                                  axisCentroids),
-                                  permeability_[elemIdx]);
-
-                // normally there would be two half-transmissibilities that would be
-                // averaged. on the grid boundary there only is the half
-                // transmissibility of the interior element.
-                transBoundary_[std::make_pair(elemIdx, boundaryIsIdx)] = transBoundaryIs;
-
-                // for boundary intersections we also need to compute the thermal
-                // half transmissibilities
-                if (enableEnergy_) {
-                    Scalar transBoundaryEnergyIs;
-                    computeHalfDiffusivity_(transBoundaryEnergyIs,
-                                            faceAreaNormal,
-                                            distanceVector_(faceCenterInside,
-                                                            intersection.indexInInside(),
-                                                            elemIdx,
-                                                            axisCentroids),
-                                            1.0);
-                    thermalHalfTransBoundary_[std::make_pair(elemIdx, boundaryIsIdx)] =
-                        transBoundaryEnergyIs;
-                }
-
-                ++ boundaryIsIdx;
-                continue;
+    // compute the transmissibilities for all intersections. the elements are
+    // processed by all threads at once and every thread collects its results in
+    // its own buffers, which are moved into the maps afterwards.
+#ifdef _OPENMP
+    const int numThreads = omp_get_max_threads();
+#else
+    const int numThreads = 1;
+#endif
+    std::vector<FaceBuffers_> faceBuffers(numThreads);
+    std::mutex exceptionLock;
+    std::exception_ptr exceptionPtr = nullptr;
+    ThreadedEntityIterator<GridView, /*codim=*/0> threadedElemIt(gridView_);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+#ifdef _OPENMP
+        FaceBuffers_& buffers = faceBuffers[omp_get_thread_num()];
+#else
+        FaceBuffers_& buffers = faceBuffers[0];
+#endif
+        auto threadElemIt = threadedElemIt.beginParallel();
+        try {
+            for (; !threadedElemIt.isFinished(threadElemIt); threadElemIt = threadedElemIt.increment()) {
+                computeElementFaces_(*threadElemIt, elemMapper, axisCentroids, ntg, transMult,
+                                     cartDims, useSmallestMultiplier, updateDiffusivity, buffers);
             }
+        }
+        // exceptions must not escape the parallel block, so remember the exception
+        // and rethrow it once all threads are done.
+        catch (...) {
+            std::lock_guard<std::mutex> take(exceptionLock);
+            exceptionPtr = std::current_exception();
+            threadedElemIt.setFinished();
+        }
+    }
 
-            if (!intersection.neighbor()) {
-                // elements can be on process boundaries, i.e. they are not on the
-                // domain boundary yet they don't have neighbors.
-                ++ boundaryIsIdx;
-                continue;
-            }
+    if (exceptionPtr)
+        std::rethrow_exception(exceptionPtr);
 
-            const auto& outsideElem = intersection.outside();
-            unsigned outsideElemIdx = elemMapper.index(outsideElem);
+    mergeFaceBuffers_(faceBuffers);
 
-            unsigned insideCartElemIdx = cartMapper_.cartesianIndex(elemIdx);
-            unsigned outsideCartElemIdx = cartMapper_.cartesianIndex(outsideElemIdx);
+    // potentially overwrite and/or modify  transmissibilities based on input from deck
+    updateFromEclState_(global);
 
-            // we only need to calculate a face's transmissibility
-            // once...
-            if (insideCartElemIdx > outsideCartElemIdx)
-                continue;
+    // Create mapping from global to local index
+    const size_t cartesianSize = cartMapper_.cartesianSize();
+    // reserve memory
+    std::vector<int> globalToLocal(cartesianSize, -1);
 
-            // local indices of the faces of the inside and
-            // outside elements which contain the intersection
-            int insideFaceIdx  = intersection.indexInInside();
-            int outsideFaceIdx = intersection.indexInOutside();
+    // loop over all elements (global grid) and store Cartesian index
+    elemIt = grid_.leafGridView().template begin<0>();
 
-            if (insideFaceIdx == -1) {
-                // NNC. Set zero transmissibility, as it will be
-                // *added to* by applyNncToGridTrans_() later.
-                assert(outsideFaceIdx == -1);
-                trans_[isId(elemIdx, outsideElemIdx)] = 0.0;
-                continue;
-            }
+    for (; elemIt != elemEndIt; ++elemIt) {
+        int elemIdx = elemMapper.index(*elemIt);
+        int cartElemIdx = cartMapper_.cartesianIndex(elemIdx);
+        globalToLocal[cartElemIdx] = elemIdx;
+    }
+    applyEditNncToGridTrans_(globalToLocal);
+    applyNncToGridTrans_(globalToLocal);
+
+    //remove very small non-neighbouring transmissibilities
+    removeSmallNonCartesianTransmissibilities_();
+}
 
-            DimVector faceCenterInside;
-            DimVector faceCenterOutside;
-            DimVector faceAreaNormal;
-
-            typename std::is_same<Grid, Dune::CpGrid>::type isCpGrid;
-            computeFaceProperties(intersection,
-                                  elemIdx,
-                                  insideFaceIdx,
-                                  outsideElemIdx,
-                                  outsideFaceIdx,
-                                  faceCenterInside,
-                                  faceCenterOutside,
-                                  faceAreaNormal,
-                                  isCpGrid);
-
-            Scalar halfTrans1;
-            Scalar halfTrans2;
-
-            computeHalfTrans_(halfTrans1,
+template<class Grid, class GridView, class ElementMapper, class Scalar>
+void EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
+computeElementFaces_(const Element& elem,
+                     const ElementMapper& elemMapper,
+                     const std::array<std::vector<DimVector>, dimWorld>& axisCentroids,
+                     const std::vector<double>& ntg,
+                     const TransMult& transMult,
+                     const std::array<int, dimWorld>& cartDims,
+                     bool useSmallestMultiplier,
+                     bool updateDiffusivity,
+                     FaceBuffers_& buffers)
+{
+    unsigned elemIdx = elemMapper.index(elem);
+
+    auto isIt = gridView_.ibegin(elem);
+    const auto& isEndIt = gridView_.iend(elem);
+    unsigned boundaryIsIdx = 0;
+    for (; isIt != isEndIt; ++ isIt) {
+        // store intersection, this might be costly
+        const auto& intersection = *isIt;
+
+        // deal with grid boundaries
+        if (intersection.boundary()) {
+            // compute the transmissibilty for the boundary intersection
+            const auto& geometry = intersection.geometry();
+            const auto& faceCenterInside = geometry.center();
+
+            auto faceAreaNormal = intersection.centerUnitOuterNormal();
+            faceAreaNormal *= geometry.volume();
+
+            Scalar transBoundaryIs;
+            computeHalfTrans_(transBoundaryIs,
                               faceAreaNormal,
-                              insideFaceIdx,
+                              intersection.indexInInside(),
                               distanceVector_(faceCenterInside,
                                               intersection.indexInInside(),
                                               elemIdx,
                                               axisCentroids),
                               permeability_[elemIdx]);
-            computeHalfTrans_(halfTrans2,
-                              faceAreaNormal,
-                              outsideFaceIdx,
-                              distanceVector_(faceCenterOutside,
-                                              intersection.indexInOutside(),
-                                              outsideElemIdx,
-                                              axisCentroids),
-                              permeability_[outsideElemIdx]);
-
-            applyNtg_(halfTrans1, insideFaceIdx, elemIdx, ntg);
-            applyNtg_(halfTrans2, outsideFaceIdx, outsideElemIdx, ntg);
-
-            // convert half transmissibilities to full face
-            // transmissibilities using the harmonic mean
-            Scalar trans;
-            if (std::abs(halfTrans1) < 1e-30 || std::abs(halfTrans2) < 1e-30)
-                // avoid division by zero
-                trans = 0.0;
-            else
-                trans = 1.0 / (1.0/halfTrans1 + 1.0/halfTrans2);
 
-            // apply the full face transmissibility multipliers
-            // for the inside ...
+            // normally there would be two half-transmissibilities that would be
+            // averaged. on the grid boundary there only is the half
+            // transmissibility of the interior element.
+            buffers.transBoundary.emplace_back(std::make_pair(elemIdx, boundaryIsIdx), transBoundaryIs);
 
-            if (useSmallestMultiplier)
-            {
-                // Currently PINCH(4) is never queries and hence  PINCH(4) == TOPBOT is assumed
-                // and in this branch PINCH(5) == ALL holds
-                applyAllZMultipliers_(trans, insideFaceIdx, outsideFaceIdx, insideCartElemIdx,
-                                      outsideCartElemIdx, transMult, cartDims,
-                                      /* pinchTop= */ false);
-            }
-            else
-            {
-                applyMultipliers_(trans, insideFaceIdx, insideCartElemIdx, transMult);
-                // ... and outside elements
-                applyMultipliers_(trans, outsideFaceIdx, outsideCartElemIdx, transMult);
-            }
-
-            // apply the region multipliers (cf. the MULTREGT keyword)
-            FaceDir::DirEnum faceDir;
-            switch (insideFaceIdx) {
-            case 0:
-            case 1:
-                faceDir = FaceDir::XPlus;
-                break;
-
-            case 2:
-            case 3:
-                faceDir = FaceDir::YPlus;
-                break;
-
-            case 4:
-            case 5:
-                faceDir = FaceDir::ZPlus;
-                break;
-
-            default:
-                throw std::logic_error("Could not determine a face direction");
-            }
-
-            trans *= transMult.getRegionMultiplier(insideCartElemIdx,
-                                                   outsideCartElemIdx,
-                                                   faceDir);
-
-            trans_[isId(elemIdx, outsideElemIdx)] = trans;
-
-            // update the "thermal half transmissibility" for the intersection
+            // for boundary intersections we also need to compute the thermal
+            // half transmissibilities
             if (enableEnergy_) {
-
-                Scalar halfDiffusivity1;
-                Scalar halfDiffusivity2;
-
-                computeHalfDiffusivity_(halfDiffusivity1,
+                Scalar transBoundaryEnergyIs;
+                computeHalfDiffusivity_(transBoundaryEnergyIs,
                                         faceAreaNormal,
                                         distanceVector_(faceCenterInside,
                                                         intersection.indexInInside(),
                                                         elemIdx,
                                                         axisCentroids),
                                         1.0);
-                computeHalfDiffusivity_(halfDiffusivity2,
-                                        faceAreaNormal,
-                                        distanceVector_(faceCenterOutside,
-                                                        intersection.indexInOutside(),
-                                                        outsideElemIdx,
-                                                        axisCentroids),
-                                        1.0);
-                //TODO Add support for multipliers
-                thermalHalfTrans_[directionalIsId(elemIdx, outsideElemIdx)] = halfDiffusivity1;
-                thermalHalfTrans_[directionalIsId(outsideElemIdx, elemIdx)] = halfDiffusivity2;
-           }
+                buffers.thermalHalfTransBoundary.emplace_back(std::make_pair(elemIdx, boundaryIsIdx),
+                                                              transBoundaryEnergyIs);
+            }
 
-            // update the "diffusive half transmissibility" for the intersection
-            if (updateDiffusivity) {
+            ++ boundaryIsIdx;
+            continue;
+        }
 
-                Scalar halfDiffusivity1;
-                Scalar halfDiffusivity2;
+        if (!intersection.neighbor()) {
+            // elements can be on process boundaries, i.e. they are not on the
+            // domain boundary yet they don't have neighbors.
+            ++ boundaryIsIdx;
+            continue;
+        }
 
-                computeHalfDiffusivity_(halfDiffusivity1,
-                                        faceAreaNormal,
-                                        distanceVector_(faceCenterInside,
-                                                        intersection.indexInInside(),
-                                                        elemIdx,
-                                                        axisCentroids),
-                                        porosity_[elemIdx]);
-                computeHalfDiffusivity_(halfDiffusivity2,
-                                        faceAreaNormal,
-                                        distanceVector_(faceCenterOutside,
-                                                        intersection.indexInOutside(),
-                                                        outsideElemIdx,
-                                                        axisCentroids),
-                                        porosity_[outsideElemIdx]);
+        const auto& outsideElem = intersection.outside();
+        unsigned outsideElemIdx = elemMapper.index(outsideElem);
 
-                applyNtg_(halfDiffusivity1, insideFaceIdx, elemIdx, ntg);
-                applyNtg_(halfDiffusivity2, outsideFaceIdx, outsideElemIdx, ntg);
+        unsigned insideCartElemIdx = cartMapper_.cartesianIndex(elemIdx);
+        unsigned outsideCartElemIdx = cartMapper_.cartesianIndex(outsideElemIdx);
 
-                //TODO Add support for multipliers
-                Scalar diffusivity;
-                if (std::abs(halfDiffusivity1) < 1e-30 || std::abs(halfDiffusivity2) < 1e-30)
-                    // avoid division by zero
-                    diffusivity = 0.0;
-                else
-                    diffusivity = 1.0 / (1.0/halfDiffusivity1 + 1.0/halfDiffusivity2);
+        // we only need to calculate a face's transmissibility
+        // once...
+        if (insideCartElemIdx > outsideCartElemIdx)
+            continue;
 
+        // local indices of the faces of the inside and
+        // outside elements which contain the intersection
+        int insideFaceIdx  = intersection.indexInInside();
+        int outsideFaceIdx = intersection.indexInOutside();
 
-                diffusivity_[isId(elemIdx, outsideElemIdx)] = diffusivity;
-           }
+        if (insideFaceIdx == -1) {
+            // NNC. Set zero transmissibility, as it will be
+            // *added to* by applyNncToGridTrans_() later.
+            assert(outsideFaceIdx == -1);
+            buffers.trans.emplace_back(isId(elemIdx, outsideElemIdx), 0.0);
+            continue;
         }
-    }
 
-    // potentially overwrite and/or modify  transmissibilities based on input from deck
-    updateFromEclState_(global);
+        DimVector faceCenterInside;
+        DimVector faceCenterOutside;
+        DimVector faceAreaNormal;
 
-    // Create mapping from global to local index
-    const size_t cartesianSize = cartMapper_.cartesianSize();
-    // reserve memory
-    std::vector<int> globalToLocal(cartesianSize, -1);
+        typename std::is_same<Grid, Dune::CpGrid>::type isCpGrid;
+        computeFaceProperties(intersection,
+                              elemIdx,
+                              insideFaceIdx,
+                              outsideElemIdx,
+                              outsideFaceIdx,
+                              faceCenterInside,
+                              faceCenterOutside,
+                              faceAreaNormal,
+                              isCpGrid);
+
+        Scalar halfTrans1;
+        Scalar halfTrans2;
+
+        computeHalfTrans_(halfTrans1,
+                          faceAreaNormal,
+                          insideFaceIdx,
+                          distanceVector_(faceCenterInside,
+                                          intersection.indexInInside(),
+                                          elemIdx,
+                                          axisCentroids),
+                          permeability_[elemIdx]);
+        computeHalfTrans_(halfTrans2,
+                          faceAreaNormal,
+                          outsideFaceIdx,
+                          distanceVector_(faceCenterOutside,
+                                          intersection.indexInOutside(),
+                                          outsideElemIdx,
+                                          axisCentroids),
+                          permeability_[outsideElemIdx]);
+
+        applyNtg_(halfTrans1, insideFaceIdx, elemIdx, ntg);
+        applyNtg_(halfTrans2, outsideFaceIdx, outsideElemIdx, ntg);
+
+        // convert half transmissibilities to full face
+        // transmissibilities using the harmonic mean
+        Scalar trans;
+        if (std::abs(halfTrans1) < 1e-30 || std::abs(halfTrans2) < 1e-30)
+            // avoid division by zero
+            trans = 0.0;
+        else
+            trans = 1.0 / (1.0/halfTrans1 + 1.0/halfTrans2);
 
-    // loop over all elements (global grid) and store Cartesian index
-    elemIt = grid_.leafGridView().template begin<0>();
+        // apply the full face transmissibility multipliers
+        // for the inside ...
 
-    for (; elemIt != elemEndIt; ++elemIt) {
-        int elemIdx = elemMapper.index(*elemIt);
-        int cartElemIdx = cartMapper_.cartesianIndex(elemIdx);
-        globalToLocal[cartElemIdx] = elemIdx;
+        if (useSmallestMultiplier)
+        {
+            // Currently PINCH(4) is never queries and hence  PINCH(4) == TOPBOT is assumed
+            // and in this branch PINCH(5) == ALL holds
+            applyAllZMultipliers_(trans, insideFaceIdx, outsideFaceIdx, insideCartElemIdx,
+                                  outsideCartElemIdx, transMult, cartDims,
+                                  /* pinchTop= */ false);
+        }
+        else
+        {
+            applyMultipliers_(trans, insideFaceIdx, insideCartElemIdx, transMult);
+            // ... and outside elements
+            applyMultipliers_(trans, outsideFaceIdx, outsideCartElemIdx, transMult);
+        }
+
+        // apply the region multipliers (cf. the MULTREGT keyword)
+        FaceDir::DirEnum faceDir;
+        switch (insideFaceIdx) {
+        case 0:
+        case 1:
+            faceDir = FaceDir::XPlus;
+            break;
+
+        case 2:
+        case 3:
+            faceDir = FaceDir::YPlus;
+            break;
+
+        case 4:
+        case 5:
+            faceDir = FaceDir::ZPlus;
+            break;
+
+        default:
+            throw std::logic_error("Could not determine a face direction");
+        }
+
+        trans *= transMult.getRegionMultiplier(insideCartElemIdx,
+                                               outsideCartElemIdx,
+                                               faceDir);
+
+        buffers.trans.emplace_back(isId(elemIdx, outsideElemIdx), trans);
+
+        // update the "thermal half transmissibility" for the intersection
+        if (enableEnergy_) {
+
+            Scalar halfDiffusivity1;
+            Scalar halfDiffusivity2;
+
+            computeHalfDiffusivity_(halfDiffusivity1,
+                                    faceAreaNormal,
+                                    distanceVector_(faceCenterInside,
+                                                    intersection.indexInInside(),
+                                                    elemIdx,
+                                                    axisCentroids),
+                                    1.0);
+            computeHalfDiffusivity_(halfDiffusivity2,
+                                    faceAreaNormal,
+                                    distanceVector_(faceCenterOutside,
+                                                    intersection.indexInOutside(),
+                                                    outsideElemIdx,
+                                                    axisCentroids),
+                                    1.0);
+            //TODO Add support for multipliers
+            buffers.thermalHalfTrans.emplace_back(directionalIsId(elemIdx, outsideElemIdx), halfDiffusivity1);
+            buffers.thermalHalfTrans.emplace_back(directionalIsId(outsideElemIdx, elemIdx), halfDiffusivity2);
+       }
+
+        // update the "diffusive half transmissibility" for the intersection
+        if (updateDiffusivity) {
+
+            Scalar halfDiffusivity1;
+            Scalar halfDiffusivity2;
+
+            computeHalfDiffusivity_(halfDiffusivity1,
+                                    faceAreaNormal,
+                                    distanceVector_(faceCenterInside,
+                                                    intersection.indexInInside(),
+                                                    elemIdx,
+                                                    axisCentroids),
+                                    porosity_[elemIdx]);
+            computeHalfDiffusivity_(halfDiffusivity2,
+                                    faceAreaNormal,
+                                    distanceVector_(faceCenterOutside,
+                                                    intersection.indexInOutside(),
+                                                    outsideElemIdx,
+                                                    axisCentroids),
+                                    porosity_[outsideElemIdx]);
+
+            applyNtg_(halfDiffusivity1, insideFaceIdx, elemIdx, ntg);
+            applyNtg_(halfDiffusivity2, outsideFaceIdx, outsideElemIdx, ntg);
+
+            //TODO Add support for multipliers
+            Scalar diffusivity;
+            if (std::abs(halfDiffusivity1) < 1e-30 || std::abs(halfDiffusivity2) < 1e-30)
+                // avoid division by zero
+                diffusivity = 0.0;
+            else
+                diffusivity = 1.0 / (1.0/halfDiffusivity1 + 1.0/halfDiffusivity2);
+
+
+            buffers.diffusivity.emplace_back(isId(elemIdx, outsideElemIdx), diffusivity);
+       }
     }
-    applyEditNncToGridTrans_(globalToLocal);
-    applyNncToGridTrans_(globalToLocal);
+}
 
-    //remove very small non-neighbouring transmissibilities
-    removeSmallNonCartesianTransmissibilities_();
+template<class Grid, class GridView, class ElementMapper, class Scalar>
+void EclTransmissibility<Grid,GridView,ElementMapper,Scalar>::
+mergeFaceBuffers_(std::vector<FaceBuffers_>& faceBuffers)
+{
+    // reserve the exact number of entries so that the hash maps are never
+    // rehashed while they are filled
+    std::size_t numTrans = 0;
+    std::size_t numThermalHalfTrans = 0;
+    std::size_t numDiffusivity = 0;
+    for (const auto& buffers : faceBuffers) {
+        numTrans += buffers.trans.size();
+        numThermalHalfTrans += buffers.thermalHalfTrans.size();
+        numDiffusivity += buffers.diffusivity.size();
+    }
+    trans_.reserve(numTrans);
+    thermalHalfTrans_.reserve(numThermalHalfTrans);
+    diffusivity_.reserve(numDiffusivity);
+
+    for (auto& buffers : faceBuffers) {
+        for (const auto& [id, value] : buffers.trans)
+            trans_[id] = value;
+        for (const auto& [id, value] : buffers.thermalHalfTrans)
+            thermalHalfTrans_[id] = value;
+        for (const auto& [id, value] : buffers.diffusivity)
+            diffusivity_[id] = value;
+        for (const auto& [id, value] : buffers.transBoundary)
+            transBoundary_[id] = value;
+        for (const auto& [id, value] : buffers.thermalHalfTransBoundary)
+            thermalHalfTransBoundary_[id] = value;
+
+        // release the memory of the buffer right away to keep the peak low
+        buffers = FaceBuffers_();
+    }
 }
 
 template<class Grid, class GridView, class ElementMapper, class Scalar>
@@ -36,6 +36,7 @@
 #include <array>
 #include <map>
 #include <tuple>
+#include <utility>
 #include <vector>
 #include <unordered_map>
 
@@ -126,7 +127,45 @@ public:
      */
     void update(bool global);
 
+    /*!
+     * \brief Free the memory occupied by the quantities of the intersections between
+     *        two elements.
+     *
+     * This is meant to be called once the users of these quantities have copied them,
+     * afterwards transmissibility(), thermalHalfTrans() and diffusivity() throw
+     * std::logic_error until the next update(). The quantities of the boundary segments
+     * are kept.
+     */
+    void releaseInteriorTransmissibilities();
+
 protected:
+    using Element = typename GridView::template Codim<0>::Entity;
+
+    // the quantities of the faces computed by one thread
+    struct FaceBuffers_
+    {
+        std::vector<std::pair<std::uint64_t, Scalar>> trans;
+        std::vector<std::pair<std::uint64_t, Scalar>> thermalHalfTrans;
+        std::vector<std::pair<std::uint64_t, Scalar>> diffusivity;
+        std::vector<std::pair<std::pair<unsigned, unsigned>, Scalar>> transBoundary;
+        std::vector<std::pair<std::pair<unsigned, unsigned>, Scalar>> thermalHalfTransBoundary;
+    };
+
+    // compute the quantities of all intersections of an element
+    void computeElementFaces_(const Element& elem,
+                              const ElementMapper& elemMapper,
+                              const std::array<std::vector<DimVector>, dimWorld>& axisCentroids,
+                              const std::vector<double>& ntg,
+                              const TransMult& transMult,
+                              const std::array<int, dimWorld>& cartDims,
+                              bool useSmallestMultiplier,
+                              bool updateDiffusivity,
+                              FaceBuffers_& buffers);
+
+    void mergeFaceBuffers_(std::vector<FaceBuffers_>& faceBuffers);
+
+    void checkInteriorAvailable_(const char* accessor) const;
+
     void updateFromEclState_(bool global);
 
     void removeSmallNonCartesianTransmissibilities_();
@@ -244,6 +283,7 @@ protected:
     bool enableDiffusivity_;
     std::unordered_map<std::uint64_t, Scalar> thermalHalfTrans_;
     std::unordered_map<std::uint64_t, Scalar> diffusivity_;
+    bool interiorReleased_ = false;
 };
 
 } // namespace Opm
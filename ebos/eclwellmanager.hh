@@ -623,6 +623,23 @@ public:
         throw std::logic_error("initFromRestartFile() method not implemented for class eclwellmanager");
     }
 
+    std::vector<char> packCheckpoint() const
+    {
+        // restarts are not supported by this well manager, so there is no state
+        // which needs to be written
+        return {};
+    }
+
+    void initFromCheckpoint(const std::vector<char>& buffer OPM_UNUSED)
+    {
+        throw std::logic_error("initFromCheckpoint() method not implemented for class eclwellmanager");
+    }
+
+    void resumeFromCheckpoint(const std::vector<char>& buffer OPM_UNUSED)
+    {
+        throw std::logic_error("resumeFromCheckpoint() method not implemented for class eclwellmanager");
+    }
+
     const WellState& wellState() const
     {
         throw std::logic_error("wellState() method not implemented for class eclwellmanager");
@@ -29,14 +29,21 @@
 #define EWOMS_ECL_WRITER_HH
 
 #include "collecttoiorank.hh"
+#include "eclmappedrestartfile.hh"
 #include "ecloutputblackoilmodule.hh"
 
+#include <opm/models/parallel/threadedentityiterator.hh>
+
+#include <opm/output/data/Solution.hpp>
 #include <opm/parser/eclipse/Units/UnitSystem.hpp>
 
 #include <opm/simulators/utils/ParallelRestart.hpp>
 
 #include <ebos/eclgenericwriter.hh>
 
+#include <exception>
+#include <mutex>
+#include <stdexcept>
 #include <string>
 
 namespace Opm::Properties {
@@ -53,6 +60,22 @@ template<class TypeTag, class MyTypeTag>
 struct EclOutputDoublePrecision {
     using type = UndefinedProperty;
 };
+template<class TypeTag, class MyTypeTag>
+struct EclOutputMaxPendingWrites {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct EclOutputMaxPendingWriteMemory {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct EclLazyRestartReading {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct EclDistributedRestartOutput {
+    using type = UndefinedProperty;
+};
 
 } // namespace Opm::Properties
 
@@ -108,6 +131,14 @@ public:
 
         EWOMS_REGISTER_PARAM(TypeTag, bool, EnableAsyncEclOutput,
                              "Write the ECL-formated results in a non-blocking way (i.e., using a separate thread).");
+        EWOMS_REGISTER_PARAM(TypeTag, int, EclOutputMaxPendingWrites,
+                             "Maximum number of report steps which may be queued for non-blocking writing of the ECL-formated results.");
+        EWOMS_REGISTER_PARAM(TypeTag, Scalar, EclOutputMaxPendingWriteMemory,
+                             "Maximum memory in MiB held by results queued for non-blocking writing. Zero means no limit besides EclOutputMaxPendingWrites.");
+        EWOMS_REGISTER_PARAM(TypeTag, bool, EclLazyRestartReading,
+                             "Let each process read the cell values of its own cells directly from a binary restart file instead of receiving the complete restart solution from the I/O rank.");
+        EWOMS_REGISTER_PARAM(TypeTag, bool, EclDistributedRestartOutput,
+                             "Let each process write the restart cell arrays of its own cells to <CASE>.<RANK>.OPMCELL instead of sending them to the I/O rank. Parallel runs with unified binary output only. The restart file lacks the cell arrays until the files are merged into it by mergedistributedrestart.");
     }
 
     // The Simulator object should preferably have been const - the
@@ -122,7 +153,10 @@ public:
                    simulator.vanguard().gridView(),
                    simulator.vanguard().cartesianIndexMapper(),
                    simulator.vanguard().grid().comm().rank() == 0 ? &simulator.vanguard().equilCartesianIndexMapper() : nullptr,
-                   EWOMS_GET_PARAM(TypeTag, bool, EnableAsyncEclOutput))
+                   EWOMS_GET_PARAM(TypeTag, bool, EnableAsyncEclOutput),
+                   EWOMS_GET_PARAM(TypeTag, int, EclOutputMaxPendingWrites),
+                   EWOMS_GET_PARAM(TypeTag, Scalar, EclOutputMaxPendingWriteMemory),
+                   EWOMS_GET_PARAM(TypeTag, bool, EclDistributedRestartOutput))
         , simulator_(simulator)
     {
         this->eclOutputModule_ = std::make_unique<EclOutputBlackOilModule<TypeTag>>(simulator, this->wbp_index_list_, this->collectToIORank_);
@@ -239,6 +273,9 @@ public:
 
             // add cell data to perforations for Rft output
             this->eclOutputModule_->addRftDataToWells(localWellData, reportStepNum);
+
+            this->writeDistributedCellData(reportStepNum, localCellData,
+                                           EWOMS_GET_PARAM(TypeTag, bool, EclOutputDoublePrecision));
         }
 
         if (this->collectToIORank_.isParallel()) {
@@ -304,14 +341,27 @@ public:
         unsigned numElements = gridView.size(/*codim=*/0);
         eclOutputModule_->allocBuffers(numElements, restartStepIdx, /*isSubStep=*/false, /*log=*/false, /*isRestart*/ true);
 
+        // formatted restart files can not be accessed randomly, so they are always
+        // read completely by the I/O rank
+        const bool lazyRestart = EWOMS_GET_PARAM(TypeTag, bool, EclLazyRestartReading)
+            && !eclState().getIOConfig().getFMTIN();
+
         {
             SummaryState& summaryState = simulator_.vanguard().summaryState();
             Action::State& actionState = simulator_.vanguard().actionState();
-            auto restartValues = loadParallelRestart(this->eclIO_.get(), actionState, summaryState, solutionKeys, extraKeys,
-                                                     gridView.grid().comm());
-            for (unsigned elemIdx = 0; elemIdx < numElements; ++elemIdx) {
-                unsigned globalIdx = this->collectToIORank_.localIdxToGlobalIdx(elemIdx);
-                eclOutputModule_->setRestart(restartValues.solution, elemIdx, globalIdx);
+            auto restartValues = loadParallelRestart(this->eclIO_.get(), actionState, summaryState,
+                                                     lazyRestart ? std::vector<RestartKey>{} : solutionKeys,
+                                                     extraKeys, gridView.grid().comm());
+            if (lazyRestart) {
+                const auto localSolution = loadLocalRestartSolution_(solutionKeys, restartStepIdx);
+                for (unsigned elemIdx = 0; elemIdx < numElements; ++elemIdx)
+                    eclOutputModule_->setRestart(localSolution, elemIdx, elemIdx);
+            }
+            else {
+                for (unsigned elemIdx = 0; elemIdx < numElements; ++elemIdx) {
+                    unsigned globalIdx = this->collectToIORank_.localIdxToGlobalIdx(elemIdx);
+                    eclOutputModule_->setRestart(restartValues.solution, elemIdx, globalIdx);
+                }
             }
 
             if (inputThpres.active()) {
@@ -340,6 +390,49 @@ public:
     { return restartTimeStepSize_; }
 
 private:
+    // Decode the restart solution of the local cells from the restart file. The
+    // result is indexed by the local element index.
+    data::Solution loadLocalRestartSolution_(const std::vector<RestartKey>& solutionKeys,
+                                             int restartStepIdx) const
+    {
+        const auto& ioConfig = eclState().getIOConfig();
+        const auto& initconfig = eclState().getInitConfig();
+        const EclMappedRestartFile restartFile(ioConfig.getRestartFileName(initconfig.getRestartRootName(),
+                                                                           restartStepIdx,
+                                                                           /*output=*/false),
+                                               restartStepIdx,
+                                               ioConfig.getUNIFIN());
+
+        const unsigned numElements = simulator_.vanguard().gridView().size(/*codim=*/0);
+        std::vector<int> globalIndices(numElements);
+        for (unsigned elemIdx = 0; elemIdx < numElements; ++elemIdx)
+            globalIndices[elemIdx] = this->collectToIORank_.localIdxToGlobalIdx(elemIdx);
+
+        // the cell arrays must have one entry per active cell of the global grid,
+        // otherwise the global indices would address the wrong values. this is a
+        // collective call, so it is done before any of the checks can throw.
+        const std::size_t numGlobalCells = simulator_.vanguard().globalNumCells();
+
+        data::Solution solution(/*init_si=*/false);
+        for (const auto& key : solutionKeys) {
+            if (restartFile.has(key.key)) {
+                const std::size_t arraySize = restartFile.size(key.key);
+                if (arraySize != numGlobalCells)
+                    throw std::runtime_error("Read of restart file: " + key.key + " has "
+                                             + std::to_string(arraySize) + " entries, but the grid has "
+                                             + std::to_string(numGlobalCells) + " active cells");
+
+                solution.insert(key.key, key.dim, restartFile.read(key.key, globalIndices),
+                                data::TargetType::RESTART_SOLUTION);
+            }
+            else if (key.required)
+                throw std::runtime_error("Read of restart file: File does not contain " + key.key + " data");
+        }
+        solution.convertToSI(eclState().getUnits());
+
+        return solution;
+    }
+
     static bool enableEclOutput_()
     { return EWOMS_GET_PARAM(TypeTag, bool, EnableEclOutput); }
 
@@ -368,18 +461,38 @@ private:
         eclOutputModule_->allocBuffers(numElements, reportStepNum,
                                       isSubStep, log, /*isRestart*/ false);
 
-        ElementContext elemCtx(simulator_);
-        ElementIterator elemIt = gridView.template begin</*codim=*/0>();
-
-        const ElementIterator& elemEndIt = gridView.template end</*codim=*/0>();
-        for (; elemIt != elemEndIt; ++elemIt) {
-            const Element& elem = *elemIt;
+        // the output module only writes the per-cell entries of the elements it
+        // is given, so the elements can be processed by all threads at once.
+        std::mutex exceptionLock;
+        std::exception_ptr exceptionPtr = nullptr;
+        ThreadedEntityIterator<GridView, /*codim=*/0> threadedElemIt(gridView);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            ElementContext elemCtx(simulator_);
+            ElementIterator elemIt = threadedElemIt.beginParallel();
+            try {
+                for (; !threadedElemIt.isFinished(elemIt); elemIt = threadedElemIt.increment()) {
+                    const Element& elem = *elemIt;
 
-            elemCtx.updatePrimaryStencil(elem);
-            elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+                    elemCtx.updatePrimaryStencil(elem);
+                    elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
 
-            eclOutputModule_->processElement(elemCtx);
+                    eclOutputModule_->processElement(elemCtx);
+                }
+            }
+            // exceptions must not escape the parallel block, so remember the
+            // exception and rethrow it once all threads are done.
+            catch (...) {
+                std::lock_guard<std::mutex> take(exceptionLock);
+                exceptionPtr = std::current_exception();
+                threadedElemIt.setFinished();
+            }
         }
+
+        if (exceptionPtr)
+            std::rethrow_exception(exceptionPtr);
     }
 
     Simulator& simulator_;
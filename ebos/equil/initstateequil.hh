@@ -58,7 +58,11 @@
 #include <array>
 #include <cassert>
 #include <cstddef>
+#include <exception>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
@@ -1888,16 +1892,19 @@ private:
         using PhaseSat = Details::PhaseSaturations<
             MaterialLawManager, FluidSystem, EquilReg, typename RMap::CellId
         >;
+        using PTable = Details::PressureTable<FluidSystem, EquilReg>;
 
-        auto ptable = Details::PressureTable<FluidSystem, EquilReg>{ grav };
-        auto psat   = PhaseSat { materialLawManager, this->swatInit_ };
-        auto vspan  = std::array<double, 2>{};
+        const auto numRegions = rec.size();
 
-        std::vector<int> regionIsEmpty(rec.size(), 0);
-        for (size_t r = 0; r < rec.size(); ++r) {
+        // The vertical extent of a region involves collective communication,
+        // so it is determined for all regions before anything is done in
+        // parallel.
+        std::vector<std::array<double, 2>> vspan(numRegions);
+        std::vector<int> regionIsEmpty(numRegions, 0);
+        for (size_t r = 0; r < numRegions; ++r) {
             const auto& cells = reg.cells(r);
 
-            Details::verticalExtent(cells, cellZMinMax_, comm, vspan);
+            Details::verticalExtent(cells, cellZMinMax_, comm, vspan[r]);
 
             const auto acc = rec[r].initializationTargetAccuracy();
             if (acc > 0) {
@@ -1907,30 +1914,48 @@ private:
                 };
             }
 
-            if (cells.empty()) {
+            if (cells.empty())
                 regionIsEmpty[r] = 1;
-                continue;
-            }
+        }
 
-            const auto eqreg = EquilReg {
+        // The phase pressure tables of the regions are independent of each
+        // other.
+        std::vector<std::unique_ptr<EquilReg>> eqreg(numRegions);
+        std::vector<std::unique_ptr<PTable>> ptable(numRegions);
+        this->parallelFor_(numRegions, /*chunkSize=*/1, [&](const std::size_t r)
+        {
+            if (regionIsEmpty[r])
+                return;
+
+            eqreg[r] = std::make_unique<EquilReg>(
                 rec[r], this->rsFunc_[r], this->rvFunc_[r], this->saltVdTable_[r], this->regionPvtIdx_[r]
-            };
+            );
 
             // Ensure gas/oil and oil/water contacts are within the span for the
             // phase pressure calculation.
-            vspan[0] = std::min(vspan[0], std::min(eqreg.zgoc(), eqreg.zwoc()));
-            vspan[1] = std::max(vspan[1], std::max(eqreg.zgoc(), eqreg.zwoc()));
+            auto span = vspan[r];
+            span[0] = std::min(span[0], std::min(eqreg[r]->zgoc(), eqreg[r]->zwoc()));
+            span[1] = std::max(span[1], std::max(eqreg[r]->zgoc(), eqreg[r]->zwoc()));
 
-            ptable.equilibrate(eqreg, vspan);
+            ptable[r] = std::make_unique<PTable>(grav);
+            ptable[r]->equilibrate(*eqreg[r], span);
+        });
 
+        for (size_t r = 0; r < numRegions; ++r) {
+            if (regionIsEmpty[r])
+                continue;
+
+            const auto& cells = reg.cells(r);
+            const auto acc = rec[r].initializationTargetAccuracy();
             if (acc == 0) {
                 // Centre-point method
-                this->equilibrateCellCentres(cells, eqreg, ptable, psat);
+                this->template equilibrateCellCentres<PhaseSat>(cells, *eqreg[r], *ptable[r],
+                                                                materialLawManager);
             }
             else if (acc < 0) {
                 // Horizontal subdivision
-                this->equilibrateHorizontal(cells, eqreg, -acc,
-                                            ptable, psat);
+                this->template equilibrateHorizontal<PhaseSat>(cells, *eqreg[r], -acc,
+                                                               *ptable[r], materialLawManager);
             } else {
                 // Horizontal subdivision with titled fault blocks
                 // the simulator throw a few line above for the acc > 0 case
@@ -1948,6 +1973,37 @@ private:
         }
     }
 
+    // Call fn(i) for i = 0, ..., n-1 on all threads. The indices are handed
+    // out to the threads in chunks of chunkSize, which should be large if a
+    // single call is cheap. Exceptions must not escape the parallel block,
+    // so the first one is remembered and rethrown once all threads are done.
+    template <class Function>
+    void parallelFor_(const std::size_t n, const int chunkSize, Function&& fn)
+    {
+        std::mutex exceptionLock;
+        std::exception_ptr exceptionPtr = nullptr;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, chunkSize)
+#endif
+        for (int i = 0; i < static_cast<int>(n); ++i) {
+            try {
+                fn(static_cast<std::size_t>(i));
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> take(exceptionLock);
+                if (!exceptionPtr)
+                    exceptionPtr = std::current_exception();
+            }
+        }
+
+        if (exceptionPtr)
+            std::rethrow_exception(exceptionPtr);
+    }
+
+    // The cells of a region are equilibrated independently of each other, so
+    // they are distributed over all threads. Each cell needs its own
+    // evaluation state, which is why the equilibration method is called
+    // with a fresh PhaseSaturations object per cell.
     template <class CellRange, class EquilibrationMethod>
     void cellLoop(const CellRange&      cells,
                   EquilibrationMethod&& eqmethod)
@@ -1960,12 +2016,18 @@ private:
         const auto gasActive = FluidSystem::phaseIsActive(gasPos);
         const auto watActive = FluidSystem::phaseIsActive(watPos);
 
-        auto pressures   = Details::PhaseQuantityValue{};
-        auto saturations = Details::PhaseQuantityValue{};
-        auto Rs          = 0.0;
-        auto Rv          = 0.0;
+        const auto cellBegin = cells.begin();
+        const auto numCells = static_cast<std::size_t>(std::distance(cellBegin, cells.end()));
+
+        this->parallelFor_(numCells, /*chunkSize=*/64, [&](const std::size_t i)
+        {
+            const auto cell = *(cellBegin + i);
+
+            auto pressures   = Details::PhaseQuantityValue{};
+            auto saturations = Details::PhaseQuantityValue{};
+            auto Rs          = 0.0;
+            auto Rv          = 0.0;
 
-        for (const auto& cell : cells) {
             eqmethod(cell, pressures, saturations, Rs, Rv);
 
             if (oilActive) {
@@ -1987,25 +2049,27 @@ private:
                 this->rs_[cell] = Rs;
                 this->rv_[cell] = Rv;
             }
-        }
+        });
     }
 
-    template <class CellRange, class PressTable, class PhaseSat>
+    template <class PhaseSat, class CellRange, class PressTable, class MaterialLawManager>
     void equilibrateCellCentres(const CellRange&         cells,
                                 const EquilReg&          eqreg,
                                 const PressTable&        ptable,
-                                PhaseSat&                psat)
+                                MaterialLawManager&      materialLawManager)
     {
         using CellPos = typename PhaseSat::Position;
         using CellID  = std::remove_cv_t<std::remove_reference_t<
             decltype(std::declval<CellPos>().cell)>>;
-        this->cellLoop(cells, [this, &eqreg,  &ptable, &psat]
+        this->cellLoop(cells, [this, &eqreg,  &ptable, &materialLawManager]
             (const CellID                 cell,
              Details::PhaseQuantityValue& pressures,
              Details::PhaseQuantityValue& saturations,
              double&                      Rs,
              double&                      Rv) -> void
         {
+            auto psat = PhaseSat { materialLawManager, this->swatInit_ };
+
             const auto pos = CellPos {
                 cell, cellCenterDepth_[cell]
             };
@@ -2023,24 +2087,26 @@ private:
         });
     }
 
-    template <class CellRange, class PressTable, class PhaseSat>
-    void equilibrateHorizontal(const CellRange&  cells,
-                               const EquilReg&   eqreg,
-                               const int         acc,
-                               const PressTable& ptable,
-                               PhaseSat&         psat)
+    template <class PhaseSat, class CellRange, class PressTable, class MaterialLawManager>
+    void equilibrateHorizontal(const CellRange&    cells,
+                               const EquilReg&     eqreg,
+                               const int           acc,
+                               const PressTable&   ptable,
+                               MaterialLawManager& materialLawManager)
     {
         using CellPos = typename PhaseSat::Position;
         using CellID  = std::remove_cv_t<std::remove_reference_t<
             decltype(std::declval<CellPos>().cell)>>;
 
-        this->cellLoop(cells, [this, acc, &eqreg, &ptable, &psat]
+        this->cellLoop(cells, [this, acc, &eqreg, &ptable, &materialLawManager]
             (const CellID                 cell,
              Details::PhaseQuantityValue& pressures,
              Details::PhaseQuantityValue& saturations,
              double&                      Rs,
              double&                      Rv) -> void
         {
+            auto psat = PhaseSat { materialLawManager, this->swatInit_ };
+
             pressures  .reset();
             saturations.reset();
 
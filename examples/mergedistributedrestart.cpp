@@ -0,0 +1,56 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#include <ebos/ecldistributedcelldata.hh>
+
+#include <cstdio>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Insert the cell data files written with --ecl-distributed-restart-output=true
+// into the restart file of the run.
+int main(int argc, char** argv)
+{
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <CASE>.UNRST <CASE>.0.OPMCELL [<CASE>.1.OPMCELL ...]\n";
+        return 1;
+    }
+
+    const std::string restartFileName = argv[1];
+    const std::vector<std::string> cellDataFileNames(argv + 2, argv + argc);
+    const std::string mergedFileName = restartFileName + ".tmp";
+
+    try {
+        Opm::mergeEclDistributedCellData(restartFileName, cellDataFileNames, mergedFileName);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Merging the cell data into " << restartFileName << " failed: " << e.what() << '\n';
+        std::remove(mergedFileName.c_str());
+        return 1;
+    }
+
+    if (std::rename(mergedFileName.c_str(), restartFileName.c_str()) != 0) {
+        std::cerr << "Could not replace " << restartFileName << " by " << mergedFileName << '\n';
+        return 1;
+    }
+
+    return 0;
+}
@@ -132,40 +132,43 @@ protected:
         return std::make_pair(PItd, PItdprime);
     }
 
-    Scalar dpai(const int idx) const
-    {
-        const auto gdz =
-            this->gravity_() * (this->cell_depth_.at(idx) - this->aquiferDepth());
-
-        const auto dp = this->pa0_ + this->rhow_*gdz
-            - this->pressure_previous_.at(idx);
-
-        return dp;
-    }
-
-    // This function implements Eqs 5.8 and 5.9 of the EclipseTechnicalDescription
-    std::pair<Scalar, Scalar>
-    calculateEqnConstants(const int idx, const Simulator& simulator)
+    // This function implements Eqs 5.7, 5.8 and 5.9 of the
+    // EclipseTechnicalDescription. The influence table only depends on the
+    // time, so it is evaluated once for all connections.
+    void calculateInflowCoefficients() override
     {
+        const auto& simulator = this->ebos_simulator_;
         const Scalar td_plus_dt = (simulator.timeStepSize() + simulator.time()) / this->Tc_;
         this->dimensionless_time_ = simulator.time() / this->Tc_;
 
         const auto [PItd, PItdprime] = this->getInfluenceTableValues(td_plus_dt);
 
-        const auto denom = this->Tc_ * (PItd - this->dimensionless_time_*PItdprime);
-        const auto a = (this->beta_*dpai(idx) - this->fluxValue_*PItdprime) / denom;
-        const auto b = this->beta_ / denom;
-
-        return std::make_pair(a, b);
-    }
-
-    // This function implements Eq 5.7 of the EclipseTechnicalDescription
-    inline void calculateInflowRate(int idx, const Simulator& simulator) override
-    {
-        const auto [a, b] = this->calculateEqnConstants(idx, simulator);
-
-        this->Qai_.at(idx) = this->alphai_.at(idx) *
-            (a - b*(this->pressure_current_.at(idx) - this->pressure_previous_.at(idx)));
+        const Scalar denom = this->Tc_ * (PItd - this->dimensionless_time_*PItdprime);
+        const Scalar b = this->beta_ / denom;
+        const Scalar fluxTerm = this->fluxValue_*PItdprime;
+        const Scalar beta = this->beta_;
+        const Scalar pa0 = this->pa0_;
+        const Scalar rhow = this->rhow_;
+        const Scalar gravity = this->gravity_();
+        const Scalar datumDepth = this->aquiferDepth();
+
+        const Scalar* depth = this->cell_depth_.data();
+        const Scalar* pressurePrevious = this->pressure_previous_.data();
+        const Scalar* alpha = this->alphai_.data();
+        Scalar* offset = this->inflowOffset_.data();
+        Scalar* slope = this->inflowSlope_.data();
+        Scalar* refPressure = this->inflowRefPressure_.data();
+
+        const std::size_t numConnections = this->size();
+        for (std::size_t idx = 0; idx < numConnections; ++idx) {
+            const Scalar gdz = gravity*(depth[idx] - datumDepth);
+            const Scalar dpai = pa0 + rhow*gdz - pressurePrevious[idx];
+            const Scalar a = (beta*dpai - fluxTerm) / denom;
+
+            offset[idx] = alpha[idx]*a;
+            slope[idx] = alpha[idx]*b;
+            refPressure[idx] = pressurePrevious[idx];
+        }
     }
 
     inline void calculateAquiferConstants() override
@@ -109,15 +109,6 @@ protected:
         this->aquifer_pressure_ = xaq.pressure;
     }
 
-    inline Eval dpai(int idx)
-    {
-        const auto gdz =
-            this->gravity_() * (this->cell_depth_[idx] - this->aquiferDepth());
-
-        return this->aquifer_pressure_ + this->rhow_*gdz
-            - this->pressure_current_.at(idx);
-    }
-
     // This function implements Eq 5.12 of the EclipseTechnicalDescription
     inline Scalar aquiferPressure()
     {
@@ -138,13 +129,30 @@ protected:
     }
 
     // This function implements Eq 5.14 of the EclipseTechnicalDescription
-    inline void calculateInflowRate(int idx, const Simulator& simulator) override
+    void calculateInflowCoefficients() override
     {
-        const Scalar td_Tc_ = simulator.timeStepSize() / this->Tc_;
+        const Scalar td_Tc_ = this->ebos_simulator_.timeStepSize() / this->Tc_;
         const Scalar coef = (1 - exp(-td_Tc_)) / td_Tc_;
-
-        this->Qai_.at(idx) = coef * this->alphai_[idx] *
-            this->aqufetp_data_.prod_index * dpai(idx);
+        const Scalar prodIndex = this->aqufetp_data_.prod_index;
+        const Scalar pa = this->aquifer_pressure_;
+        const Scalar rhow = this->rhow_;
+        const Scalar gravity = this->gravity_();
+        const Scalar datumDepth = this->aquiferDepth();
+
+        const Scalar* depth = this->cell_depth_.data();
+        const Scalar* alpha = this->alphai_.data();
+        Scalar* offset = this->inflowOffset_.data();
+        Scalar* slope = this->inflowSlope_.data();
+        Scalar* refPressure = this->inflowRefPressure_.data();
+
+        const std::size_t numConnections = this->size();
+        for (std::size_t idx = 0; idx < numConnections; ++idx) {
+            const Scalar gdz = gravity*(depth[idx] - datumDepth);
+
+            offset[idx] = 0.0;
+            slope[idx] = coef*alpha[idx]*prodIndex;
+            refPressure[idx] = pa + rhow*gdz;
+        }
     }
 
     inline void calculateAquiferCondition() override
@@ -127,6 +127,14 @@ public:
         }
     }
 
+    void beginIteration()
+    {
+        // the inflow is linear in the pressure of the connected cells, so
+        // everything but that pressure is evaluated here for all connections
+        // at once instead of each time the source term of a cell is requested.
+        this->calculateInflowCoefficients();
+    }
+
     template <class Context>
     void addToSource(RateVector& rates,
                      const Context& context,
@@ -145,8 +153,9 @@ public:
         const auto& intQuants = context.intensiveQuantities(spaceIdx, timeIdx);
 
         // This is the pressure at td + dt
-        this->updateCellPressure(this->pressure_current_, idx, intQuants);
-        this->calculateInflowRate(idx, context.simulator());
+        const auto& pressure = intQuants.fluidState().pressure(waterPhaseIdx);
+        this->Qai_[idx] = this->inflowOffset_[idx]
+            + this->inflowSlope_[idx]*(this->inflowRefPressure_[idx] - pressure);
 
         rates[BlackoilIndices::conti0EqIdx + FluidSystem::waterCompIdx]
             += this->Qai_[idx] / context.dofVolume(spaceIdx, timeIdx);
@@ -158,6 +167,12 @@ public:
 
     int aquiferID() const { return this->aquiferID_; }
 
+    // index of the connection of a cell or -1 if the cell is not connected
+    int connectionIndex(unsigned cellIdx) const
+    {
+        return this->cellToConnectionIdx_[cellIdx];
+    }
+
 protected:
     inline Scalar gravity_() const
     {
@@ -178,22 +193,11 @@ protected:
         calculateAquiferConstants();
 
         pressure_previous_.resize(this->connections_.size(), 0.);
-        pressure_current_.resize(this->connections_.size(), 0.);
         Qai_.resize(this->connections_.size(), 0.0);
-    }
-
-    inline void
-    updateCellPressure(std::vector<Eval>& pressure_water, const int idx, const IntensiveQuantities& intQuants)
-    {
-        const auto& fs = intQuants.fluidState();
-        pressure_water.at(idx) = fs.pressure(waterPhaseIdx);
-    }
 
-    inline void
-    updateCellPressure(std::vector<Scalar>& pressure_water, const int idx, const IntensiveQuantities& intQuants)
-    {
-        const auto& fs = intQuants.fluidState();
-        pressure_water.at(idx) = fs.pressure(waterPhaseIdx).value();
+        inflowOffset_.resize(this->connections_.size(), 0.0);
+        inflowSlope_.resize(this->connections_.size(), 0.0);
+        inflowRefPressure_.resize(this->connections_.size(), 0.0);
     }
 
     virtual void endTimeStep() = 0;
@@ -209,10 +213,15 @@ protected:
     // Quantities at each grid id
     std::vector<Scalar> cell_depth_;
     std::vector<Scalar> pressure_previous_;
-    std::vector<Eval> pressure_current_;
     std::vector<Eval> Qai_;
     std::vector<Scalar> alphai_;
 
+    // Inflow of connection idx for the water pressure p of its cell:
+    // inflowOffset_[idx] + inflowSlope_[idx]*(inflowRefPressure_[idx] - p)
+    std::vector<Scalar> inflowOffset_;
+    std::vector<Scalar> inflowSlope_;
+    std::vector<Scalar> inflowRefPressure_;
+
     Scalar Tc_{}; // Time constant
     Scalar pa0_{}; // initial aquifer pressure
     Scalar rhow_{};
@@ -237,18 +246,16 @@ protected:
         for (size_t idx = 0; idx < this->size(); ++idx) {
             const auto global_index = this->connections_[idx].global_index;
             const int cell_index = this->ebos_simulator_.vanguard().compressedIndex(global_index);
-            auto elemIt = gridView.template begin</*codim=*/ 0>();
-            if (cell_index > 0)
-                std::advance(elemIt, cell_index);
 
            //the global_index is not part of this grid
-            if ( cell_index < 0 || elemIt->partitionType() != Dune::InteriorEntity)
+            if (cell_index < 0)
                 continue;
 
             this->cellToConnectionIdx_[cell_index] = idx;
-            this->cell_depth_.at(idx) = this->ebos_simulator_.vanguard().cellCenterDepth(cell_index);
         }
-        // get areas for all connections
+        // get areas for all connections. the partition type of the connected
+        // cells is checked during the same sweep over the grid, as looking up
+        // an element by its index would require advancing an iterator.
         ElementMapper elemMapper(gridView, Dune::mcmgElementLayout());
         auto elemIt = gridView.template begin</*codim=*/ 0>();
         const auto& elemEndIt = gridView.template end</*codim=*/ 0>();
@@ -261,6 +268,14 @@ protected:
             if( idx < 0)
                 continue;
 
+            // connections of overlap cells are handled by the owning process
+            if (elem.partitionType() != Dune::InteriorEntity) {
+                this->cellToConnectionIdx_[cell_index] = -1;
+                continue;
+            }
+
+            this->cell_depth_.at(idx) = this->ebos_simulator_.vanguard().cellCenterDepth(cell_index);
+
             auto isIt = gridView.ibegin(elem);
             const auto& isEndIt = gridView.iend(elem);
             for (; isIt != isEndIt; ++ isIt) {
@@ -318,7 +333,7 @@ protected:
 
     virtual void assignRestartData(const data::AquiferData& xaq) = 0;
 
-    virtual void calculateInflowRate(int idx, const Simulator& simulator) = 0;
+    virtual void calculateInflowCoefficients() = 0;
 
     virtual void calculateAquiferCondition() = 0;
 
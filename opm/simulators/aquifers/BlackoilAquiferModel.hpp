@@ -123,9 +123,16 @@ protected:
     mutable std::vector<AquiferFetkovich_object> aquifers_Fetkovich;
     std::vector<AquiferNumerical<TypeTag>> aquifers_numerical;
 
+    // Analytic aquifer connected to each cell. The Carter-Tracy aquifers
+    // come first, followed by the Fetkovich ones. A value of -1 means that
+    // the cell is not connected, -2 that it is connected to several aquifers.
+    std::vector<int> cellToAquifer_;
+
     // This initialization function is used to connect the parser objects with the ones needed by AquiferCarterTracy
     void init();
 
+    void updateCellToAquifer_();
+
     bool aquiferActive() const;
     bool aquiferCarterTracyActive() const;
     bool aquiferFetkovichActive() const;
@@ -55,6 +55,8 @@ BlackoilAquiferModel<TypeTag>::initialSolutionApplied()
             aquifer.initialSolutionApplied();
         }
     }
+
+    this->updateCellToAquifer_();
 }
 
 template <typename TypeTag>
@@ -88,7 +90,18 @@ BlackoilAquiferModel<TypeTag>::beginEpisode()
 template <typename TypeTag>
 void
 BlackoilAquiferModel<TypeTag>::beginIteration()
-{}
+{
+    if (aquiferCarterTracyActive()) {
+        for (auto& aquifer : aquifers_CarterTracy) {
+            aquifer.beginIteration();
+        }
+    }
+    if (aquiferFetkovichActive()) {
+        for (auto& aquifer : aquifers_Fetkovich) {
+            aquifer.beginIteration();
+        }
+    }
+}
 
 template <typename TypeTag>
 void
@@ -114,6 +127,24 @@ BlackoilAquiferModel<TypeTag>::addToSource(RateVector& rates,
                                            unsigned spaceIdx,
                                            unsigned timeIdx) const
 {
+    if (this->cellToAquifer_.empty())
+        return;
+
+    const unsigned cellIdx = context.globalSpaceIndex(spaceIdx, timeIdx);
+    const int aquiferIdx = this->cellToAquifer_[cellIdx];
+    if (aquiferIdx == -1)
+        return;
+
+    if (aquiferIdx >= 0) {
+        const int numCarterTracy = aquifers_CarterTracy.size();
+        if (aquiferIdx < numCarterTracy)
+            aquifers_CarterTracy[aquiferIdx].addToSource(rates, context, spaceIdx, timeIdx);
+        else
+            aquifers_Fetkovich[aquiferIdx - numCarterTracy].addToSource(rates, context, spaceIdx, timeIdx);
+        return;
+    }
+
+    // the cell is connected to more than one aquifer
     if (aquiferCarterTracyActive()) {
         for (auto& aquifer : aquifers_CarterTracy) {
             aquifer.addToSource(rates, context, spaceIdx, timeIdx);
@@ -213,6 +244,35 @@ BlackoilAquiferModel<TypeTag>::init()
     }
 }
 
+template <typename TypeTag>
+void
+BlackoilAquiferModel<TypeTag>::updateCellToAquifer_()
+{
+    this->cellToAquifer_.clear();
+    if (!aquiferCarterTracyActive() && !aquiferFetkovichActive())
+        return;
+
+    const unsigned numCells = this->simulator_.gridView().size(/*codim=*/0);
+    this->cellToAquifer_.resize(numCells, -1);
+
+    const auto addConnections = [this, numCells](const auto& aquifer, int aquiferIdx)
+    {
+        for (unsigned cellIdx = 0; cellIdx < numCells; ++cellIdx) {
+            if (aquifer.connectionIndex(cellIdx) < 0)
+                continue;
+
+            auto& cellAquifer = this->cellToAquifer_[cellIdx];
+            cellAquifer = (cellAquifer == -1) ? aquiferIdx : -2;
+        }
+    };
+
+    int aquiferIdx = 0;
+    for (const auto& aquifer : aquifers_CarterTracy)
+        addConnections(aquifer, aquiferIdx++);
+    for (const auto& aquifer : aquifers_Fetkovich)
+        addConnections(aquifer, aquiferIdx++);
+}
+
 template <typename TypeTag>
 bool
 BlackoilAquiferModel<TypeTag>::aquiferCarterTracyActive() const
@@ -29,6 +29,7 @@
 #include <opm/simulators/utils/ParallelFileMerger.hpp>
 #include <opm/simulators/utils/moduleVersion.hpp>
 #include <opm/simulators/utils/ParallelEclipseState.hpp>
+#include <opm/simulators/utils/StartupTimings.hpp>
 
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 #include <opm/parser/eclipse/EclipseState/IOConfig/IOConfig.hpp>
@@ -498,9 +499,18 @@ namespace Opm
 
         void setupEbosSimulator()
         {
+            Dune::Timer setupTimer;
             ebosSimulator_.reset(new EbosSimulator(/*verbose=*/false));
             ebosSimulator_->executionTimer().start();
-            ebosSimulator_->model().applyInitialSolution();
+            {
+                StartupPhaseTimer timer("Applying initial solution");
+                ebosSimulator_->model().applyInitialSolution();
+            }
+
+            if (this->output_cout_) {
+                StartupTimings::report(ebosSimulator_->vanguard().externalSetupTime()
+                                       + setupTimer.elapsed());
+            }
 
             try {
                 // Possible to force initialization only behavior (NOSIM).
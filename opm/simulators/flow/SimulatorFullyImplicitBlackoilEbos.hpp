@@ -181,8 +181,20 @@ public:
                 // For restarts the ebosSimulator may have gotten some information
                 // about the next timestep size from the OPMEXTRA field
                 adaptiveTimeStepping_->setSuggestedNextStep(ebosSimulator_.timeStepSize());
+
+                // a checkpoint additionally holds the state of the time step
+                // control and may have been written within a report step
+                const auto& problem = ebosSimulator_.problem();
+                if (!problem.timeStepControlState().empty())
+                    adaptiveTimeStepping_->setTimeStepControlState(problem.timeStepControlState());
+                if (problem.subStepRestartTime() >= 0.0)
+                    adaptiveTimeStepping_->resumeAt(problem.subStepRestartTime(), ebosSimulator_.timeStepSize());
             }
         }
+        else if (isRestart() && ebosSimulator_.problem().subStepRestartTime() >= 0.0) {
+            throw std::runtime_error("Restarting from a checkpoint written after a sub step "
+                                     "requires adaptive time stepping");
+        }
     }
 
     bool runStep(SimulatorTimer& timer)
@@ -268,6 +280,8 @@ public:
         perfTimer.start();
         const double nextstep = adaptiveTimeStepping_ ? adaptiveTimeStepping_->suggestedNextStep() : -1.0;
         ebosSimulator_.problem().setNextTimeStepSize(nextstep);
+        if (adaptiveTimeStepping_)
+            ebosSimulator_.problem().setTimeStepControlState(adaptiveTimeStepping_->timeStepControlState());
         ebosSimulator_.problem().writeOutput();
         report_.success.output_write_time += perfTimer.stop();
 
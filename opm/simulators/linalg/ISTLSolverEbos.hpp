@@ -27,6 +27,7 @@
 #include <opm/simulators/linalg/ExtractParallelGridInformationToISTL.hpp>
 #include <opm/simulators/linalg/FlexibleSolver.hpp>
 #include <opm/simulators/linalg/MatrixBlock.hpp>
+#include <opm/simulators/linalg/NumericalAquiferCondensation.hpp>
 #include <opm/simulators/linalg/ParallelIstlInformation.hpp>
 #include <opm/simulators/linalg/WellOperators.hpp>
 #include <opm/simulators/linalg/WriteSystemMatrixHelper.hpp>
@@ -34,6 +35,9 @@
 #include <opm/simulators/linalg/getQuasiImpesWeights.hpp>
 #include <opm/simulators/linalg/setupPropertyTree.hpp>
 
+#include <cstddef>
+#include <unordered_set>
+#include <vector>
 
 #if HAVE_CUDA || HAVE_OPENCL || HAVE_FPGA
 #include <opm/simulators/linalg/bda/BdaBridge.hpp>
@@ -91,6 +95,7 @@ namespace Opm
         using AbstractOperatorType = Dune::AssembledLinearOperator<Matrix, Vector, Vector>;
         using WellModelOperator = WellModelAsLinearOperator<WellModel, Vector, Vector>;
         using ElementMapper = GetPropType<TypeTag, Properties::ElementMapper>;
+        using AquiferCondensation = NumericalAquiferCondensation<Matrix, Vector>;
 
 #if HAVE_CUDA || HAVE_OPENCL || HAVE_FPGA
         static const unsigned int block_size = Matrix::block_type::rows;
@@ -178,6 +183,10 @@ namespace Opm
 
             interiorCellNum_ = detail::numMatrixRowsToUseInSolver(simulator_.vanguard().grid(), true);
 
+            if (parameters_.eliminate_numerical_aquifers_) {
+                setupAquiferCondensation(elemMapper);
+            }
+
             // Print parameters to PRT/DBG logs.
             if (on_io_rank) {
                 std::ostringstream os;
@@ -222,6 +231,9 @@ namespace Opm
             if (isParallel() && prm_.get<std::string>("preconditioner.type") != "ParOverILU0") {
                 makeOverlapRowsInvalid(getMatrix());
             }
+            if (aquiferCondensation_) {
+                aquiferCondensation_->condense(getMatrix(), *rhs_);
+            }
             prepareFlexibleSolver();
             firstcall = false;
         }
@@ -292,6 +304,16 @@ namespace Opm
                 flexibleSolver_->apply(x, *rhs_, result);
             }
 
+            // Solution of the eliminated numerical aquifer cells.
+            if (aquiferCondensation_) {
+                aquiferCondensation_->recover(x);
+#if HAVE_MPI
+                if (isParallel()) {
+                    comm_->copyOwnerToAll(x, x);
+                }
+#endif
+            }
+
             // Check convergence, iterations etc.
             checkConvergence(result);
 
@@ -349,6 +371,54 @@ namespace Opm
 #endif
         }
 
+        /// Collect the cells of the numerical aquifers which may be
+        /// eliminated from the linear system. Only cells which are
+        /// interior to this process and which are not perforated by any
+        /// well are considered.
+        void setupAquiferCondensation(const ElementMapper& elemMapper)
+        {
+            const auto& aquifer = simulator_.vanguard().eclState().aquifer();
+            if (!aquifer.hasNumericalAquifer()) {
+                return;
+            }
+
+            const auto& gridView = simulator_.vanguard().gridView();
+            std::vector<bool> isInterior(gridView.size(0), false);
+            for (const auto& elem : elements(gridView)) {
+                if (elem.partitionType() == Dune::InteriorEntity) {
+                    isInterior[elemMapper.index(elem)] = true;
+                }
+            }
+
+            // The well contributions are not part of the matrix unless
+            // they are added explicitly, so the condensation can not see
+            // them. Connections are only ever added to a well, hence the
+            // wells at the end of the schedule have all of them.
+            std::unordered_set<std::size_t> perforated;
+            for (const auto& well : simulator_.vanguard().schedule().getWellsatEnd()) {
+                for (const auto& connection : well.getConnections()) {
+                    perforated.insert(connection.global_index());
+                }
+            }
+
+            std::vector<std::vector<int>> chains;
+            for ([[maybe_unused]] const auto& [id, aqu] : aquifer.numericalAquifers().aquifers()) {
+                std::vector<int> chain(aqu.numCells(), -1);
+                for (size_t idx = 0; idx < aqu.numCells(); ++idx) {
+                    const auto globalIndex = aqu.getCellPrt(idx)->global_index;
+                    if (perforated.count(globalIndex) > 0) {
+                        continue;
+                    }
+                    const int cell = simulator_.vanguard().compressedIndex(globalIndex);
+                    if (cell >= 0 && isInterior[cell]) {
+                        chain[idx] = cell;
+                    }
+                }
+                chains.push_back(std::move(chain));
+            }
+            aquiferCondensation_ = std::make_unique<AquiferCondensation>(std::move(chains));
+        }
+
         void prepareFlexibleSolver()
         {
 
@@ -508,6 +578,7 @@ namespace Opm
         std::unique_ptr<FlexibleSolverType> flexibleSolver_;
         std::unique_ptr<AbstractOperatorType> linearOperatorForFlexibleSolver_;
         std::unique_ptr<WellModelAsLinearOperator<WellModel, Vector, Vector>> wellOperator_;
+        std::unique_ptr<AquiferCondensation> aquiferCondensation_;
         std::vector<int> overlapRows_;
         std::vector<int> interiorRows_;
         std::vector<std::set<int>> wellConnectionsGraph_;
@@ -0,0 +1,229 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_NUMERICALAQUIFERCONDENSATION_HEADER_INCLUDED
+#define OPM_NUMERICALAQUIFERCONDENSATION_HEADER_INCLUDED
+
+#include <opm/common/ErrorMacros.hpp>
+#include <opm/common/Exceptions.hpp>
+
+#include <dune/common/fmatrix.hh>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace Opm
+{
+
+/// Eliminates one-dimensional chains of numerical aquifer cells from a
+/// block-structured linear system by static condensation.
+///
+/// A numerical aquifer is a chain of cells where only the first cell is
+/// connected to the reservoir. The cells behind the first one are
+/// eliminated from the end of the chain towards its start, which only
+/// modifies the diagonal block and right hand side of the preceding chain
+/// cell. The sparsity pattern of the system is thus unchanged, and the
+/// rows of the eliminated cells are replaced by identity rows with a zero
+/// right hand side. After the reduced system has been solved, recover()
+/// computes the solution of the eliminated cells by back substitution.
+///
+/// A chain is only condensed behind the last cell which has couplings to
+/// cells outside of the chain, so cells which are connected to the
+/// reservoir by other means are kept in the system. Wells whose
+/// contributions are not part of the matrix are not seen by the
+/// condensation, so the eliminated cells must not be perforated by them.
+/// The sparsity pattern of the matrix is assumed to be structurally
+/// symmetric.
+template <class Matrix, class Vector>
+class NumericalAquiferCondensation
+{
+public:
+    using Block = typename Matrix::block_type;
+    using VectorBlock = typename Vector::block_type;
+
+    /// \param chains The local matrix rows of the cells of each aquifer in
+    ///               the order of the chain, starting with the cell next to
+    ///               the reservoir. Cells which may not be eliminated, e.g.
+    ///               because they are not interior to this process, are
+    ///               given as -1.
+    explicit NumericalAquiferCondensation(std::vector<std::vector<int>> chains)
+        : chains_(std::move(chains))
+    {
+        tails_.resize(chains_.size());
+    }
+
+    /// Eliminate the chain tails from the system. The matrix and the right
+    /// hand side are modified in place.
+    void condense(Matrix& A, Vector& b)
+    {
+        for (std::size_t chainIdx = 0; chainIdx < chains_.size(); ++chainIdx)
+            condenseChain_(chains_[chainIdx], tails_[chainIdx], A, b);
+    }
+
+    /// Compute the solution of the eliminated cells from the solution of
+    /// the reduced system.
+    void recover(Vector& x) const
+    {
+        for (const auto& tail : tails_) {
+            // back substitution in the order of the chain
+            for (std::size_t k = 0; k < tail.invDiag.size(); ++k) {
+                VectorBlock rhs = tail.rhs[k];
+                tail.lower[k].mmv(x[tail.cells[k]], rhs);
+                tail.invDiag[k].mv(rhs, x[tail.cells[k + 1]]);
+            }
+        }
+    }
+
+    /// The number of cells which were eliminated by the last condensation.
+    std::size_t numEliminatedCells() const
+    {
+        std::size_t n = 0;
+        for (const auto& tail : tails_)
+            n += tail.invDiag.size();
+        return n;
+    }
+
+private:
+    // Elimination factors of the condensed part of a chain. cells[0] is the
+    // cell the tail was condensed into, the remaining entries are the
+    // eliminated cells. The factors of eliminated cell k + 1 are stored at
+    // position k: the inverse of its condensed diagonal block, its coupling
+    // to the preceding cell and its condensed right hand side.
+    struct Tail
+    {
+        std::vector<int> cells;
+        std::vector<Block> invDiag;
+        std::vector<Block> lower;
+        std::vector<VectorBlock> rhs;
+    };
+
+    static bool isZero_(const Block& block)
+    {
+        return block.infinity_norm() == 0.0;
+    }
+
+    // check that the only couplings of a cell are to its chain neighbours
+    static bool onlyChainCouplings_(const Matrix& A, int cell, int prev, int next)
+    {
+        const auto& row = A[cell];
+        for (auto colIt = row.begin(); colIt != row.end(); ++colIt) {
+            const int col = colIt.index();
+            if (col == cell || col == prev || col == next)
+                continue;
+
+            if (!isZero_(*colIt))
+                return false;
+
+            const auto& otherRow = A[col];
+            const auto transposedIt = otherRow.find(cell);
+            if (transposedIt != otherRow.end() && !isZero_(*transposedIt))
+                return false;
+        }
+
+        return true;
+    }
+
+    void condenseChain_(const std::vector<int>& chain, Tail& tail, Matrix& A, Vector& b) const
+    {
+        tail.cells.clear();
+        tail.invDiag.clear();
+        tail.lower.clear();
+        tail.rhs.clear();
+
+        // find the part of the chain which can be eliminated. the first cell
+        // of the chain is coupled to the reservoir, so it is always kept.
+        const std::size_t n = chain.size();
+        std::size_t first = n;
+        while (first > 1) {
+            const std::size_t k = first - 1;
+            const int next = (k + 1 < n) ? chain[k + 1] : -1;
+            if (chain[k] < 0 || chain[k - 1] < 0
+                || !onlyChainCouplings_(A, chain[k], chain[k - 1], next))
+                break;
+
+            first = k;
+        }
+
+        if (first == n)
+            return;
+
+        tail.cells.assign(chain.begin() + first - 1, chain.end());
+        const std::size_t numEliminated = n - first;
+        tail.invDiag.resize(numEliminated);
+        tail.lower.resize(numEliminated);
+        tail.rhs.resize(numEliminated);
+
+        Block identity(0.0);
+        for (int i = 0; i < Block::rows; ++i)
+            identity[i][i] = 1.0;
+
+        // eliminate from the end of the chain towards its start
+        for (std::size_t k = numEliminated; k > 0; --k) {
+            const int cell = tail.cells[k];
+            const int prev = tail.cells[k - 1];
+            auto& row = A[cell];
+
+            Block& invDiag = tail.invDiag[k - 1];
+            invDiag = row[cell];
+            try {
+                invDiag.invert();
+            }
+            catch (const Dune::FMatrixError&) {
+                OPM_THROW_NOLOG(NumericalIssue,
+                                "Singular diagonal block while eliminating numerical aquifer cell "
+                                << cell);
+            }
+
+            const auto lowerIt = row.find(prev);
+            if (lowerIt != row.end())
+                tail.lower[k - 1] = *lowerIt;
+            else
+                tail.lower[k - 1] = 0.0;
+            tail.rhs[k - 1] = b[cell];
+
+            // update the preceding cell with the Schur complement of this one
+            auto& prevRow = A[prev];
+            const auto upperIt = prevRow.find(cell);
+            if (upperIt != prevRow.end()) {
+                Block upperInvDiag = *upperIt;
+                upperInvDiag.rightmultiply(invDiag);
+
+                Block update = tail.lower[k - 1];
+                update.leftmultiply(upperInvDiag);
+                prevRow[prev] -= update;
+                upperInvDiag.mmv(tail.rhs[k - 1], b[prev]);
+
+                *upperIt = 0.0;
+            }
+
+            // decouple the eliminated cell from the reduced system
+            row = 0.0;
+            row[cell] = identity;
+            b[cell] = 0.0;
+        }
+    }
+
+    std::vector<std::vector<int>> chains_;
+    std::vector<Tail> tails_;
+};
+
+} // namespace Opm
+
+#endif // OPM_NUMERICALAQUIFERCONDENSATION_HEADER_INCLUDED
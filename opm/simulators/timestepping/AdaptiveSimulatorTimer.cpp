@@ -99,6 +99,17 @@ AdaptiveSimulatorTimer& AdaptiveSimulatorTimer::operator++ ()
         }
     }
 
+    void AdaptiveSimulatorTimer::
+    resume( const double time, const double dt_estimate )
+    {
+        assert( time >= start_time_ && time < total_time_ );
+        current_time_ = time;
+        // the sub steps taken before are not known, the step is only marked
+        // as not being the first one of the report step
+        current_step_ = 1;
+        provideTimeStepEstimate( dt_estimate );
+    }
+
     int AdaptiveSimulatorTimer::
     currentStepNum () const { return current_step_; }
 
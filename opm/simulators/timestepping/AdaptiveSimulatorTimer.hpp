@@ -57,6 +57,12 @@ namespace Opm
         /// \brief provide and estimate for new time step size
         void provideTimeStepEstimate( const double dt_estimate );
 
+        /// \brief continue the sub stepping from a time reached by an earlier run,
+        ///        e.g. when restarting from a checkpoint written after a sub step
+        ///  \param time        time elapsed since the start of the simulation
+        ///  \param dt_estimate estimate for the size of the next sub step
+        void resume( const double time, const double dt_estimate );
+
         /// \brief Whether this is the first step
         bool initialStep () const;
 
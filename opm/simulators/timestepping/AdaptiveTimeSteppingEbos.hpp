@@ -5,6 +5,7 @@
 
 #include <iostream>
 #include <utility>
+#include <vector>
 
 #include <opm/simulators/timestepping/SimulatorReport.hpp>
 #include <opm/grid/utility/StopWatch.hpp>
@@ -381,6 +382,10 @@ namespace Opm {
 
             // create adaptive step timer with previously used sub step size
             AdaptiveSimulatorTimer substepTimer(simulatorTimer, suggestedNextTimestep_, maxTimeStep_);
+            if (resumeTime_ >= 0.0) {
+                substepTimer.resume(resumeTime_, resumeTimeStep_);
+                resumeTime_ = -1.0;
+            }
 
             // counter for solver restarts
             int restarts = 0;
@@ -492,6 +497,9 @@ namespace Opm {
                         time::StopWatch perfTimer;
                         perfTimer.start();
 
+                        // a checkpoint written here needs to know how to continue
+                        ebosProblem.setNextTimeStepSize(dtEstimate);
+                        ebosProblem.setTimeStepControlState(timeStepControl_->state());
                         ebosProblem.writeOutput();
 
                         report.success.output_write_time += perfTimer.secsSinceStart();
@@ -612,6 +620,27 @@ namespace Opm {
         void setSuggestedNextStep(const double x)
         { suggestedNextTimestep_ = x; }
 
+        /** \brief Returns the state of the time step control which is carried
+         *         over from one time step to the next.
+         */
+        std::vector<double> timeStepControlState() const
+        { return timeStepControl_->state(); }
+
+        void setTimeStepControlState(const std::vector<double>& state)
+        { timeStepControl_->setState(state); }
+
+        /** \brief Let the next call of step() continue the report step at the
+         *         given time instead of starting at its beginning.
+         *
+         * \param time       time elapsed since the start of the simulation
+         * \param dtEstimate estimate for the size of the next sub step
+         */
+        void resumeAt(const double time, const double dtEstimate)
+        {
+            resumeTime_ = time;
+            resumeTimeStep_ = dtEstimate;
+        }
+
         void updateTUNING(const Tuning& tuning)
         {
             restartFactor_ = tuning.TSFCNV;
@@ -744,6 +773,8 @@ namespace Opm {
         double timestepAfterEvent_;         //!< suggested size of timestep after an event
         bool useNewtonIteration_;           //!< use newton iteration count for adaptive time step control
         double minTimeStepBeforeShuttingProblematicWells_; //! < shut problematic wells when time step size in days are less than this
+        double resumeTime_ = -1.0;          //!< time at which the next report step is resumed, negative if it starts at its beginning
+        double resumeTimeStep_ = -1.0;      //!< size of the first sub step when resuming a report step
     };
 }
 
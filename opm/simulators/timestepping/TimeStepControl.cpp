@@ -124,6 +124,15 @@ namespace Opm
         , verbose_( verbose )
     {}
 
+    void PIDTimeStepControl::
+    setState( const std::vector<double>& state )
+    {
+        if( state.size() != errors_.size() )
+            OPM_THROW(std::runtime_error, "The state of the PID time step control must hold "
+                      << errors_.size() << " errors, got " << state.size());
+        errors_ = state;
+    }
+
     double PIDTimeStepControl::
     computeTimeStepSize( const double dt, const int /* iterations */, const RelativeChangeInterface& relChange, const double /*simulationTimeElapsed */) const
     {
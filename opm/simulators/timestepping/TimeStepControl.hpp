@@ -82,6 +82,12 @@ namespace Opm
         /// \brief \copydoc TimeStepControlInterface::computeTimeStepSize
         double computeTimeStepSize( const double dt, const int /* iterations */, const RelativeChangeInterface& relativeChange, const double /*simulationTimeElapsed */ ) const;
 
+        /// \brief \copydoc TimeStepControlInterface::state
+        std::vector<double> state() const { return errors_; }
+
+        /// \brief \copydoc TimeStepControlInterface::setState
+        void setState( const std::vector<double>& state );
+
     protected:
         const double tol_;
         mutable std::vector< double > errors_;
@@ -19,6 +19,7 @@
 #ifndef OPM_TIMESTEPCONTROLINTERFACE_HEADER_INCLUDED
 #define OPM_TIMESTEPCONTROLINTERFACE_HEADER_INCLUDED
 
+#include <vector>
 
 namespace Opm
 {
@@ -58,6 +59,13 @@ namespace Opm
         /// \return suggested time step size for the next step
         virtual double computeTimeStepSize( const double dt, const int iterations, const RelativeChangeInterface& relativeChange , const double simulationTimeElapsed) const = 0;
 
+        /// \return the state carried over from one time step to the next,
+        ///         e.g. for storing it in a checkpoint (empty if there is none)
+        virtual std::vector<double> state() const { return {}; }
+
+        /// restore a state returned by state()
+        virtual void setState( const std::vector<double>& /* state */ ) {}
+
         /// virtual destructor (empty)
         virtual ~TimeStepControlInterface () {}
     };
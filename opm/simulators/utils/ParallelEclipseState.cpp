@@ -22,6 +22,10 @@
 
 #include <opm/common/ErrorMacros.hpp>
 
+#include <numeric>
+#include <type_traits>
+#include <utility>
+
 namespace Opm {
 
 
@@ -55,19 +59,14 @@ std::vector<double> ParallelFieldPropsManager::porv(bool global) const
     if (m_comm.rank() == 0)
         global_porv = m_manager.porv(true);
 
+    if (!global)
+        return this->scatterToLocal(global_porv);
+
     size_t size = global_porv.size();
     m_comm.broadcast(&size, 1, 0);
     global_porv.resize(size);
     m_comm.broadcast(global_porv.data(), size, 0);
-    if (global)
-        return global_porv;
-
-    std::vector<double> local_porv(this->m_activeSize());
-    for (int i = 0; i < m_activeSize(); ++i)
-    {
-        local_porv[i] = global_porv[this->m_local2Global(i)];
-    }
-    return local_porv;
+    return global_porv;
 }
 
 
@@ -77,16 +76,11 @@ const std::vector<int>& ParallelFieldPropsManager::get_int(const std::string& ke
     if (it == m_intProps.end())
     {
         // Some of the keywords might be defaulted.
-        // We will let rank 0 create them and distribute them using get_global_int
-        auto data = get_global_int(keyword);
+        // We will let rank 0 create them and send each process its own cells.
+        auto data = this->scatterToLocal(this->rootGlobalProperty<int>(keyword));
         auto& local_data = const_cast<std::map<std::string, Fieldprops::FieldData<int>>&>(m_intProps)[keyword];
-        local_data.data.resize(m_activeSize());
-        local_data.value_status.resize(m_activeSize());
-
-        for (int i = 0; i < m_activeSize(); ++i)
-        {
-            local_data.data[i] = data[m_local2Global(i)];
-        }
+        local_data.value_status.resize(data.size());
+        local_data.data = std::move(data);
         return local_data.data;
     }
 
@@ -95,26 +89,7 @@ const std::vector<int>& ParallelFieldPropsManager::get_int(const std::string& ke
 
 std::vector<int> ParallelFieldPropsManager::get_global_int(const std::string& keyword) const
 {
-    std::vector<int> result;
-    int exceptionThrown{};
-
-    if (m_comm.rank() == 0)
-    {
-        try
-        {
-            result = m_manager.get_global_int(keyword);
-        }catch(std::exception& e) {
-            exceptionThrown = 1;
-            OpmLog::error("No integer property field: " + keyword + " ("+e.what()+")");
-            m_comm.broadcast(&exceptionThrown, 1, 0);
-            throw e;
-        }
-    }
-
-    m_comm.broadcast(&exceptionThrown, 1, 0);
-
-    if (exceptionThrown)
-        OPM_THROW_NOLOG(std::runtime_error, "No integer property field: " + keyword);
+    std::vector<int> result = this->rootGlobalProperty<int>(keyword);
 
     size_t size = result.size();
     m_comm.broadcast(&size, 1, 0);
@@ -131,15 +106,11 @@ const std::vector<double>& ParallelFieldPropsManager::get_double(const std::stri
     if (it == m_doubleProps.end())
     {
         // Some of the keywords might be defaulted.
-        // We will let rank 0 create them and distribute them using get_global_int
-        auto data = get_global_double(keyword);
+        // We will let rank 0 create them and send each process its own cells.
+        auto data = this->scatterToLocal(this->rootGlobalProperty<double>(keyword));
         auto& local_data = const_cast<std::map<std::string, Fieldprops::FieldData<double>>&>(m_doubleProps)[keyword];
-        local_data.data.resize(m_activeSize());
-        local_data.value_status.resize(m_activeSize());
-        for (int i = 0; i < m_activeSize(); ++i)
-        {
-            local_data.data[i] = data[m_local2Global(i)];
-        }
+        local_data.value_status.resize(data.size());
+        local_data.data = std::move(data);
         return local_data.data;
     }
 
@@ -149,35 +120,94 @@ const std::vector<double>& ParallelFieldPropsManager::get_double(const std::stri
 
 std::vector<double> ParallelFieldPropsManager::get_global_double(const std::string& keyword) const
 {
-    std::vector<double> result;
+    std::vector<double> result = this->rootGlobalProperty<double>(keyword);
+
+    size_t size = result.size();
+    m_comm.broadcast(&size, 1, 0);
+    result.resize(size);
+    m_comm.broadcast(result.data(), size, 0);
+
+    return result;
+}
+
+
+template<class T>
+std::vector<T> ParallelFieldPropsManager::rootGlobalProperty(const std::string& keyword) const
+{
+    constexpr const char* kind = std::is_same_v<T, int> ? "integer" : "double";
+    std::vector<T> result;
     int exceptionThrown{};
 
     if (m_comm.rank() == 0)
     {
         try
         {
-            result = m_manager.get_global_double(keyword);
+            if constexpr (std::is_same_v<T, int>)
+                result = m_manager.get_global_int(keyword);
+            else
+                result = m_manager.get_global_double(keyword);
         }catch(std::exception& e) {
             exceptionThrown = 1;
-            OpmLog::error("No double property field: " + keyword + " ("+e.what()+")");
+            OpmLog::error(std::string("No ") + kind + " property field: " + keyword + " ("+e.what()+")");
             m_comm.broadcast(&exceptionThrown, 1, 0);
-            throw e;
+            throw;
         }
     }
 
     m_comm.broadcast(&exceptionThrown, 1, 0);
 
     if (exceptionThrown)
-        OPM_THROW_NOLOG(std::runtime_error, "No double property field: " + keyword);
-
-    size_t size = result.size();
-    m_comm.broadcast(&size, 1, 0);
-    result.resize(size);
-    m_comm.broadcast(result.data(), size, 0);
+        OPM_THROW_NOLOG(std::runtime_error, std::string("No ") + kind + " property field: " + keyword);
 
     return result;
 }
 
+
+void ParallelFieldPropsManager::setupScatter() const
+{
+    if (m_scatterReady)
+        return;
+
+    std::vector<int> localIndices(m_activeSize());
+    for (int i = 0; i < m_activeSize(); ++i)
+        localIndices[i] = m_local2Global(i);
+
+    int size = localIndices.size();
+    if (m_comm.rank() == 0) {
+        m_scatterCounts.resize(m_comm.size());
+        m_scatterDispl.assign(m_comm.size() + 1, 0);
+    }
+    m_comm.gather(&size, m_scatterCounts.data(), 1, 0);
+    if (m_comm.rank() == 0) {
+        std::partial_sum(m_scatterCounts.begin(), m_scatterCounts.end(),
+                         m_scatterDispl.begin() + 1);
+        m_scatterIndices.resize(m_scatterDispl.back());
+    }
+    m_comm.gatherv(localIndices.data(), size, m_scatterIndices.data(),
+                   m_scatterCounts.data(), m_scatterDispl.data(), 0);
+
+    m_scatterReady = true;
+}
+
+
+template<class T>
+std::vector<T> ParallelFieldPropsManager::scatterToLocal(const std::vector<T>& global) const
+{
+    this->setupScatter();
+
+    std::vector<T> sendBuffer;
+    if (m_comm.rank() == 0) {
+        sendBuffer.resize(m_scatterIndices.size());
+        for (size_t i = 0; i < m_scatterIndices.size(); ++i)
+            sendBuffer[i] = global[m_scatterIndices[i]];
+    }
+
+    std::vector<T> local(m_activeSize());
+    m_comm.scatterv(sendBuffer.data(), m_scatterCounts.data(), m_scatterDispl.data(),
+                    local.data(), static_cast<int>(local.size()), 0);
+    return local;
+}
+
 bool ParallelFieldPropsManager::tran_active(const std::string& keyword) const
 {
     auto calculator = m_tran.find(keyword);
@@ -95,6 +95,7 @@ public:
         m_activeSize = std::bind(&T::compressedSize, mapper);
         m_local2Global = std::bind(&T::cartesianIndex, mapper,
                                    std::placeholders::_1);
+        m_scatterReady = false;
     }
 
     bool tran_active(const std::string& keyword) const override;
@@ -103,6 +104,20 @@ public:
 
     void deserialize_tran(const std::vector<char>& buffer) override;
 protected:
+    //! \brief Returns a global property on the root process and an empty vector elsewhere.
+    //! \details Throws on all processes if the property is not available.
+    template<class T>
+    std::vector<T> rootGlobalProperty(const std::string& keyword) const;
+
+    //! \brief Gathers the cartesian indices of all process-local cells on the root process.
+    void setupScatter() const;
+
+    //! \brief Sends every process the values of a global property for its own cells.
+    //! \param global Property in global cartesian indices (only used on root process)
+    //! \details The global vector is never materialized on non-root processes.
+    template<class T>
+    std::vector<T> scatterToLocal(const std::vector<T>& global) const;
+
     std::map<std::string, Fieldprops::FieldData<int>> m_intProps; //!< Map of integer properties in process-local compressed indices.
     std::map<std::string, Fieldprops::FieldData<double>> m_doubleProps; //!< Map of double properties in process-local compressed indices.
     FieldPropsManager& m_manager; //!< Underlying field property manager (only used on root process).
@@ -110,6 +125,10 @@ protected:
     std::function<int(void)> m_activeSize; //!< active size function of the grid
     std::function<int(const int)> m_local2Global; //!< mapping from local to global cartesian indices
     std::unordered_map<std::string, Fieldprops::TranCalculator> m_tran; //!< calculators map
+    mutable bool m_scatterReady = false; //!< True if the scatter pattern below is set up
+    mutable std::vector<int> m_scatterCounts; //!< Number of cells per process (only on root process)
+    mutable std::vector<int> m_scatterDispl; //!< Offsets of the processes in m_scatterIndices (only on root process)
+    mutable std::vector<int> m_scatterIndices; //!< Cartesian indices of the cells of all processes (only on root process)
 };
 
 
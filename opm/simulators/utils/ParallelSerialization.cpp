@@ -33,19 +33,51 @@
 #include <opm/parser/eclipse/EclipseState/Schedule/Well/WListManager.hpp>
 #include <opm/parser/eclipse/EclipseState/SummaryConfig/SummaryConfig.hpp>
 
+#include <opm/common/OpmLog/OpmLog.hpp>
+
 #include <ebos/eclmpiserializer.hh>
 
 #include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/timer.hh>
+
+#include <fmt/format.h>
+
+#include <string>
 
 namespace Opm {
 
 void eclStateBroadcast(EclipseState& eclState, Schedule& schedule,
                        SummaryConfig& summaryConfig)
 {
-    Opm::EclMpiSerializer ser(Dune::MPIHelper::getCollectiveCommunication());
-    ser.broadcast(eclState);
-    ser.broadcast(schedule);
-    ser.broadcast(summaryConfig);
+    const auto& comm = Dune::MPIHelper::getCollectiveCommunication();
+    if (comm.size() == 1)
+        return;
+
+    Opm::EclMpiSerializer ser(comm);
+    Dune::Timer timer;
+    double bytes = 0.0;
+    auto broadcastTimed = [&ser, &timer, &bytes](const std::string& name, auto& data)
+    {
+        timer.reset();
+        ser.broadcast(data);
+        bytes += ser.position();
+        OpmLog::debug(fmt::format("Broadcast of {}: {:.1f} MiB in {:.2f} seconds",
+                                  name, ser.position() / (1024.0 * 1024.0),
+                                  timer.elapsed()));
+        return timer.elapsed();
+    };
+
+    double elapsed = broadcastTimed("EclipseState", eclState);
+    elapsed += broadcastTimed("Schedule", schedule);
+    elapsed += broadcastTimed("SummaryConfig", summaryConfig);
+
+    // The slowest process determines the startup time.
+    elapsed = comm.max(elapsed);
+    if (comm.rank() == 0) {
+        OpmLog::info(fmt::format("Broadcasting the input to {} processes: "
+                                 "{:.1f} MiB in {:.2f} seconds",
+                                 comm.size(), bytes / (1024.0 * 1024.0), elapsed));
+    }
 }
 
 void eclScheduleBroadcast(Schedule& schedule)
@@ -26,6 +26,7 @@ class Schedule;
 class SummaryConfig;
 
 /*! \brief Broadcasts an eclipse state from root node in parallel runs.
+ *! \details The amount of data and the time spent are written to the log.
  *! \param eclState EclipseState to broadcast
  *! \param schedule Schedule to broadcast
  *! \param summaryConfig SummaryConfig to broadcast
@@ -0,0 +1,69 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/utils/StartupTimings.hpp>
+
+#include <opm/common/OpmLog/OpmLog.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+
+namespace Opm
+{
+
+std::vector<std::pair<std::string, double>> StartupTimings::phases_;
+
+void StartupTimings::add(const std::string& phase, double seconds)
+{
+    auto it = std::find_if(phases_.begin(), phases_.end(),
+                           [&phase](const auto& p) { return p.first == phase; });
+    if (it == phases_.end())
+        phases_.emplace_back(phase, seconds);
+    else
+        it->second += seconds;
+}
+
+const std::vector<std::pair<std::string, double>>& StartupTimings::phases()
+{
+    return phases_;
+}
+
+void StartupTimings::report(double totalSeconds)
+{
+    const auto percent = [totalSeconds](double seconds)
+    {
+        return totalSeconds > 0.0 ? 100.0 * seconds / totalSeconds : 0.0;
+    };
+
+    std::string msg = "Startup time breakdown:";
+    double covered = 0.0;
+    for (const auto& [phase, seconds] : phases_) {
+        msg += fmt::format("\n  {:<28} {:10.2f} s {:6.1f} %", phase, seconds, percent(seconds));
+        covered += seconds;
+    }
+    const double other = std::max(totalSeconds - covered, 0.0);
+    msg += fmt::format("\n  {:<28} {:10.2f} s {:6.1f} %", "Other", other, percent(other));
+    msg += fmt::format("\n  {:<28} {:10.2f} s", "Total", totalSeconds);
+
+    OpmLog::info(msg);
+}
+
+} // namespace Opm
@@ -0,0 +1,80 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_STARTUPTIMINGS_HEADER_INCLUDED
+#define OPM_STARTUPTIMINGS_HEADER_INCLUDED
+
+#include <dune/common/timer.hh>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Opm
+{
+
+/// \brief Wall-clock times of the phases of the simulator startup.
+///
+/// The phases are recorded process-wide in the order in which they are
+/// first reported. The components taking part in the setup (deck reading,
+/// grid processing, problem initialization) thus need not know of each
+/// other, and the breakdown is written to the log once the simulator is
+/// ready to run.
+class StartupTimings
+{
+public:
+    /// \brief Adds the time spent in a phase.
+    /// \details Times added several times for the same phase are accumulated.
+    static void add(const std::string& phase, double seconds);
+
+    /// \brief Returns the recorded phases and their times.
+    static const std::vector<std::pair<std::string, double>>& phases();
+
+    /// \brief Writes the time of each phase to the log.
+    /// \param totalSeconds Total startup time, the part not covered by any phase is reported separately.
+    static void report(double totalSeconds);
+
+private:
+    static std::vector<std::pair<std::string, double>> phases_;
+};
+
+/// \brief Adds the wall-clock time between its construction and destruction to a startup phase.
+class StartupPhaseTimer
+{
+public:
+    explicit StartupPhaseTimer(std::string phase)
+        : phase_(std::move(phase))
+    {}
+
+    ~StartupPhaseTimer()
+    {
+        StartupTimings::add(phase_, timer_.elapsed());
+    }
+
+    StartupPhaseTimer(const StartupPhaseTimer&) = delete;
+    StartupPhaseTimer& operator=(const StartupPhaseTimer&) = delete;
+
+private:
+    std::string phase_;
+    Dune::Timer timer_;
+};
+
+} // namespace Opm
+
+#endif // OPM_STARTUPTIMINGS_HEADER_INCLUDED
@@ -49,20 +49,34 @@
 
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/Parser/ErrorGuard.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
 
 #include "UnsupportedFlowKeywords.hpp"
 #include "PartiallySupportedFlowKeywords.hpp"
 #include <opm/simulators/flow/KeywordValidation.hpp>
 
+#include <opm/simulators/utils/moduleVersion.hpp>
 #include <opm/simulators/utils/ParallelEclipseState.hpp>
 #include <opm/simulators/utils/ParallelSerialization.hpp>
+#include <opm/simulators/utils/StartupTimings.hpp>
+
+#if HAVE_MPI
+#include <ebos/eclmpiserializer.hh>
+#endif
 
 #include <fmt/format.h>
 
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
+#include <fstream>
 #include <memory>
+#include <set>
+#include <string>
 #include <utility>
 
+#include <unistd.h>
+
 namespace Opm
 {
 
@@ -182,13 +196,301 @@ void setupMessageLimiter(const Opm::MessageLimits msgLimits,  const std::string&
                                             msgLimits.getBugPrintLimit()}};
     stream_log->setMessageLimiter(std::make_shared<Opm::MessageLimiter>(10, limits));
 }
+
+#if HAVE_MPI
+// The input cache file holds the parsed deck, Schedule and SummaryConfig
+// serialized by EclMpiSerializer. It is only valid for the simulator build
+// and the readDeck() options stored in its key, and for the exact contents
+// of all the files the deck was read from. The EclipseState is not cached as
+// its serialization leaves out the grid and the field properties, which are
+// only needed on this process; it is recreated from the cached deck.
+const std::string inputCacheMagic = "OPM-FLOW-INPUT-CACHE";
+
+// The version of the cache file layout. It must be increased whenever the
+// layout of the file or the set of cached objects changes.
+constexpr int inputCacheFormatVersion = 3;
+
+struct InputCacheData
+{
+    Opm::Deck& deck;
+    Opm::Schedule& schedule;
+    Opm::SummaryConfig& summaryConfig;
+
+    template<class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        deck.serializeOp(serializer);
+        schedule.serializeOp(serializer);
+        summaryConfig.serializeOp(serializer);
+    }
+};
+
+struct InputFileStamp
+{
+    std::string name;
+    std::uint64_t size = 0;
+    std::uint64_t hash = 0;
+};
+
+// 64-bit FNV-1a hash, continued from a previous value.
+constexpr std::uint64_t fnv1aOffsetBasis = 14695981039346656037ULL;
+
+std::uint64_t fnv1a(std::uint64_t hash, const char* data, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// The size and hash of a file's contents.
+std::optional<InputFileStamp> stampInputFile(const std::string& name)
+{
+    std::ifstream is(name, std::ios::binary);
+    if (!is)
+        return std::nullopt;
+
+    InputFileStamp stamp{name};
+    stamp.hash = fnv1aOffsetBasis;
+    std::vector<char> chunk(1 << 20);
+    while (is.read(chunk.data(), chunk.size()) || is.gcount() > 0) {
+        const auto count = static_cast<std::size_t>(is.gcount());
+        stamp.hash = fnv1a(stamp.hash, chunk.data(), count);
+        stamp.size += count;
+    }
+    return stamp;
+}
+
+// The serialized layout of the cached objects is defined by the code of this
+// build and of the opm-common it was built against. The version hash is only
+// set for release builds, so the compile time is part of the key as well.
+// The parse context decides which decks are accepted and which keywords are
+// left out of the deck, so its settings are part of the key too.
+std::string inputCacheKey(const Opm::ParseContext& parseContext, bool initFromRestart,
+                          bool checkDeck, const std::optional<int>& outputInterval)
+{
+    std::string key = fmt::format("format={} version={} built={} initFromRestart={} checkDeck={} outputInterval={}",
+                                  inputCacheFormatVersion, Opm::moduleVersion(), Opm::compileTimestamp(),
+                                  initFromRestart, checkDeck, outputInterval.value_or(-1));
+
+    for (const auto& [errorKey, action] : parseContext)
+        key += fmt::format(" {}={}", errorKey, static_cast<int>(action));
+
+    // the ignored keywords can only be queried by name
+    const Opm::Parser parser;
+    for (const auto& name : parser.getAllDeckNames()) {
+        if (parseContext.isActiveSkipKeyword(name))
+            key += " ignore=" + name;
+    }
+
+    return key;
+}
+
+// The absolute path of the deck a cache file is valid for.
+std::string inputCacheDeck(const std::string& deckFilename)
+{
+    return Opm::filesystem::absolute(deckFilename).generic_string();
+}
+
+void writeCacheValue(std::ostream& os, std::uint64_t value)
+{
+    os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void writeCacheString(std::ostream& os, const std::string& value)
+{
+    writeCacheValue(os, value.size());
+    os.write(value.data(), value.size());
+}
+
+std::uint64_t readCacheValue(std::istream& is)
+{
+    std::uint64_t value = 0;
+    is.read(reinterpret_cast<char*>(&value), sizeof(value));
+    return value;
+}
+
+// The number of bytes which can still be read from a stream.
+std::uint64_t remainingCacheBytes(std::istream& is)
+{
+    const auto pos = is.tellg();
+    is.seekg(0, std::ios::end);
+    const std::streamoff end = is.tellg();
+    is.seekg(pos);
+    const std::streamoff begin = pos;
+    return (begin < 0 || end < begin) ? 0 : static_cast<std::uint64_t>(end - begin);
+}
+
+// Returns false if the stored length is larger than the rest of the file,
+// i.e. the file is truncated or corrupt.
+bool readCacheBytes(std::istream& is, std::vector<char>& value)
+{
+    const auto size = readCacheValue(is);
+    if (!is || size > remainingCacheBytes(is))
+        return false;
+
+    value.resize(size);
+    is.read(value.data(), size);
+    return static_cast<bool>(is);
+}
+
+std::string readCacheString(std::istream& is)
+{
+    std::vector<char> value;
+    if (!readCacheBytes(is, value))
+        return {};
+
+    return std::string(value.begin(), value.end());
+}
+
+// Returns true if the cache file exists, matches the key and all the input
+// files it was created from are unchanged. The objects are only created in
+// that case.
+bool loadInputCache(const std::string& cacheFile, const std::string& deckFile,
+                    const std::string& key,
+                    std::unique_ptr<Opm::Deck>& deck,
+                    std::unique_ptr<Opm::Schedule>& schedule,
+                    std::unique_ptr<Opm::SummaryConfig>& summaryConfig,
+                    std::shared_ptr<Opm::Python>& python)
+{
+    Opm::StartupPhaseTimer timer("Reading input cache");
+    std::ifstream is(cacheFile, std::ios::binary);
+    if (!is || readCacheString(is) != inputCacheMagic)
+        return false;
+
+    if (readCacheValue(is) != inputCacheFormatVersion) {
+        Opm::OpmLog::info("Input cache '" + cacheFile + "' has an unsupported format, parsing the deck");
+        return false;
+    }
+
+    if (readCacheString(is) != deckFile) {
+        Opm::OpmLog::info("Input cache '" + cacheFile + "' was created for another deck, parsing the deck");
+        return false;
+    }
+
+    if (readCacheString(is) != key) {
+        Opm::OpmLog::info("Input cache '" + cacheFile + "' was created with other settings, parsing the deck");
+        return false;
+    }
+
+    const auto numFiles = readCacheValue(is);
+    for (std::uint64_t i = 0; i < numFiles && is; ++i) {
+        InputFileStamp cached;
+        cached.name = readCacheString(is);
+        cached.size = readCacheValue(is);
+        cached.hash = readCacheValue(is);
+        const auto current = stampInputFile(cached.name);
+        if (!current || current->size != cached.size || current->hash != cached.hash) {
+            Opm::OpmLog::info("Input file '" + cached.name + "' changed since '" + cacheFile + "' was written, parsing the deck");
+            return false;
+        }
+    }
+
+    // the serialized objects are only unpacked if they are complete and
+    // unchanged, unpacking corrupt data may fail in arbitrary ways
+    std::vector<char> buffer;
+    const bool complete = readCacheBytes(is, buffer);
+    const auto hash = readCacheValue(is);
+    if (!complete || !is || hash != fnv1a(fnv1aOffsetBasis, buffer.data(), buffer.size())) {
+        Opm::OpmLog::warning("Input cache '" + cacheFile + "' is corrupt, parsing the deck");
+        return false;
+    }
+
+    deck = std::make_unique<Opm::Deck>();
+    schedule = std::make_unique<Opm::Schedule>(python);
+    summaryConfig = std::make_unique<Opm::SummaryConfig>();
+
+    Opm::EclMpiSerializer ser(Dune::MPIHelper::getLocalCommunicator());
+    ser.setBuffer(std::move(buffer));
+    InputCacheData data{*deck, *schedule, *summaryConfig};
+    ser.unpack(data);
+
+    Opm::OpmLog::info("Read parsed input from cache '" + cacheFile + "'");
+    return true;
+}
+
+// Keywords which make the EclipseState or the Schedule read files that are
+// not part of the parsed deck. The contents of these files are not known
+// here, so decks using them are not cached.
+const std::vector<std::string>& externalFileKeywords()
+{
+    static const std::vector<std::string> keywords = {"GDFILE", "IMPORT", "PYACTION", "PYINPUT"};
+    return keywords;
+}
+
+void writeInputCache(const std::string& cacheFile, const std::string& deckFile,
+                     const std::string& key,
+                     const std::vector<std::string>& extraInputFiles,
+                     Opm::Deck& deck, Opm::Schedule& schedule,
+                     Opm::SummaryConfig& summaryConfig)
+{
+    for (const auto& keyword : externalFileKeywords()) {
+        if (deck.hasKeyword(keyword)) {
+            Opm::OpmLog::info("The deck uses " + keyword + " whose input files are not tracked, not writing input cache");
+            return;
+        }
+    }
+
+    Opm::StartupPhaseTimer timer("Writing input cache");
+
+    std::set<std::string> inputFiles(extraInputFiles.begin(), extraInputFiles.end());
+    inputFiles.insert(deck.getDataFile());
+    for (std::size_t kwIdx = 0; kwIdx < deck.size(); ++kwIdx)
+        inputFiles.insert(deck.getKeyword(kwIdx).location().filename);
+
+    std::vector<InputFileStamp> stamps;
+    for (const auto& name : inputFiles) {
+        if (name.empty())
+            continue;
+        auto stamp = stampInputFile(name);
+        if (!stamp) {
+            Opm::OpmLog::warning("Input file '" + name + "' cannot be read back, not writing input cache");
+            return;
+        }
+        stamps.push_back(std::move(*stamp));
+    }
+
+    Opm::EclMpiSerializer ser(Dune::MPIHelper::getLocalCommunicator());
+    InputCacheData data{deck, schedule, summaryConfig};
+    ser.pack(data);
+
+    // the cache is written to a temporary file which replaces the cache file
+    // when it is complete, such that an interrupted or concurrent run never
+    // leaves a partially written cache file behind
+    const std::string tmpFile = cacheFile + ".tmp." + std::to_string(::getpid());
+    std::ofstream os(tmpFile, std::ios::binary | std::ios::trunc);
+    writeCacheString(os, inputCacheMagic);
+    writeCacheValue(os, inputCacheFormatVersion);
+    writeCacheString(os, deckFile);
+    writeCacheString(os, key);
+    writeCacheValue(os, stamps.size());
+    for (const auto& stamp : stamps) {
+        writeCacheString(os, stamp.name);
+        writeCacheValue(os, stamp.size);
+        writeCacheValue(os, stamp.hash);
+    }
+    writeCacheValue(os, ser.position());
+    os.write(ser.buffer().data(), ser.position());
+    writeCacheValue(os, fnv1a(fnv1aOffsetBasis, ser.buffer().data(), ser.position()));
+    os.close();
+
+    if (!os || std::rename(tmpFile.c_str(), cacheFile.c_str()) != 0) {
+        std::remove(tmpFile.c_str());
+        Opm::OpmLog::warning("Writing input cache '" + cacheFile + "' failed");
+    }
+    else
+        Opm::OpmLog::info("Wrote parsed input to cache '" + cacheFile + "'");
+}
+#endif
 }
 
 
 void readDeck(int rank, std::string& deckFilename, std::unique_ptr<Opm::Deck>& deck, std::unique_ptr<Opm::EclipseState>& eclipseState,
               std::unique_ptr<Opm::Schedule>& schedule, std::unique_ptr<Opm::SummaryConfig>& summaryConfig,
               std::unique_ptr<ErrorGuard> errorGuard, std::shared_ptr<Opm::Python>& python, std::unique_ptr<ParseContext> parseContext,
-              bool initFromRestart, bool checkDeck, const std::optional<int>& outputInterval)
+              bool initFromRestart, bool checkDeck, const std::optional<int>& outputInterval,
+              const std::string& inputCacheFile)
 {
     if (!errorGuard)
     {
@@ -201,6 +503,34 @@ void readDeck(int rank, std::string& deckFilename, std::unique_ptr<Opm::Deck>& d
     if (rank==0) {
         try
         {
+            bool useInputCache = !inputCacheFile.empty() && parseContext
+                && !deck && !eclipseState && !schedule && !summaryConfig;
+            std::vector<std::string> extraInputFiles;
+#if HAVE_MPI
+            std::string cacheKey;
+            if (useInputCache) {
+                cacheKey = inputCacheKey(*parseContext, initFromRestart, checkDeck, outputInterval);
+                bool cacheLoaded = false;
+                try {
+                    cacheLoaded = loadInputCache(inputCacheFile, inputCacheDeck(deckFilename), cacheKey,
+                                                 deck, schedule, summaryConfig, python);
+                }
+                catch (const std::exception& e) {
+                    OpmLog::warning("Reading input cache '" + inputCacheFile + "' failed, parsing the deck: " + e.what());
+                    deck.reset();
+                    schedule.reset();
+                    summaryConfig.reset();
+                }
+                if (cacheLoaded)
+                    useInputCache = false;
+            }
+#else
+            if (useInputCache) {
+                OpmLog::warning("The input cache requires MPI support, parsing the deck");
+                useInputCache = false;
+            }
+#endif
+
             if ( (!deck || !schedule || !summaryConfig ) && !parseContext)
             {
                 OPM_THROW(std::logic_error, "We need a parse context if deck, schedule, or summaryConfig are not initialized");
@@ -209,8 +539,12 @@ void readDeck(int rank, std::string& deckFilename, std::unique_ptr<Opm::Deck>& d
             if (!deck)
             {
                 Opm::Parser parser;
-                deck = std::make_unique<Opm::Deck>( parser.parseFile(deckFilename , *parseContext, *errorGuard));
+                {
+                    StartupPhaseTimer timer("Parsing deck");
+                    deck = std::make_unique<Opm::Deck>( parser.parseFile(deckFilename , *parseContext, *errorGuard));
+                }
 
+                StartupPhaseTimer timer("Validating keywords");
                 Opm::KeywordValidation::KeywordValidator keyword_validator(
                     Opm::FlowKeywordValidation::unsupportedKeywords(),
                     Opm::FlowKeywordValidation::partiallySupported<std::string>(),
@@ -223,6 +557,7 @@ void readDeck(int rank, std::string& deckFilename, std::unique_ptr<Opm::Deck>& d
             }
 
             if (!eclipseState) {
+                StartupPhaseTimer timer("Creating EclipseState");
 #if HAVE_MPI
                 eclipseState = std::make_unique<Opm::ParallelEclipseState>(*deck);
 #else
@@ -238,25 +573,39 @@ void readDeck(int rank, std::string& deckFilename, std::unique_ptr<Opm::Deck>& d
             if (init_config.restartRequested() && initFromRestart) {
                 const int report_step = init_config.getRestartStep();
                 const auto rst_filename = eclipseState->getIOConfig().getRestartFileName( init_config.getRestartRootName(), report_step, false );
-                auto rst_file = std::make_shared<EclIO::ERst>(rst_filename);
-                auto rst_view = std::make_shared<EclIO::RestartFileView>(std::move(rst_file), report_step);
-                const auto rst_state = Opm::RestartIO::RstState::load(std::move(rst_view));
-                if (!schedule)
+                if (!schedule) {
+                    StartupPhaseTimer timer("Creating Schedule");
+                    auto rst_file = std::make_shared<EclIO::ERst>(rst_filename);
+                    auto rst_view = std::make_shared<EclIO::RestartFileView>(std::move(rst_file), report_step);
+                    const auto rst_state = Opm::RestartIO::RstState::load(std::move(rst_view));
                     schedule = std::make_unique<Opm::Schedule>(*deck, *eclipseState, *parseContext, *errorGuard, python, outputInterval, &rst_state);
+                    extraInputFiles.push_back(rst_filename);
+                }
             }
             else {
-                if (!schedule)
+                if (!schedule) {
+                    StartupPhaseTimer timer("Creating Schedule");
                     schedule = std::make_unique<Opm::Schedule>(*deck, *eclipseState, *parseContext, *errorGuard, python);
+                }
             }
             if (Opm::OpmLog::hasBackend("STDOUT_LOGGER")) // loggers might not be set up!
             {
                 setupMessageLimiter(schedule->operator[](0).message_limits(), "STDOUT_LOGGER");
             }
-            if (!summaryConfig)
+            if (!summaryConfig) {
+                StartupPhaseTimer timer("Creating SummaryConfig");
                 summaryConfig = std::make_unique<Opm::SummaryConfig>(*deck, *schedule, eclipseState->fieldProps(), 
                                                                      eclipseState->aquifer(), *parseContext, *errorGuard);
+            }
 
             Opm::checkConsistentArrayDimensions(*eclipseState, *schedule, *parseContext, *errorGuard);
+
+#if HAVE_MPI
+            // Only input which was read without errors is cached.
+            if (useInputCache && !*errorGuard)
+                writeInputCache(inputCacheFile, inputCacheDeck(deckFilename), cacheKey,
+                                extraInputFiles, *deck, *schedule, *summaryConfig);
+#endif
         }
         catch(const OpmInputError& input_error) {
             failureMessage = input_error.what();
@@ -280,6 +629,7 @@ void readDeck(int rank, std::string& deckFilename, std::unique_ptr<Opm::Deck>& d
 
     try
     {
+        StartupPhaseTimer timer("Broadcasting input");
         Opm::eclStateBroadcast(*eclipseState, *schedule, *summaryConfig);
     }
     catch(const std::exception& broadcast_error)
@@ -52,10 +52,15 @@ FileOutputMode setupLogging(int mpi_rank_, const std::string& deck_filename, con
 /// \brief Reads the deck and creates all necessary objects if needed
 ///
 /// If pointers already contains objects then they are used otherwise they are created and can be used outside later.
+/// If inputCacheFile is given and none of the objects exist, the deck, schedule and summary config are read
+/// from that file as long as it matches the deck and all its include files. Otherwise the deck is parsed and
+/// the result written to the file, unless the deck reads other files through GDFILE, IMPORT, PYACTION or
+/// PYINPUT.
 void readDeck(int rank, std::string& deckFilename, std::unique_ptr<Deck>& deck, std::unique_ptr<EclipseState>& eclipseState,
               std::unique_ptr<Schedule>& schedule, std::unique_ptr<SummaryConfig>& summaryConfig,
               std::unique_ptr<ErrorGuard> errorGuard, std::shared_ptr<Python>& python, std::unique_ptr<ParseContext> parseContext,
-              bool initFromRestart, bool checkDeck, const std::optional<int>& outputInterval);
+              bool initFromRestart, bool checkDeck, const std::optional<int>& outputInterval,
+              const std::string& inputCacheFile = "");
 } // end namespace Opm
 
 #endif // OPM_READDECK_HEADER_INCLUDED
@@ -43,6 +43,19 @@ public:
     int  get_increment_count(const std::string& wname) const;
     int  get_decrement_count(const std::string& wname) const;
 
+    template<class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        // unpacking inserts into the maps, so start from a clean state
+        if (!serializer.isSerializing())
+            *this = ALQState{};
+
+        serializer.template map<std::map<std::string, double>, false>(current_alq_);
+        serializer.template map<std::map<std::string, double>, false>(default_alq_);
+        serializer.template map<std::map<std::string, int>, false>(alq_increase_count_);
+        serializer.template map<std::map<std::string, int>, false>(alq_decrease_count_);
+    }
+
 private:
     std::map<std::string, double> current_alq_;
     std::map<std::string, double> default_alq_;
@@ -0,0 +1,125 @@
+/*
+  Copyright 2021 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_ARRAY_SLICE_HEADER_INCLUDED
+#define OPM_ARRAY_SLICE_HEADER_INCLUDED
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace Opm {
+
+/*
+  The ArraySlice<T> class is a non owning view of a contiguous range of
+  elements. The WellState keeps each per well, per perforation and per segment
+  quantity in a single array for all wells; the accessors for a single well
+  return slices of these arrays.
+
+  A slice is only valid as long as the array it refers to is not resized, i.e.
+  until the well state is initialized again.
+*/
+
+template <class T>
+class ArraySlice {
+public:
+    using value_type = std::remove_const_t<T>;
+    using iterator = T*;
+    using const_iterator = T*;
+
+    ArraySlice() = default;
+
+    ArraySlice(T* data, std::size_t size)
+        : m_data(data)
+        , m_size(size)
+    {}
+
+    template <class Vector>
+    ArraySlice(Vector& vector, std::size_t offset, std::size_t size)
+        : m_data(vector.data() + offset)
+        , m_size(size)
+    {
+        if (offset + size > vector.size())
+            throw std::out_of_range("Slice exceeds the size of the array");
+    }
+
+    // A slice of non const elements converts to a slice of const elements.
+    template <class U, class = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    ArraySlice(const ArraySlice<U>& other)
+        : m_data(other.data())
+        , m_size(other.size())
+    {}
+
+    T& operator[](std::size_t index) const {
+        return this->m_data[index];
+    }
+
+    T* data() const {
+        return this->m_data;
+    }
+
+    std::size_t size() const {
+        return this->m_size;
+    }
+
+    bool empty() const {
+        return this->m_size == 0;
+    }
+
+    T* begin() const {
+        return this->m_data;
+    }
+
+    T* end() const {
+        return this->m_data + this->m_size;
+    }
+
+    /*
+      Copy the values of a slice of the same size into this slice.
+    */
+    template <class U>
+    void assign(const ArraySlice<U>& other) const {
+        if (other.size() != this->m_size)
+            throw std::logic_error("Tried to assign slices of different size");
+
+        std::copy(other.begin(), other.end(), this->m_data);
+    }
+
+    void assign(std::size_t size, const value_type& value) const {
+        if (size != this->m_size)
+            throw std::logic_error("Tried to resize an array slice");
+
+        std::fill(this->begin(), this->end(), value);
+    }
+
+    std::vector<value_type> to_vector() const {
+        return { this->begin(), this->end() };
+    }
+
+private:
+    T* m_data = nullptr;
+    std::size_t m_size = 0;
+};
+
+
+}
+
+#endif
@@ -220,6 +220,14 @@ namespace Opm {
                                     param_.use_multisegment_well_);
             }
 
+            using BlackoilWellModelGeneric::initFromCheckpoint;
+            void initFromCheckpoint(const std::vector<char>& buffer)
+            {
+                initFromCheckpoint(buffer,
+                                   UgGridHelpers::numCells(grid()),
+                                   param_.use_multisegment_well_);
+            }
+
             data::Wells wellData() const
             {
                 auto wsrpt = this->wellState()
@@ -37,11 +37,35 @@
 #include <opm/simulators/wells/WellGroupHelpers.hpp>
 #include <opm/simulators/wells/WellState.hpp>
 
+#include <ebos/eclmpiserializer.hh>
+
 #include <cassert>
 #include <stdexcept>
 
 #include <fmt/format.h>
 
+namespace {
+
+// The dynamic state of the well model which is stored in a checkpoint.
+struct WellModelCheckpoint
+{
+    Opm::WellState& wellState;
+    Opm::GroupState& groupState;
+    std::map<std::string, double>& nodePressures;
+
+    template<class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        wellState.serializeOp(serializer);
+        groupState.serializeOp(serializer);
+        if (!serializer.isSerializing())
+            nodePressures.clear();
+        serializer.template map<std::map<std::string, double>, false>(nodePressures);
+    }
+};
+
+}
+
 namespace Opm {
 
 BlackoilWellModelGeneric::
@@ -187,7 +211,7 @@ loadRestartData(const data::Wells& rst_wells,
             well_state.wellRates(well_index)[i] = rst_well.rates.get(phs[i]);
         }
 
-        auto& perf_data = well_state.perfData(well_index);
+        auto perf_data = well_state.perfData(well_index);
         auto& perf_pressure = perf_data.pressure;
         auto& perf_rates = perf_data.rates;
         auto& perf_phase_rates = perf_data.phase_rates;
@@ -214,7 +238,7 @@ loadRestartData(const data::Wells& rst_wells,
             // \Note: eventually we need to handle the situations that some segments are shut
             assert(0u + segment_set.size() == rst_segments.size());
 
-            auto& segments = well_state.segments(well_index);
+            auto segments = well_state.segments(well_index);
             auto& segment_pressure = segments.pressure;
             auto& segment_rates  = segments.rates;
             for (const auto& rst_segment : rst_segments) {
@@ -256,6 +280,18 @@ BlackoilWellModelGeneric::
 initFromRestartFile(const RestartValue& restartValues,
                     const size_t numCells,
                     bool handle_ms_well)
+{
+    if (this->initRestartWells_(numCells, handle_ms_well))
+        loadRestartData(restartValues.wells, restartValues.grp_nwrk, phase_usage_, handle_ms_well, this->wellState());
+
+    this->commitWGState();
+    initial_step_ = false;
+}
+
+bool
+BlackoilWellModelGeneric::
+initRestartWells_(const size_t numCells,
+                  bool& handle_ms_well)
 {
     // The restart step value is used to identify wells present at the given
     // time step. Wells that are added at the same time step as RESTART is initiated
@@ -273,13 +309,62 @@ initFromRestartFile(const RestartValue& restartValues,
     if (nw > 0) {
         handle_ms_well &= anyMSWellOpenLocal();
         this->wellState().resize(wells_ecl_, local_parallel_well_info_, schedule(), handle_ms_well, numCells, well_perf_data_, summaryState_); // Resize for restart step
-        loadRestartData(restartValues.wells, restartValues.grp_nwrk, phase_usage_, handle_ms_well, this->wellState());
     }
 
+    return nw > 0;
+}
+
+std::vector<char>
+BlackoilWellModelGeneric::
+packCheckpoint() const
+{
+    // the next time step starts from the last valid state
+    WGState wgstate = this->last_valid_wgstate_;
+    auto nodePressures = this->node_pressures_;
+    WellModelCheckpoint data{wgstate.well_state, wgstate.group_state, nodePressures};
+
+    EclMpiSerializer ser(Dune::MPIHelper::getLocalCommunicator());
+    ser.pack(data);
+    const auto& buffer = ser.buffer();
+    return std::vector<char>(buffer.begin(), buffer.begin() + ser.position());
+}
+
+void
+BlackoilWellModelGeneric::
+initFromCheckpoint(const std::vector<char>& buffer,
+                   const size_t numCells,
+                   bool handle_ms_well)
+{
+    this->initRestartWells_(numCells, handle_ms_well);
+    if (!buffer.empty())
+        this->unpackCheckpoint_(buffer);
+
     this->commitWGState();
     initial_step_ = false;
 }
 
+void
+BlackoilWellModelGeneric::
+resumeFromCheckpoint(const std::vector<char>& buffer)
+{
+    this->unpackCheckpoint_(buffer);
+    this->commitWGState();
+
+    // the checkpoint was written after the first time step of the report step
+    report_step_starts_ = false;
+}
+
+void
+BlackoilWellModelGeneric::
+unpackCheckpoint_(const std::vector<char>& buffer)
+{
+    WellModelCheckpoint data{this->wellState(), this->groupState(), this->node_pressures_};
+
+    EclMpiSerializer ser(Dune::MPIHelper::getLocalCommunicator());
+    ser.setBuffer(buffer);
+    ser.unpack(data);
+}
+
 void
 BlackoilWellModelGeneric::
 setWellsActive(const bool wells_active)
@@ -1031,6 +1116,9 @@ BlackoilWellModelGeneric::
 updateEclWells(const int timeStepIdx,
                const std::unordered_set<std::string>& wells)
 {
+    // ACTIONX may have changed the status or group of the wells.
+    this->group_tree_.reset();
+
     for (const auto& wname : wells) {
         auto well_iter = std::find_if( this->wells_ecl_.begin(), this->wells_ecl_.end(), [wname] (const auto& well) -> bool { return well.name() == wname;});
         if (well_iter != this->wells_ecl_.end()) {
@@ -1509,16 +1597,17 @@ updateAndCommunicateGroupData(const int reportStepIdx,
     const auto& well_state_nupcol = this->nupcolWellState();
     // the group target reduction rates needs to be update since wells may have switched to/from GRUP control
     // Currently the group target reduction does not honor NUPCOL. TODO: is that true?
+    const auto& group_tree = this->groupTree(reportStepIdx);
     std::vector<double> groupTargetReduction(numPhases(), 0.0);
-    WellGroupHelpers::updateGroupTargetReduction(fieldGroup, schedule(), reportStepIdx, /*isInjector*/ false, phase_usage_, guideRate_, well_state_nupcol, well_state, this->groupState(), groupTargetReduction);
+    WellGroupHelpers::updateGroupTargetReduction(group_tree, /*isInjector*/ false, guideRate_, well_state_nupcol, well_state, this->groupState(), groupTargetReduction);
     std::vector<double> groupTargetReductionInj(numPhases(), 0.0);
-    WellGroupHelpers::updateGroupTargetReduction(fieldGroup, schedule(), reportStepIdx, /*isInjector*/ true, phase_usage_, guideRate_, well_state_nupcol, well_state, this->groupState(), groupTargetReductionInj);
+    WellGroupHelpers::updateGroupTargetReduction(group_tree, /*isInjector*/ true, guideRate_, well_state_nupcol, well_state, this->groupState(), groupTargetReductionInj);
 
     WellGroupHelpers::updateREINForGroups(fieldGroup, schedule(), reportStepIdx, phase_usage_, summaryState_, well_state_nupcol, well_state, this->groupState());
-    WellGroupHelpers::updateVREPForGroups(fieldGroup, schedule(), reportStepIdx, well_state_nupcol, well_state, this->groupState());
+    WellGroupHelpers::updateVREPForGroups(group_tree, well_state_nupcol, well_state, this->groupState());
 
-    WellGroupHelpers::updateReservoirRatesInjectionGroups(fieldGroup, schedule(), reportStepIdx, well_state_nupcol, well_state, this->groupState());
-    WellGroupHelpers::updateGroupProductionRates(fieldGroup, schedule(), reportStepIdx, well_state_nupcol, well_state, this->groupState());
+    WellGroupHelpers::updateReservoirRatesInjectionGroups(group_tree, well_state_nupcol, well_state, this->groupState());
+    WellGroupHelpers::updateGroupProductionRates(group_tree, well_state_nupcol, well_state, this->groupState());
 
     // We use the rates from the previous time-step to reduce oscillations
     WellGroupHelpers::updateWellRates(fieldGroup, schedule(), reportStepIdx, this->prevWellState(), well_state);
@@ -1728,6 +1817,26 @@ gasLiftOptimizationStage2(DeferredLogger& deferred_logger,
     glift.runOptimize();
 }
 
+const WellGroupHelpers::GroupTree&
+BlackoilWellModelGeneric::
+groupTree(const int reportStepIdx) const
+{
+    if (!this->group_tree_.has_value() || this->group_tree_->reportStep() != reportStepIdx) {
+        this->group_tree_.emplace(schedule(), reportStepIdx);
+    }
+    return *this->group_tree_;
+}
+
+BlackoilWellModelGeneric::TemporaryWellState
+BlackoilWellModelGeneric::
+temporaryWellState(std::size_t well_index) const
+{
+    // the well state is modified, but it is restored before the
+    // TemporaryWellState is released
+    auto& well_state = const_cast<WellState&>(this->wellState());
+    return TemporaryWellState(well_state, well_index);
+}
+
 void
 BlackoilWellModelGeneric::
 updateWellPotentials(const int reportStepIdx,
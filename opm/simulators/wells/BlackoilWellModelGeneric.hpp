@@ -24,9 +24,11 @@
 #ifndef OPM_BLACKOILWELLMODEL_GENERIC_HEADER_INCLUDED
 #define OPM_BLACKOILWELLMODEL_GENERIC_HEADER_INCLUDED
 
+#include <cstddef>
 #include <functional>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -39,6 +41,7 @@
 #include <opm/simulators/utils/DeferredLoggingErrorHelpers.hpp>
 #include <opm/simulators/wells/ParallelWellInfo.hpp>
 #include <opm/simulators/wells/PerforationData.hpp>
+#include <opm/simulators/wells/WellGroupHelpers.hpp>
 #include <opm/simulators/wells/WellInterfaceGeneric.hpp>
 #include <opm/simulators/wells/WellProdIndexCalculator.hpp>
 #include <opm/simulators/wells/WGState.hpp>
@@ -116,6 +119,38 @@ public:
 
     GroupState& groupState() { return this->active_wgstate_.group_state; }
 
+    /*
+      Write access to the active well state for a local solve of a single
+      well which must leave the well state untouched (e.g. well potentials).
+      The entries of the well are saved when the object is created and
+      restored when it goes out of scope, so the other wells and the group
+      controls see the active state during the solve without a copy of the
+      complete well state. The solve must only modify the entries of the
+      well it was created for.
+    */
+    class TemporaryWellState
+    {
+    public:
+        TemporaryWellState(WellState& state, std::size_t well_index)
+            : state_(state), snapshot_(state.snapshotWell(well_index))
+        {}
+
+        TemporaryWellState(const TemporaryWellState&) = delete;
+        TemporaryWellState& operator=(const TemporaryWellState&) = delete;
+
+        ~TemporaryWellState() { state_.restoreWell(snapshot_); }
+
+        WellState& get() { return state_; }
+
+    private:
+        WellState& state_;
+        WellState::SingleWellSnapshot snapshot_;
+    };
+
+    /// The well is identified by its index in the well state,
+    /// i.e. WellInterface::indexOfWell().
+    TemporaryWellState temporaryWellState(std::size_t well_index) const;
+
 
     double wellPI(const int well_index) const;
     double wellPI(const std::string& well_name) const;
@@ -134,6 +169,22 @@ public:
                              const size_t numCells,
                              bool handle_ms_well);
 
+    /// Serialize the dynamic state of the wells, the groups and the network
+    /// which a restart from a checkpoint needs to continue bit-identically.
+    std::vector<char> packCheckpoint() const;
+
+    /// Set up the wells for a restart from a checkpoint written by
+    /// packCheckpoint() at the end of the previous report step. An empty
+    /// buffer only sets up the wells, the state is then expected to be set
+    /// by resumeFromCheckpoint().
+    void initFromCheckpoint(const std::vector<char>& buffer,
+                            const size_t numCells,
+                            bool handle_ms_well);
+
+    /// Replace the state set up at the beginning of the current report step
+    /// by the state of a checkpoint written within that report step.
+    void resumeFromCheckpoint(const std::vector<char>& buffer);
+
     void setWellsActive(const bool wells_active);
 
     /*
@@ -235,6 +286,13 @@ protected:
         this->nupcol_wgstate_ = this->active_wgstate_;
     }
 
+    /*
+      Flattened group hierarchy of the given report step. It is built on
+      first use and kept until the report step changes, or until
+      updateEclWells() applies well changes from ACTIONX.
+    */
+    const WellGroupHelpers::GroupTree& groupTree(const int reportStepIdx) const;
+
     /// \brief Create the parallel well information
     /// \param localWells The local wells from ECL schedule
     std::vector<ParallelWellInfo*> createLocalParallelWellInfo(const std::vector<Well>& wells);
@@ -242,6 +300,11 @@ protected:
     void initializeWellProdIndCalculators();
     void initializeWellPerfData();
 
+    // Set up the wells of the report step preceding a restart. Returns
+    // whether there are wells on this process.
+    bool initRestartWells_(const size_t numCells, bool& handle_ms_well);
+    void unpackCheckpoint_(const std::vector<char>& buffer);
+
     bool wasDynamicallyShutThisTimeStep(const int well_index) const;
 
     void updateNetworkPressures(const int reportStepIdx);
@@ -420,6 +483,9 @@ protected:
     WGState last_valid_wgstate_;
     WGState nupcol_wgstate_;
 
+    // Group hierarchy of the current report step, see groupTree().
+    mutable std::optional<WellGroupHelpers::GroupTree> group_tree_;
+
     bool glift_debug = false;
 
   private:
@@ -96,11 +96,11 @@ calcIncOrDecGradient(double oil_rate, double gas_rate, double alq, bool increase
     if (!new_alq_opt)
         return std::nullopt;
     double new_alq = *new_alq_opt;
-    if (auto bhp = computeBhpAtThpLimit_(new_alq)) {
+    if (auto bhp = computeBhpAtThpLimitCached_(new_alq)) {
         auto new_bhp = getBhpWithLimit_(*bhp);
         // TODO: What to do if BHP is limited?
         std::vector<double> potentials(this->num_phases_, 0.0);
-        computeWellRates_(new_bhp.first, potentials);
+        computeWellRatesCached_(new_bhp.first, potentials);
         auto [new_oil_rate, oil_is_limited] = getOilRateWithLimit_(potentials);
         auto [new_gas_rate, gas_is_limited] = getGasRateWithLimit_(potentials);
         if (!increase && new_oil_rate < 0 ) {
@@ -285,19 +285,35 @@ checkWellRatesViolated_(
     return false;
 }
 
+std::optional<double>
+GasLiftSingleWellGeneric::
+computeBhpAtThpLimitCached_(double alq) const
+{
+    // Look for a previously computed ALQ value within rounding error
+    //   (see checkALQequal_()).
+    const double tol = this->increment_*ALQ_EPSILON;
+    auto it = this->bhp_at_thp_limit_cache_.lower_bound(alq - tol);
+    if (it != this->bhp_at_thp_limit_cache_.end() && checkALQequal_(it->first, alq)) {
+        return it->second;
+    }
+    auto bhp = computeBhpAtThpLimit_(alq);
+    this->bhp_at_thp_limit_cache_.emplace(alq, bhp);
+    return bhp;
+}
+
 bool
 GasLiftSingleWellGeneric::
 computeInitialWellRates_(std::vector<double>& potentials)
 {
 
-    if (auto bhp = computeBhpAtThpLimit_(this->orig_alq_); bhp) {
+    if (auto bhp = computeBhpAtThpLimitCached_(this->orig_alq_); bhp) {
         {
             const std::string msg = fmt::format(
                 "computed initial bhp {} given thp limit and given alq {}",
                 *bhp, this->orig_alq_);
             displayDebugMessage_(msg);
         }
-        computeWellRates_(*bhp, potentials);
+        computeWellRatesCached_(*bhp, potentials);
         {
             const std::string msg = fmt::format(
                 "computed initial well potentials given bhp, "
@@ -315,6 +331,19 @@ computeInitialWellRates_(std::vector<double>& potentials)
     }
 }
 
+void
+GasLiftSingleWellGeneric::
+computeWellRatesCached_(double bhp, std::vector<double>& potentials, bool debug_output) const
+{
+    auto it = this->well_rates_cache_.find(bhp);
+    if (it != this->well_rates_cache_.end()) {
+        potentials = it->second;
+        return;
+    }
+    computeWellRates_(bhp, potentials, debug_output);
+    this->well_rates_cache_.emplace(bhp, potentials);
+}
+
 void
 GasLiftSingleWellGeneric::
 debugCheckNegativeGradient_(double grad, double alq, double new_alq, double oil_rate,
@@ -356,7 +385,7 @@ debugShowBhpAlqTable_()
     const std::string header = fmt::format(fmt_fmt1, "ALQ", "BHP", "oil", "gas");
     displayDebugMessage_(header);
     while (alq <= (this->max_alq_+this->increment_)) {
-        auto bhp_at_thp_limit = computeBhpAtThpLimit_(alq);
+        auto bhp_at_thp_limit = computeBhpAtThpLimitCached_(alq);
         if (!bhp_at_thp_limit) {
             const std::string msg = fmt::format("Failed to get converged potentials "
                 "for ALQ = {}. Skipping.", alq );
@@ -364,7 +393,7 @@ debugShowBhpAlqTable_()
         }
         else {
             std::vector<double> potentials(this->num_phases_, 0.0);
-            computeWellRates_(*bhp_at_thp_limit, potentials, /*debug_out=*/false);
+            computeWellRatesCached_(*bhp_at_thp_limit, potentials, /*debug_out=*/false);
             auto oil_rate = -potentials[this->oil_pos_];
             auto gas_rate = -potentials[this->gas_pos_];
             const std::string msg = fmt::format(
@@ -549,11 +578,11 @@ increaseALQtoPositiveOilRate_(double alq,
     while(!stop_iteration) {
         temp_alq += this->increment_;
         if (temp_alq > this->max_alq_) break;
-        auto bhp_opt = computeBhpAtThpLimit_(temp_alq);
+        auto bhp_opt = computeBhpAtThpLimitCached_(temp_alq);
         if (!bhp_opt) break;
         alq = temp_alq;
         auto bhp_this = getBhpWithLimit_(*bhp_opt);
-        computeWellRates_(bhp_this.first, potentials);
+        computeWellRatesCached_(bhp_this.first, potentials);
         oil_rate = -potentials[this->oil_pos_];
         if (oil_rate > 0) break;
     }
@@ -580,11 +609,11 @@ increaseALQtoMinALQ_(double alq,
     while(!stop_iteration) {
         temp_alq += this->increment_;
         if (temp_alq >= min_alq) break;
-        auto bhp_opt = computeBhpAtThpLimit_(temp_alq);
+        auto bhp_opt = computeBhpAtThpLimitCached_(temp_alq);
         if (!bhp_opt) break;
         alq = temp_alq;
         auto bhp_this = getBhpWithLimit_(*bhp_opt);
-        computeWellRates_(bhp_this.first, potentials);
+        computeWellRatesCached_(bhp_this.first, potentials);
         std::tie(oil_rate, oil_is_limited) = getOilRateWithLimit_(potentials);
         std::tie(gas_rate, gas_is_limited) = getGasRateWithLimit_(potentials);
         if (oil_is_limited || gas_is_limited) break;
@@ -670,10 +699,10 @@ reduceALQtoOilTarget_(double alq,
     while(!stop_iteration) {
         temp_alq -= this->increment_;
         if (temp_alq <= 0) break;
-        auto bhp_opt = computeBhpAtThpLimit_(temp_alq);
+        auto bhp_opt = computeBhpAtThpLimitCached_(temp_alq);
         if (!bhp_opt) break;
         auto bhp_this = getBhpWithLimit_(*bhp_opt);
-        computeWellRates_(bhp_this.first, potentials);
+        computeWellRatesCached_(bhp_this.first, potentials);
         oil_rate = -potentials[this->oil_pos_];
         if (oil_rate < target) {
             break;
@@ -784,7 +813,7 @@ runOptimizeLoop_(bool increase)
         if (!state.computeBhpAtThpLimit(temp_alq)) break;
         // NOTE: if BHP is below limit, we set state.stop_iteration = true
         auto bhp = state.getBhpWithLimit();
-        computeWellRates_(bhp, potentials);
+        computeWellRatesCached_(bhp, potentials);
         std::tie(new_oil_rate, new_oil_is_limited) = getOilRateWithLimit_(potentials);
 /*        if (this->debug_abort_if_decrease_and_oil_is_limited_) {
             if (oil_is_limited && !increase) {
@@ -1202,10 +1231,10 @@ reduceALQtoGroupTarget(double alq,
     while(!stop_this_iteration) {
         temp_alq -= this->parent.increment_;
         if (temp_alq <= 0) break;
-        auto bhp_opt = this->parent.computeBhpAtThpLimit_(temp_alq);
+        auto bhp_opt = this->parent.computeBhpAtThpLimitCached_(temp_alq);
         if (!bhp_opt) break;
         auto bhp_this = this->parent.getBhpWithLimit_(*bhp_opt);
-        this->parent.computeWellRates_(bhp_this.first, potentials);
+        this->parent.computeWellRatesCached_(bhp_this.first, potentials);
         oil_rate = -potentials[this->parent.oil_pos_];
         gas_rate = -potentials[this->parent.gas_pos_];
         double delta_oil = oil_rate_orig - oil_rate;
@@ -1318,7 +1347,7 @@ bool
 GasLiftSingleWellGeneric::OptimizeState::
 computeBhpAtThpLimit(double alq)
 {
-    auto bhp_opt = this->parent.computeBhpAtThpLimit_(alq);
+    auto bhp_opt = this->parent.computeBhpAtThpLimitCached_(alq);
     if (bhp_opt) {
         this->bhp = *bhp_opt;
         return true;
@@ -30,6 +30,7 @@
 #include <opm/simulators/wells/GasLiftGroupInfo.hpp>
 
 #include <functional>
+#include <map>
 #include <optional>
 #include <string>
 #include <tuple>
@@ -159,6 +160,16 @@ protected:
                                    std::vector<double>& potentials,
                                    bool debug_output = true) const = 0;
 
+    // The BHP at the THP limit only depends on ALQ, and the well rates only
+    // depend on BHP, as long as the reservoir state is fixed. Both are
+    // memoised for the lifetime of this object, i.e. for one gas lift
+    // optimization pass (stage 1 and stage 2), such that stage 2 and the
+    // repeated initial rate computations in stage 1 reuse earlier results.
+    std::optional<double> computeBhpAtThpLimitCached_(double alq) const;
+    void computeWellRatesCached_(double bhp,
+                                 std::vector<double>& potentials,
+                                 bool debug_output = true) const;
+
     bool computeInitialWellRates_(std::vector<double>& potentials);
 
     void debugCheckNegativeGradient_(double grad, double alq, double new_alq,
@@ -252,6 +263,9 @@ protected:
 
     const GasLiftOpt::Well* gl_well_;
 
+    mutable std::map<double, std::optional<double>> bhp_at_thp_limit_cache_;
+    mutable std::map<double, std::vector<double>> well_rates_cache_;
+
     bool optimize_;
     bool debug_;  // extra debug output
     bool debug_limit_increase_decrease_;
@@ -150,6 +150,26 @@ public:
 
     std::string dump() const;
 
+    template<class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        // unpacking inserts into the maps, so start from a clean state
+        if (!serializer.isSerializing())
+            *this = GroupState(this->num_phases);
+
+        serializer(num_phases);
+        serializer.template map<std::map<std::string, std::vector<double>>, false>(m_production_rates);
+        serializer.template map<std::map<std::string, Group::ProductionCMode>, false>(production_controls);
+        serializer.template map<std::map<std::string, std::vector<double>>, false>(prod_red_rates);
+        serializer.template map<std::map<std::string, std::vector<double>>, false>(inj_red_rates);
+        serializer.template map<std::map<std::string, std::vector<double>>, false>(inj_resv_rates);
+        serializer.template map<std::map<std::string, std::vector<double>>, false>(inj_potentials);
+        serializer.template map<std::map<std::string, std::vector<double>>, false>(inj_rein_rates);
+        serializer.template map<std::map<std::string, double>, false>(inj_vrep_rate);
+        serializer.template map<std::map<std::string, double>, false>(m_grat_sales_target);
+        serializer.template map<std::map<std::pair<Phase, std::string>, Group::InjectionCMode>, false>(injection_controls);
+    }
+
 
 private:
     std::size_t num_phases;
@@ -445,7 +445,7 @@ updatePrimaryVariables(const WellState& well_state) const
     const Well& well = baseif_.wellEcl();
 
     // the index of the top segment in the WellState
-    const auto& segments = well_state.segments(baseif_.indexOfWell());
+    const auto segments = well_state.segments(baseif_.indexOfWell());
     const auto& segment_rates = segments.rates;
     const auto& segment_pressure = segments.pressure;
     const PhaseUsage& pu = baseif_.phaseUsage();
@@ -1566,7 +1566,7 @@ assembleDefaultPressureEq(const int seg,
     // TODO: we might be able to add member variables to store these values, then we update well state
     // after converged
     const auto hydro_pressure_drop = getHydroPressureLoss(seg);
-    auto& segments = well_state.segments(baseif_.indexOfWell());
+    auto segments = well_state.segments(baseif_.indexOfWell());
     segments.pressure_drop_hydrostatic[seg] = hydro_pressure_drop.value();
     pressure_equation -= hydro_pressure_drop;
 
@@ -1616,7 +1616,7 @@ updateWellStateFromPrimaryVariables(WellState& well_state,
     assert( FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx) );
     const int oil_pos = pu.phase_pos[Oil];
 
-    auto& segments = well_state.segments(baseif_.indexOfWell());
+    auto segments = well_state.segments(baseif_.indexOfWell());
     auto& segment_rates = segments.rates;
     auto& segment_pressure = segments.pressure;
     for (int seg = 0; seg < this->numberOfSegments(); ++seg) {
@@ -100,7 +100,7 @@ void
 MultisegmentWellGeneric<Scalar>::
 scaleSegmentRatesWithWellRates(WellState& well_state) const
 {
-    auto& segments = well_state.segments(baseif_.indexOfWell());
+    auto segments = well_state.segments(baseif_.indexOfWell());
     auto& segment_rates = segments.rates;
     for (int phase = 0; phase < baseif_.numPhases(); ++phase) {
         const double unscaled_top_seg_rate = segment_rates[phase];
@@ -136,7 +136,7 @@ void
 MultisegmentWellGeneric<Scalar>::
 scaleSegmentPressuresWithBhp(WellState& well_state) const
 {
-    auto& segments = well_state.segments(baseif_.indexOfWell());
+    auto segments = well_state.segments(baseif_.indexOfWell());
     auto bhp = well_state.bhp(baseif_.indexOfWell());
     segments.scale_pressure(bhp);
 }
@@ -322,9 +322,12 @@ namespace Opm
         MultisegmentWell<TypeTag> well_copy(*this);
         well_copy.debug_cost_counter_ = 0;
 
-        // store a copy of the well state, we don't want to update the real well state
-        WellState well_state_copy = ebosSimulator.problem().wellModel().wellState();
-        const auto& group_state = ebosSimulator.problem().wellModel().groupState();
+        // the entries of this well in the well state are restored on return, we don't
+        // want to update the real well state
+        const auto& well_model = ebosSimulator.problem().wellModel();
+        auto temporary_well_state = well_model.temporaryWellState(this->index_of_well_);
+        WellState& well_state_copy = temporary_well_state.get();
+        const auto& group_state = well_model.groupState();
 
         // Get the current controls.
         const auto& summary_state = ebosSimulator.vanguard().summaryState();
@@ -581,7 +584,7 @@ namespace Opm
             std::transform(src, src + np, dest, dest, std::plus<>{});
         };
 
-        auto& perf_data = well_state.perfData(this->index_of_well_);
+        auto perf_data = well_state.perfData(this->index_of_well_);
         auto* wellPI = well_state.productivityIndex(this->index_of_well_).data();
         auto* connPI = perf_data.prod_index.data();
 
@@ -1034,7 +1037,6 @@ namespace Opm
         if (!this->isOperable() && !this->wellIsStopped()) return true;
 
         const int max_iter_number = param_.max_inner_iter_ms_wells_;
-        const WellState well_state0 = well_state;
         const std::vector<Scalar> residuals0 = this->getWellResiduals(Base::B_avg_, deferred_logger);
         std::vector<std::vector<Scalar> > residual_history;
         std::vector<double> measure_history;
@@ -1249,7 +1251,7 @@ namespace Opm
 
             // calculating the perforation rate for each perforation that belongs to this segment
             const EvalWell seg_pressure = this->getSegmentPressure(seg);
-            auto& perf_data = well_state.perfData(this->index_of_well_);
+            auto perf_data = well_state.perfData(this->index_of_well_);
             auto& perf_rates = perf_data.phase_rates;
             auto& perf_press_state = perf_data.pressure;
             for (const int perf : this->segment_perforations_[seg]) {
@@ -66,5 +66,34 @@ bool PerfData::try_assign(const PerfData& other) {
     return true;
 }
 
+namespace {
+
+template<class T, class Data>
+PerfDataSlice<T> make_slice(Data& data, std::size_t offset, std::size_t num_perf, int np)
+{
+    return {
+        {data.pressure, offset, num_perf},
+        {data.rates, offset, num_perf},
+        {data.phase_rates, offset * np, num_perf * np},
+        {data.solvent_rates, offset, num_perf},
+        {data.polymer_rates, offset, num_perf},
+        {data.brine_rates, offset, num_perf},
+        {data.prod_index, offset * np, num_perf * np},
+        {data.water_throughput, offset, num_perf},
+        {data.skin_pressure, offset, num_perf},
+        {data.water_velocity, offset, num_perf}
+    };
+}
+
+}
+
+PerfDataSlice<double> PerfData::slice(std::size_t offset, std::size_t num_perf) {
+    return make_slice<double>(*this, offset, num_perf, this->pu.num_phases);
+}
+
+PerfDataSlice<const double> PerfData::slice(std::size_t offset, std::size_t num_perf) const {
+    return make_slice<const double>(*this, offset, num_perf, this->pu.num_phases);
+}
+
 }
 
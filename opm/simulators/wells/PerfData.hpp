@@ -21,13 +21,77 @@
 #ifndef OPM_PERFDATA_HEADER_INCLUDED
 #define OPM_PERFDATA_HEADER_INCLUDED
 
+#include <cstddef>
 #include <vector>
 
 #include <opm/core/props/BlackoilPhases.hpp>
+#include <opm/simulators/wells/ArraySlice.hpp>
 
 namespace Opm
 {
 
+/*
+  The perforation quantities of a single well. The values are slices of the
+  arrays of a PerfData object which holds the perforations of all the wells,
+  see PerfData::slice().
+*/
+template<class T>
+struct PerfDataSlice
+{
+    std::size_t size() const {
+        return this->pressure.size();
+    }
+
+    /*
+      Copy the values from other, which must have the same number of
+      perforations.
+    */
+    template<class U>
+    bool try_assign(const PerfDataSlice<U>& other) const
+    {
+        if (this->size() != other.size())
+            return false;
+
+        this->pressure.assign(other.pressure);
+        this->rates.assign(other.rates);
+        this->phase_rates.assign(other.phase_rates);
+        this->solvent_rates.assign(other.solvent_rates);
+        this->polymer_rates.assign(other.polymer_rates);
+        this->brine_rates.assign(other.brine_rates);
+        this->prod_index.assign(other.prod_index);
+        this->water_throughput.assign(other.water_throughput);
+        this->skin_pressure.assign(other.skin_pressure);
+        this->water_velocity.assign(other.water_velocity);
+        return true;
+    }
+
+    template<class Visitor>
+    void visit(Visitor&& visitor) const
+    {
+        visitor(pressure);
+        visitor(rates);
+        visitor(phase_rates);
+        visitor(solvent_rates);
+        visitor(polymer_rates);
+        visitor(brine_rates);
+        visitor(prod_index);
+        visitor(water_throughput);
+        visitor(skin_pressure);
+        visitor(water_velocity);
+    }
+
+    ArraySlice<T> pressure;
+    ArraySlice<T> rates;
+    ArraySlice<T> phase_rates;
+    ArraySlice<T> solvent_rates;
+    ArraySlice<T> polymer_rates;
+    ArraySlice<T> brine_rates;
+    ArraySlice<T> prod_index;
+    ArraySlice<T> water_throughput;
+    ArraySlice<T> skin_pressure;
+    ArraySlice<T> water_velocity;
+};
+
 class PerfData
 {
 private:
@@ -39,6 +103,26 @@ public:
     std::size_t size() const;
     bool try_assign(const PerfData& other);
 
+    /// The perforations [offset, offset + num_perf) of an object created
+    /// with the injectivity quantities, typically the perforations of one
+    /// well in the perforation data of all wells.
+    PerfDataSlice<double> slice(std::size_t offset, std::size_t num_perf);
+    PerfDataSlice<const double> slice(std::size_t offset, std::size_t num_perf) const;
+
+    template<class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(pressure);
+        serializer(rates);
+        serializer(phase_rates);
+        serializer(solvent_rates);
+        serializer(polymer_rates);
+        serializer(brine_rates);
+        serializer(prod_index);
+        serializer(water_throughput);
+        serializer(skin_pressure);
+        serializer(water_velocity);
+    }
 
     std::vector<double> pressure;
     std::vector<double> rates;
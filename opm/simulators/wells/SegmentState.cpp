@@ -75,4 +75,40 @@ const std::vector<int>& SegmentState::segment_number() const {
     return this->m_segment_number;
 }
 
+void SegmentState::append(const SegmentState& other) {
+    auto append_vector = [](auto& dest, const auto& src)
+    {
+        dest.insert(dest.end(), src.begin(), src.end());
+    };
+
+    append_vector(this->rates, other.rates);
+    append_vector(this->pressure, other.pressure);
+    append_vector(this->pressure_drop_friction, other.pressure_drop_friction);
+    append_vector(this->pressure_drop_hydrostatic, other.pressure_drop_hydrostatic);
+    append_vector(this->pressure_drop_accel, other.pressure_drop_accel);
+    append_vector(this->m_segment_number, other.m_segment_number);
+}
+
+SegmentStateSlice<double> SegmentState::slice(std::size_t offset, std::size_t num_segments, int num_phases) {
+    return {
+        {this->rates, offset * num_phases, num_segments * num_phases},
+        {this->pressure, offset, num_segments},
+        {this->pressure_drop_friction, offset, num_segments},
+        {this->pressure_drop_hydrostatic, offset, num_segments},
+        {this->pressure_drop_accel, offset, num_segments},
+        {this->m_segment_number, offset, num_segments}
+    };
+}
+
+SegmentStateSlice<const double> SegmentState::slice(std::size_t offset, std::size_t num_segments, int num_phases) const {
+    return {
+        {this->rates, offset * num_phases, num_segments * num_phases},
+        {this->pressure, offset, num_segments},
+        {this->pressure_drop_friction, offset, num_segments},
+        {this->pressure_drop_hydrostatic, offset, num_segments},
+        {this->pressure_drop_accel, offset, num_segments},
+        {this->m_segment_number, offset, num_segments}
+    };
+}
+
 }
@@ -20,14 +20,103 @@
 #ifndef OPM_SEGMENTSTATE_HEADER_INCLUDED
 #define OPM_SEGMENTSTATE_HEADER_INCLUDED
 
+#include <cstddef>
+#include <stdexcept>
 #include <vector>
 
+#include <opm/simulators/wells/ArraySlice.hpp>
+
 namespace Opm
 {
 
 class WellSegments;
 class WellConnections;
 
+/*
+  The segment quantities of a single multisegment well. The values are slices
+  of the arrays of a SegmentState object which holds the segments of all the
+  wells, see SegmentState::slice().
+*/
+template<class T>
+class SegmentStateSlice
+{
+public:
+    SegmentStateSlice(ArraySlice<T> rates_,
+                      ArraySlice<T> pressure_,
+                      ArraySlice<T> pressure_drop_friction_,
+                      ArraySlice<T> pressure_drop_hydrostatic_,
+                      ArraySlice<T> pressure_drop_accel_,
+                      ArraySlice<const int> segment_number_)
+        : rates(rates_)
+        , pressure(pressure_)
+        , pressure_drop_friction(pressure_drop_friction_)
+        , pressure_drop_hydrostatic(pressure_drop_hydrostatic_)
+        , pressure_drop_accel(pressure_drop_accel_)
+        , m_segment_number(segment_number_)
+    {}
+
+    double pressure_drop(std::size_t index) const {
+        return this->pressure_drop_friction[index] + this->pressure_drop_hydrostatic[index] + this->pressure_drop_accel[index];
+    }
+
+    bool empty() const {
+        return this->rates.empty();
+    }
+
+    void scale_pressure(double bhp) const {
+        if (this->empty())
+            throw std::logic_error("Tried to pressure scale empty SegmentState");
+
+        const auto scale_factor = bhp / this->pressure[0];
+        for (auto& p : this->pressure)
+            p *= scale_factor;
+    }
+
+    ArraySlice<const int> segment_number() const {
+        return this->m_segment_number;
+    }
+
+    std::size_t size() const {
+        return this->pressure.size();
+    }
+
+    /*
+      Copy the values from other, which must have the same number of
+      segments.
+    */
+    template<class U>
+    bool try_assign(const SegmentStateSlice<U>& other) const
+    {
+        if (this->size() != other.size() || this->rates.size() != other.rates.size())
+            return false;
+
+        this->rates.assign(other.rates);
+        this->pressure.assign(other.pressure);
+        this->pressure_drop_friction.assign(other.pressure_drop_friction);
+        this->pressure_drop_hydrostatic.assign(other.pressure_drop_hydrostatic);
+        this->pressure_drop_accel.assign(other.pressure_drop_accel);
+        return true;
+    }
+
+    template<class Visitor>
+    void visit(Visitor&& visitor) const
+    {
+        visitor(rates);
+        visitor(pressure);
+        visitor(pressure_drop_friction);
+        visitor(pressure_drop_hydrostatic);
+        visitor(pressure_drop_accel);
+    }
+
+    ArraySlice<T> rates;
+    ArraySlice<T> pressure;
+    ArraySlice<T> pressure_drop_friction;
+    ArraySlice<T> pressure_drop_hydrostatic;
+    ArraySlice<T> pressure_drop_accel;
+private:
+    ArraySlice<const int> m_segment_number;
+};
+
 
 class SegmentState
 {
@@ -40,6 +129,25 @@ public:
     const std::vector<int>& segment_number() const;
     std::size_t size() const;
 
+    /// Add the segments of other after the segments of this object.
+    void append(const SegmentState& other);
+
+    /// The segments [offset, offset + num_segments), typically the segments
+    /// of one well in the segment state of all wells.
+    SegmentStateSlice<double> slice(std::size_t offset, std::size_t num_segments, int num_phases);
+    SegmentStateSlice<const double> slice(std::size_t offset, std::size_t num_segments, int num_phases) const;
+
+    template<class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(rates);
+        serializer(pressure);
+        serializer(pressure_drop_friction);
+        serializer(pressure_drop_hydrostatic);
+        serializer(pressure_drop_accel);
+        serializer(m_segment_number);
+    }
+
     std::vector<double> rates;
     std::vector<double> pressure;
     std::vector<double> pressure_drop_friction;
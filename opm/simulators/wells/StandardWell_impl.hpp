@@ -202,7 +202,7 @@ namespace Opm
         const int np = number_of_phases_;
 
         std::vector<RateVector> connectionRates = connectionRates_; // Copy to get right size.
-        auto& perf_data = well_state.perfData(this->index_of_well_);
+        auto perf_data = well_state.perfData(this->index_of_well_);
         auto& perf_rates = perf_data.phase_rates;
         for (int perf = 0; perf < number_of_perforations_; ++perf) {
             // Calculate perforation quantities.
@@ -317,7 +317,7 @@ namespace Opm
         computePerfRate(intQuants, mob, bhp, Tw, perf, allow_cf,
                         cq_s, perf_dis_gas_rate, perf_vap_oil_rate, deferred_logger);
 
-        auto& perf_data = well_state.perfData(this->index_of_well_);
+        auto perf_data = well_state.perfData(this->index_of_well_);
         if constexpr (has_polymer && Base::has_polymermw) {
             if (this->isInjector()) {
                 // Store the original water flux computed from the reservoir quantities.
@@ -923,7 +923,7 @@ namespace Opm
         }
 
         // Compute the average pressure in each well block
-        const auto& perf_press = well_state.perfData(w).pressure;
+        const auto perf_press = well_state.perfData(w).pressure;
         auto p_above =  this->parallel_well_info_.communicateAboveValues(well_state.bhp(w),
                                                                          perf_press.data(),
                                                                          nperf);
@@ -1072,7 +1072,7 @@ namespace Opm
             std::transform(src, src + np, dest, dest, std::plus<>{});
         };
 
-        auto& perf_data = well_state.perfData(this->index_of_well_);
+        auto perf_data = well_state.perfData(this->index_of_well_);
         auto* wellPI = well_state.productivityIndex(this->index_of_well_).data();
         auto* connPI = perf_data.prod_index.data();
 
@@ -1135,7 +1135,7 @@ namespace Opm
         const int nperf = number_of_perforations_;
         const int np = number_of_phases_;
         std::vector<double> perfRates(b_perf.size(),0.0);
-        const auto& perf_data = well_state.perfData(this->index_of_well_);
+        const auto perf_data = well_state.perfData(this->index_of_well_);
         const auto& perf_rates_state = perf_data.phase_rates;
 
         for (int perf = 0; perf < nperf; ++perf) {
@@ -1379,10 +1379,11 @@ namespace Opm
     {
 
         // iterate to get a more accurate well density
-        // create a copy of the well_state to use. If the operability checking is sucessful, we use this one
-        // to replace the original one
-        WellState well_state_copy = ebosSimulator.problem().wellModel().wellState();
-        const auto& group_state  = ebosSimulator.problem().wellModel().groupState();
+        // the entries of this well in the well state are restored on return
+        const auto& well_model = ebosSimulator.problem().wellModel();
+        auto temporary_well_state = well_model.temporaryWellState(this->index_of_well_);
+        WellState& well_state_copy = temporary_well_state.get();
+        const auto& group_state  = well_model.groupState();
 
         //  Set current control to bhp, and bhp value in state, modify bhp limit in control object.
         if (well_ecl_.isInjector()) {
@@ -1590,7 +1591,7 @@ namespace Opm
         // other primary variables related to polymer injection
         if constexpr (Base::has_polymermw) {
             if (this->isInjector()) {
-                const auto& perf_data = well_state.perfData(this->index_of_well_);
+                const auto perf_data = well_state.perfData(this->index_of_well_);
                 const auto& water_velocity = perf_data.water_velocity;
                 const auto& skin_pressure = perf_data.skin_pressure;
                 for (int perf = 0; perf < number_of_perforations_; ++perf) {
@@ -1816,7 +1817,7 @@ namespace Opm
     {
         if constexpr (Base::has_polymermw) {
             if (this->isInjector()) {
-                auto& perf_water_throughput = well_state.perfData(this->index_of_well_).water_throughput;
+                auto perf_water_throughput = well_state.perfData(this->index_of_well_).water_throughput;
                 for (int perf = 0; perf < number_of_perforations_; ++perf) {
                     const double perf_water_vel = this->primary_variables_[Bhp + 1 + perf];
                     // we do not consider the formation damage due to water flowing from reservoir into wellbore
@@ -1877,7 +1878,7 @@ namespace Opm
         const EvalWell eq_wat_vel = this->primary_variables_evaluation_[wat_vel_index] - water_velocity;
         this->resWell_[0][wat_vel_index] = eq_wat_vel.value();
 
-        const auto& perf_data = well_state.perfData(this->index_of_well_);
+        const auto perf_data = well_state.perfData(this->index_of_well_);
         const auto& perf_water_throughput = perf_data.water_throughput;
         const double throughput = perf_water_throughput[perf];
         const int pskin_index = Bhp + 1 + number_of_perforations_ + perf;
@@ -1939,7 +1940,7 @@ namespace Opm
             const int wat_vel_index = Bhp + 1 + perf;
             const EvalWell water_velocity = this->primary_variables_evaluation_[wat_vel_index];
             if (water_velocity > 0.) { // injecting
-                const auto& perf_water_throughput = well_state.perfData(this->index_of_well_).water_throughput;
+                const auto perf_water_throughput = well_state.perfData(this->index_of_well_).water_throughput;
                 const double throughput = perf_water_throughput[perf];
                 const EvalWell molecular_weight = wpolymermw(throughput, water_velocity, deferred_logger);
                 cq_s_polymw *= molecular_weight;
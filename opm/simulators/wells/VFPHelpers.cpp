@@ -27,6 +27,7 @@
 #include <opm/parser/eclipse/EclipseState/Schedule/VFPInjTable.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/VFPProdTable.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <stdexcept>
@@ -498,6 +499,138 @@ double findTHP(const std::vector<double>& bhp_array,
     return thp;
 }
 
+THPInverseBracket::THPInverseBracket(const VFPProdTable& table,
+                                     const InterpData& flo_i,
+                                     const InterpData& wfr_i,
+                                     const InterpData& gfr_i,
+                                     const InterpData& alq_i)
+    : num_dims_(4)
+    , num_corners_(16)
+    , num_thp_(table.getTHPAxis().size())
+    , monotone_(true)
+    , corners_(num_thp_ * num_corners_)
+{
+    // Corner c = ((w*2 + g)*2 + a)*2 + f, so that pairwise blending of
+    // neighbouring entries collapses the axes in the same order as
+    // interpolate(): flo, alq, gfr and finally wfr.
+    for (int t = 0; t < num_thp_; ++t) {
+        double* corner = &corners_[t * num_corners_];
+        for (int w = 0; w <= 1; ++w) {
+            for (int g = 0; g <= 1; ++g) {
+                for (int a = 0; a <= 1; ++a) {
+                    for (int f = 0; f <= 1; ++f) {
+                        *corner++ = table(t, wfr_i.ind_[w], gfr_i.ind_[g],
+                                          alq_i.ind_[a], flo_i.ind_[f]);
+                    }
+                }
+            }
+        }
+    }
+
+    for (int t = 0; t + 1 < num_thp_ && monotone_; ++t) {
+        for (int c = 0; c < num_corners_; ++c) {
+            if (corners_[(t + 1) * num_corners_ + c] < corners_[t * num_corners_ + c]) {
+                monotone_ = false;
+                break;
+            }
+        }
+    }
+}
+
+THPInverseBracket::THPInverseBracket(const VFPInjTable& table,
+                                     const InterpData& flo_i)
+    : num_dims_(1)
+    , num_corners_(2)
+    , num_thp_(table.getTHPAxis().size())
+    , monotone_(true)
+    , corners_(num_thp_ * num_corners_)
+{
+    for (int t = 0; t < num_thp_; ++t) {
+        for (int f = 0; f <= 1; ++f) {
+            corners_[t * num_corners_ + f] = table(t, flo_i.ind_[f]);
+        }
+    }
+
+    for (int t = 0; t + 1 < num_thp_ && monotone_; ++t) {
+        for (int c = 0; c < num_corners_; ++c) {
+            if (corners_[(t + 1) * num_corners_ + c] < corners_[t * num_corners_ + c]) {
+                monotone_ = false;
+                break;
+            }
+        }
+    }
+}
+
+double THPInverseBracket::bhpAt(const int thp_idx,
+                                const std::array<double, 4>& factors) const
+{
+    double values[16];
+    std::copy_n(corners_.begin() + thp_idx * num_corners_, num_corners_, values);
+
+    int n = num_corners_;
+    for (int d = 0; d < num_dims_; ++d) {
+        const double t2 = factors[d];
+        const double t1 = 1.0 - t2;
+        n /= 2;
+        for (int i = 0; i < n; ++i) {
+            values[i] = values[2*i] * t1 + values[2*i + 1] * t2;
+        }
+    }
+
+    return values[0];
+}
+
+double THPInverseBracket::findTHP(const std::vector<double>& thp_array,
+                                  const std::array<double, 4>& factors,
+                                  const double bhp) const
+{
+    assert(static_cast<int>(thp_array.size()) == num_thp_);
+
+    const bool interpolating =
+        std::all_of(factors.begin(), factors.begin() + num_dims_,
+                    [](const double f) { return f >= 0.0 && f <= 1.0; });
+
+    if (!monotone_ || !interpolating || num_thp_ < 2) {
+        std::vector<double> bhp_array(num_thp_);
+        for (int i = 0; i < num_thp_; ++i) {
+            bhp_array[i] = bhpAt(i, factors);
+        }
+        return detail::findTHP(bhp_array, thp_array, bhp);
+    }
+
+    // The blended BHP values are sorted, so only the two end points of the
+    // bracketing THP interval are needed.
+    const double bhp_first = bhpAt(0, factors);
+    const double bhp_last = bhpAt(num_thp_ - 1, factors);
+    if (bhp <= bhp_first) {
+        return findX(thp_array[0], thp_array[1],
+                     bhp_first, bhpAt(1, factors), bhp);
+    }
+    if (bhp > bhp_last) {
+        return findX(thp_array[num_thp_ - 2], thp_array[num_thp_ - 1],
+                     bhpAt(num_thp_ - 2, factors), bhp_last, bhp);
+    }
+
+    // Invariant: bhp(lo) < bhp <= bhp(hi).
+    int lo = 0;
+    int hi = num_thp_ - 1;
+    double bhp_lo = bhp_first;
+    double bhp_hi = bhp_last;
+    while (hi - lo > 1) {
+        const int mid = lo + (hi - lo) / 2;
+        const double bhp_mid = bhpAt(mid, factors);
+        if (bhp_mid < bhp) {
+            lo = mid;
+            bhp_lo = bhp_mid;
+        } else {
+            hi = mid;
+            bhp_hi = bhp_mid;
+        }
+    }
+
+    return findX(thp_array[lo], thp_array[hi], bhp_lo, bhp_hi, bhp);
+}
+
 template <typename T>
 T getFlo(const VFPProdTable& table,
          const T& aqua,
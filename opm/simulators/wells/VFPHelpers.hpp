@@ -179,6 +179,56 @@ double findTHP(const std::vector<double>& bhp_array,
                double bhp);
 
 
+/**
+ * Inverse of the BHP(THP) relation for one interpolation bracket of the
+ * non-THP axes of a VFP table, i.e., for fixed lower/upper indices along
+ * the flo, wfr, gfr and alq axes.
+ *
+ * The table values at every THP axis point are stored for the 2^d corners
+ * of the bracket (d = 4 for production tables, d = 1 for injection tables),
+ * so that the BHP at a THP axis point is a blend of the corner values instead
+ * of a full table interpolation. If every corner is non-decreasing along the
+ * THP axis and the blend does not extrapolate, the blended BHP is
+ * non-decreasing as well, and THP is located by bisection. Otherwise we fall
+ * back to findTHP() on the full BHP array. Both paths give the same result as
+ * findTHP() on an array built with interpolate().
+ */
+class THPInverseBracket {
+public:
+    THPInverseBracket(const VFPProdTable& table,
+                      const InterpData& flo_i,
+                      const InterpData& wfr_i,
+                      const InterpData& gfr_i,
+                      const InterpData& alq_i);
+
+    THPInverseBracket(const VFPInjTable& table,
+                      const InterpData& flo_i);
+
+    /**
+     * Find THP so that BHP(THP) = bhp.
+     * @param thp_array THP axis of the table the bracket was built from.
+     * @param factors Interpolation factors in the order the axes are
+     *                collapsed: flo, alq, gfr, wfr. Injection tables only
+     *                use the first entry.
+     * @param bhp Target bottom hole pressure.
+     */
+    double findTHP(const std::vector<double>& thp_array,
+                   const std::array<double, 4>& factors,
+                   const double bhp) const;
+
+private:
+    // Blended BHP value at THP axis point thp_idx.
+    double bhpAt(const int thp_idx, const std::array<double, 4>& factors) const;
+
+    int num_dims_;
+    int num_corners_;
+    int num_thp_;
+    bool monotone_;
+    // Corner values, num_corners_ consecutive entries per THP axis point.
+    std::vector<double> corners_;
+};
+
+
 } // namespace detail
 
 
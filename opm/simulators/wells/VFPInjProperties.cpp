@@ -54,22 +54,14 @@ double VFPInjProperties::thp(int table_id,
     //Find interpolation variables
     double flo = detail::getFlo(table, aqua, liquid, vapour);
 
-    const std::vector<double> thp_array = table.getTHPAxis();
-    int nthp = thp_array.size();
-
     /**
-     * Find the function bhp_array(thp) by creating a 1D view of the data
-     * by interpolating for every value of thp. This might be somewhat
-     * expensive, but let us assome that nthp is small
+     * Find the function bhp_array(thp) from the cached corner values of the
+     * flo bracket, and invert it.
      */
     auto flo_i = detail::findInterpData(flo, table.getFloAxis());
-    std::vector<double> bhp_array(nthp);
-    for (int i=0; i<nthp; ++i) {
-        auto thp_i = detail::findInterpData(thp_array[i], thp_array);
-        bhp_array[i] = detail::interpolate(table, flo_i, thp_i).value;
-    }
+    const auto& inverse = this->thpInverse(table_id, table, flo_i);
 
-    double retval = detail::findTHP(bhp_array, thp_array, bhp_arg);
+    double retval = inverse.findTHP(table.getTHPAxis(), {flo_i.factor_, 0.0, 0.0, 0.0}, bhp_arg);
     return retval;
 }
 
@@ -81,6 +73,21 @@ bool VFPInjProperties::hasTable(const int table_id) const {
     return detail::hasTable(m_tables, table_id);
 }
 
+const detail::THPInverseBracket&
+VFPInjProperties::thpInverse(const int table_id,
+                             const VFPInjTable& table,
+                             const detail::InterpData& flo_i) const
+{
+    const BracketKey key{table_id, flo_i.ind_[0]};
+
+    std::lock_guard<std::mutex> lock(m_thp_inverse_mutex);
+    auto it = m_thp_inverse.find(key);
+    if (it == m_thp_inverse.end()) {
+        it = m_thp_inverse.emplace(key, detail::THPInverseBracket(table, flo_i)).first;
+    }
+    return it->second;
+}
+
 void VFPInjProperties::addTable(const VFPInjTable& new_table) {
     this->m_tables.emplace( new_table.getTableNum(), new_table );
 }
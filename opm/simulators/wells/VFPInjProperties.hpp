@@ -21,8 +21,12 @@
 #define OPM_AUTODIFF_VFPINJPROPERTIES_HPP_
 
 
+#include <opm/simulators/wells/VFPHelpers.hpp>
+
+#include <array>
 #include <functional>
 #include <map>
+#include <mutex>
 #include <vector>
 
 
@@ -97,7 +101,8 @@ public:
                const double& thp) const;
 
     /**
-     * Linear interpolation of thp as a function of the input parameters
+     * Linear interpolation of thp as a function of the input parameters.
+     * The BHP(THP) relation of each flo bracket is cached on first use.
      * @param table_id Table number to use
      * @param aqua Water phase
      * @param liquid Oil phase
@@ -116,6 +121,16 @@ public:
 protected:
     // Map which connects the table number with the table itself
     std::map<int, std::reference_wrapper<const VFPInjTable>> m_tables;
+
+    // Cached BHP(THP) inverses, keyed by table number and the lower bracket
+    // index along the flo axis.
+    using BracketKey = std::array<int, 2>;
+    const detail::THPInverseBracket& thpInverse(const int table_id,
+                                                const VFPInjTable& table,
+                                                const detail::InterpData& flo_i) const;
+
+    mutable std::map<BracketKey, detail::THPInverseBracket> m_thp_inverse;
+    mutable std::mutex m_thp_inverse_mutex;
 };
 
 
@@ -59,25 +59,19 @@ double VFPProdProperties::thp(int table_id,
         gfr = detail::getGFR(table, aqua, liquid, vapour);
     }
 
-    const std::vector<double> thp_array = table.getTHPAxis();
-    int nthp = thp_array.size();
-
     /**
-     * Find the function bhp_array(thp) by creating a 1D view of the data
-     * by interpolating for every value of thp. This might be somewhat
-     * expensive, but let us assome that nthp is small.
+     * Find the function bhp_array(thp) from the cached corner values of the
+     * interpolation bracket, and invert it.
      */
     auto flo_i = detail::findInterpData( flo, table.getFloAxis());
     auto wfr_i = detail::findInterpData( wfr, table.getWFRAxis());
     auto gfr_i = detail::findInterpData( gfr, table.getGFRAxis());
     auto alq_i = detail::findInterpData( alq, table.getALQAxis());
-    std::vector<double> bhp_array(nthp);
-    for (int i=0; i<nthp; ++i) {
-        auto thp_i = detail::findInterpData(thp_array[i], thp_array);
-        bhp_array[i] = detail::interpolate(table, flo_i, thp_i, wfr_i, gfr_i, alq_i).value;
-    }
 
-    double retval = detail::findTHP(bhp_array, thp_array, bhp_arg);
+    const auto& inverse = this->thpInverse(table_id, table, flo_i, wfr_i, gfr_i, alq_i);
+    double retval = inverse.findTHP(table.getTHPAxis(),
+                                    {flo_i.factor_, alq_i.factor_, gfr_i.factor_, wfr_i.factor_},
+                                    bhp_arg);
     return retval;
 }
 
@@ -135,6 +129,25 @@ bhpwithflo(const std::vector<double>& flos,
 }
 
 
+const detail::THPInverseBracket&
+VFPProdProperties::thpInverse(const int table_id,
+                              const VFPProdTable& table,
+                              const detail::InterpData& flo_i,
+                              const detail::InterpData& wfr_i,
+                              const detail::InterpData& gfr_i,
+                              const detail::InterpData& alq_i) const
+{
+    const BracketKey key{table_id, flo_i.ind_[0], wfr_i.ind_[0], gfr_i.ind_[0], alq_i.ind_[0]};
+
+    std::lock_guard<std::mutex> lock(m_thp_inverse_mutex);
+    auto it = m_thp_inverse.find(key);
+    if (it == m_thp_inverse.end()) {
+        it = m_thp_inverse.emplace(key, detail::THPInverseBracket(table, flo_i, wfr_i, gfr_i, alq_i)).first;
+    }
+    return it->second;
+}
+
+
 void VFPProdProperties::addTable(const VFPProdTable& new_table) {
     this->m_tables.emplace( new_table.getTableNum(), new_table );
 }
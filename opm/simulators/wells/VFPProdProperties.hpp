@@ -20,8 +20,12 @@
 #ifndef OPM_AUTODIFF_VFPPRODPROPERTIES_HPP_
 #define OPM_AUTODIFF_VFPPRODPROPERTIES_HPP_
 
+#include <opm/simulators/wells/VFPHelpers.hpp>
+
+#include <array>
 #include <functional>
 #include <map>
+#include <mutex>
 #include <vector>
 
 
@@ -87,7 +91,11 @@ public:
             const double& alq) const;
 
     /**
-     * Linear interpolation of thp as a function of the input parameters
+     * Linear interpolation of thp as a function of the input parameters.
+     * The BHP(THP) relation of each interpolation bracket is cached on first
+     * use, so repeated queries within the same bracket only blend the cached
+     * corner values. The cache lives as long as this object, which is rebuilt
+     * whenever the schedule provides a new set of VFP tables.
      * @param table_id Table number to use
      * @param aqua Water phase
      * @param liquid Oil phase
@@ -136,6 +144,19 @@ protected:
 
     // Map which connects the table number with the table itself
     std::map<int, std::reference_wrapper<const VFPProdTable>> m_tables;
+
+    // Cached BHP(THP) inverses, keyed by table number and the lower bracket
+    // indices along the flo, wfr, gfr and alq axes.
+    using BracketKey = std::array<int, 5>;
+    const detail::THPInverseBracket& thpInverse(const int table_id,
+                                                const VFPProdTable& table,
+                                                const detail::InterpData& flo_i,
+                                                const detail::InterpData& wfr_i,
+                                                const detail::InterpData& gfr_i,
+                                                const detail::InterpData& alq_i) const;
+
+    mutable std::map<BracketKey, detail::THPInverseBracket> m_thp_inverse;
+    mutable std::mutex m_thp_inverse_mutex;
 };
 
 
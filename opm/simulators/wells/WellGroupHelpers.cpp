@@ -31,7 +31,6 @@
 #include <opm/simulators/wells/TargetCalculator.hpp>
 #include <opm/simulators/wells/VFPProdProperties.hpp>
 #include <opm/simulators/wells/WellState.hpp>
-#include <opm/simulators/wells/WellContainer.hpp>
 
 #include <algorithm>
 #include <cassert>
@@ -39,8 +38,9 @@
 #include <stack>
 
 namespace {
+    template<class Rates>
     Opm::GuideRate::RateVector
-    getGuideRateVector(const std::vector<double>& rates, const Opm::PhaseUsage& pu)
+    getGuideRateVector(const Rates& rates, const Opm::PhaseUsage& pu)
     {
         using Opm::BlackoilPhases;
 
@@ -126,7 +126,7 @@ namespace WellGroupHelpers
                 schedule.getGroup(group.parent(), reportStepIdx), schedule, reportStepIdx, factor);
     }
 
-    double sumWellPhaseRates(const WellContainer<std::vector<double>>& rates,
+    double sumWellPhaseRates(const std::vector<double>& rates,
                              const Group& group,
                              const Schedule& schedule,
                              const WellState& wellState,
@@ -163,11 +163,11 @@ namespace WellGroupHelpers
                 continue;
 
             double factor = wellEcl.getEfficiencyFactor();
-            const auto& well_rates = rates[well_index];
+            const double well_rate = rates[well_index * wellState.numPhases() + phasePos];
             if (injector)
-                rate += factor * well_rates[phasePos];
+                rate += factor * well_rate;
             else
-                rate -= factor * well_rates[phasePos];
+                rate -= factor * well_rate;
         }
         const auto& gefac = group.getGroupEfficiencyFactor();
         return gefac * rate;
@@ -297,11 +297,132 @@ namespace WellGroupHelpers
         }
     }
 
-    void updateGroupTargetReduction(const Group& group,
-                                    const Schedule& schedule,
-                                    const int reportStepIdx,
+    GroupTree::GroupTree(const Schedule& schedule,
+                         const int reportStepIdx,
+                         const std::string& root)
+        : report_step_(reportStepIdx)
+    {
+        this->addGroup(schedule, root);
+    }
+
+    std::size_t GroupTree::addGroup(const Schedule& schedule, const std::string& name)
+    {
+        const Group& group = schedule.getGroup(name, this->report_step_);
+
+        std::vector<std::size_t> children;
+        for (const std::string& groupName : group.groups()) {
+            children.push_back(this->addGroup(schedule, groupName));
+        }
+
+        std::vector<WellNode> wells;
+        for (const std::string& wellName : group.wells()) {
+            const auto& wellEcl = schedule.getWell(wellName, this->report_step_);
+            wells.push_back({wellName,
+                             wellEcl.getEfficiencyFactor(),
+                             wellEcl.isProducer(),
+                             wellEcl.isInjector(),
+                             wellEcl.getStatus() == Well::Status::SHUT});
+        }
+
+        const std::size_t index = this->names_.size();
+        for (const auto child : children) {
+            this->parent_[child] = index;
+        }
+        this->names_.push_back(name);
+        this->parent_.push_back(-1);
+        this->efficiency_.push_back(group.getGroupEfficiencyFactor());
+        this->child_groups_.push_back(std::move(children));
+        this->child_wells_.push_back(std::move(wells));
+        return index;
+    }
+
+    std::vector<std::vector<double>>
+    GroupTree::sumWellPhaseRates(const std::vector<double>& rates,
+                                 const WellState& wellState,
+                                 const bool injector) const
+    {
+        const int np = wellState.numPhases();
+        std::vector<std::vector<double>> group_rates(this->size(), std::vector<double>(np, 0.0));
+        const auto& end = wellState.wellMap().end();
+        for (std::size_t group = 0; group < this->size(); ++group) {
+            auto& rate = group_rates[group];
+            for (const auto child : this->child_groups_[group]) {
+                for (int phase = 0; phase < np; ++phase) {
+                    rate[phase] += group_rates[child][phase];
+                }
+            }
+
+            for (const auto& well : this->child_wells_[group]) {
+                const auto& it = wellState.wellMap().find(well.name);
+                if (it == end) // the well is not found
+                    continue;
+
+                int well_index = it->second[0];
+
+                if (! wellState.wellIsOwned(well_index, well.name) ) // Only sum once
+                {
+                    continue;
+                }
+
+                // only count producers or injectors
+                if ((well.is_producer && injector) || (well.is_injector && !injector))
+                    continue;
+
+                if (well.is_shut)
+                    continue;
+
+                const auto* well_rates = &rates[well_index * np];
+                for (int phase = 0; phase < np; ++phase) {
+                    if (injector)
+                        rate[phase] += well.efficiency * well_rates[phase];
+                    else
+                        rate[phase] -= well.efficiency * well_rates[phase];
+                }
+            }
+
+            for (double& elem : rate) {
+                elem *= this->efficiency_[group];
+            }
+        }
+        return group_rates;
+    }
+
+    std::vector<int>
+    GroupTree::groupControlledWells(const WellState& well_state,
+                                    const GroupState& group_state,
+                                    const bool is_production_group,
+                                    const Phase injection_phase) const
+    {
+        std::vector<int> num_wells(this->size(), 0);
+        for (std::size_t group = 0; group < this->size(); ++group) {
+            for (const auto child : this->child_groups_[group]) {
+                bool included = false;
+                if (is_production_group) {
+                    const auto ctrl = group_state.production_control(this->names_[child]);
+                    included = (ctrl == Group::ProductionCMode::FLD) || (ctrl == Group::ProductionCMode::NONE);
+                } else {
+                    const auto ctrl = group_state.injection_control(this->names_[child], injection_phase);
+                    included = (ctrl == Group::InjectionCMode::FLD) || (ctrl == Group::InjectionCMode::NONE);
+                }
+
+                if (included) {
+                    num_wells[group] += num_wells[child];
+                }
+            }
+            for (const auto& well : this->child_wells_[group]) {
+                const bool included = is_production_group
+                    ? well_state.isProductionGrup(well.name)
+                    : well_state.isInjectionGrup(well.name);
+                if (included) {
+                    ++num_wells[group];
+                }
+            }
+        }
+        return num_wells;
+    }
+
+    void updateGroupTargetReduction(const GroupTree& group_tree,
                                     const bool isInjector,
-                                    const PhaseUsage& pu,
                                     const GuideRate& guide_rate,
                                     const WellState& wellStateNupcol,
                                     WellState& wellState,
@@ -309,121 +430,128 @@ namespace WellGroupHelpers
                                     std::vector<double>& groupTargetReduction)
     {
         const int np = wellState.numPhases();
-        for (const std::string& subGroupName : group.groups()) {
-            std::vector<double> subGroupTargetReduction(np, 0.0);
-            const Group& subGroup = schedule.getGroup(subGroupName, reportStepIdx);
-            updateGroupTargetReduction(subGroup,
-                                       schedule,
-                                       reportStepIdx,
-                                       isInjector,
-                                       pu,
-                                       guide_rate,
-                                       wellStateNupcol,
-                                       wellState,
-                                       group_state,
-                                       subGroupTargetReduction);
-
-            // accumulate group contribution from sub group
-            if (isInjector) {
-                const Phase all[] = {Phase::WATER, Phase::OIL, Phase::GAS};
-                bool individual_control = false;
-                int num_group_controlled_wells = 0;
-                for (Phase phase : all) {
-                    const Group::InjectionCMode& currentGroupControl
-                            = group_state.injection_control(subGroup.name(), phase);
-                    individual_control = individual_control || (currentGroupControl != Group::InjectionCMode::FLD
-                            && currentGroupControl != Group::InjectionCMode::NONE);
-                    num_group_controlled_wells
-                            += groupControlledWells(schedule, wellStateNupcol, group_state, reportStepIdx, subGroupName, "", !isInjector, phase);
-                }
-                if (individual_control || num_group_controlled_wells == 0) {
-                    for (int phase = 0; phase < np; phase++) {
-                        groupTargetReduction[phase]
-                            += sumWellRates(subGroup, schedule, wellStateNupcol, reportStepIdx, phase, isInjector);
-                    }
-                } else {
-                    // The subgroup may participate in group control.
-                    bool has_guide_rate = false;
-                    for (Phase phase : all) {
-                        has_guide_rate = has_guide_rate || guide_rate.has(subGroupName, phase);
-                    }
+        const Phase all[] = {Phase::WATER, Phase::OIL, Phase::GAS};
+
+        // Subtree rates and numbers of group controlled wells of all groups,
+        // each computed in one bottom-up pass over the tree.
+        const auto subGroupRates = group_tree.sumWellPhaseRates(wellStateNupcol.wellRates(), wellStateNupcol, isInjector);
+        std::vector<std::vector<int>> numGroupControlledWells;
+        if (isInjector) {
+            for (Phase phase : all) {
+                numGroupControlledWells.push_back(group_tree.groupControlledWells(wellStateNupcol, group_state, !isInjector, phase));
+            }
+        } else {
+            numGroupControlledWells.push_back(group_tree.groupControlledWells(wellStateNupcol, group_state, !isInjector, /*injectionPhaseNotUsed*/Phase::OIL));
+        }
 
-                    if (!has_guide_rate) {
-                        // Accumulate from this subgroup only if no group guide rate is set for it.
+        std::vector<std::vector<double>> targetReductions(group_tree.size());
+        for (std::size_t group = 0; group < group_tree.size(); ++group) {
+            auto& targetReduction = targetReductions[group];
+            if (group == group_tree.root())
+                targetReduction = groupTargetReduction;
+            else
+                targetReduction.assign(np, 0.0);
+
+            for (const auto subGroup : group_tree.childGroups(group)) {
+                const std::string& subGroupName = group_tree.name(subGroup);
+                const auto& subGroupTargetReduction = targetReductions[subGroup];
+
+                // accumulate group contribution from sub group
+                if (isInjector) {
+                    bool individual_control = false;
+                    int num_group_controlled_wells = 0;
+                    for (std::size_t p = 0; p < numGroupControlledWells.size(); ++p) {
+                        const Group::InjectionCMode& currentGroupControl
+                                = group_state.injection_control(subGroupName, all[p]);
+                        individual_control = individual_control || (currentGroupControl != Group::InjectionCMode::FLD
+                                && currentGroupControl != Group::InjectionCMode::NONE);
+                        num_group_controlled_wells += numGroupControlledWells[p][subGroup];
+                    }
+                    if (individual_control || num_group_controlled_wells == 0) {
                         for (int phase = 0; phase < np; phase++) {
-                            groupTargetReduction[phase] += subGroupTargetReduction[phase];
+                            targetReduction[phase] += subGroupRates[subGroup][phase];
+                        }
+                    } else {
+                        // The subgroup may participate in group control.
+                        bool has_guide_rate = false;
+                        for (Phase phase : all) {
+                            has_guide_rate = has_guide_rate || guide_rate.has(subGroupName, phase);
+                        }
+
+                        if (!has_guide_rate) {
+                            // Accumulate from this subgroup only if no group guide rate is set for it.
+                            for (int phase = 0; phase < np; phase++) {
+                                targetReduction[phase] += subGroupTargetReduction[phase];
+                            }
                         }
-                    }
-                }
-            } else {
-                const Group::ProductionCMode& currentGroupControl = group_state.production_control(subGroupName);
-                const bool individual_control = (currentGroupControl != Group::ProductionCMode::FLD
-                                                 && currentGroupControl != Group::ProductionCMode::NONE);
-                const int num_group_controlled_wells
-                    = groupControlledWells(schedule, wellStateNupcol, group_state, reportStepIdx, subGroupName, "", !isInjector, /*injectionPhaseNotUsed*/Phase::OIL);
-                if (individual_control || num_group_controlled_wells == 0) {
-                    for (int phase = 0; phase < np; phase++) {
-                        groupTargetReduction[phase]
-                            += sumWellRates(subGroup, schedule, wellStateNupcol, reportStepIdx, phase, isInjector);
                     }
                 } else {
-                    // The subgroup may participate in group control.
-                    if (!guide_rate.has(subGroupName)) {
-                        // Accumulate from this subgroup only if no group guide rate is set for it.
+                    const Group::ProductionCMode& currentGroupControl = group_state.production_control(subGroupName);
+                    const bool individual_control = (currentGroupControl != Group::ProductionCMode::FLD
+                                                     && currentGroupControl != Group::ProductionCMode::NONE);
+                    const int num_group_controlled_wells = numGroupControlledWells[0][subGroup];
+                    if (individual_control || num_group_controlled_wells == 0) {
                         for (int phase = 0; phase < np; phase++) {
-                            groupTargetReduction[phase] += subGroupTargetReduction[phase];
+                            targetReduction[phase] += subGroupRates[subGroup][phase];
+                        }
+                    } else {
+                        // The subgroup may participate in group control.
+                        if (!guide_rate.has(subGroupName)) {
+                            // Accumulate from this subgroup only if no group guide rate is set for it.
+                            for (int phase = 0; phase < np; phase++) {
+                                targetReduction[phase] += subGroupTargetReduction[phase];
+                            }
                         }
                     }
                 }
             }
-        }
 
-        for (const std::string& wellName : group.wells()) {
-            const auto& wellTmp = schedule.getWell(wellName, reportStepIdx);
+            for (const auto& wellTmp : group_tree.childWells(group)) {
+                if (wellTmp.is_producer && isInjector)
+                    continue;
 
-            if (wellTmp.isProducer() && isInjector)
-                continue;
+                if (wellTmp.is_injector && !isInjector)
+                    continue;
 
-            if (wellTmp.isInjector() && !isInjector)
-                continue;
+                if (wellTmp.is_shut)
+                    continue;
 
-            if (wellTmp.getStatus() == Well::Status::SHUT)
-                continue;
+                const auto& end = wellState.wellMap().end();
+                const auto& it = wellState.wellMap().find(wellTmp.name);
+                if (it == end) // the well is not found
+                    continue;
 
-            const auto& end = wellState.wellMap().end();
-            const auto& it = wellState.wellMap().find(wellName);
-            if (it == end) // the well is not found
-                continue;
+                int well_index = it->second[0];
 
-            int well_index = it->second[0];
+                if (! wellState.wellIsOwned(well_index, wellTmp.name) ) // Only sum once
+                {
+                    continue;
+                }
 
-            if (! wellState.wellIsOwned(well_index, wellName) ) // Only sum once
-            {
-                continue;
+                const double efficiency = wellTmp.efficiency;
+                // add contributino from wells not under group control
+                if (isInjector) {
+                    if (wellState.currentInjectionControl(well_index) != Well::InjectorCMode::GRUP)
+                        for (int phase = 0; phase < np; phase++) {
+                            targetReduction[phase] += wellStateNupcol.wellRates(well_index)[phase] * efficiency;
+                        }
+                } else {
+                    if (wellState.currentProductionControl(well_index) != Well::ProducerCMode::GRUP)
+                        for (int phase = 0; phase < np; phase++) {
+                            targetReduction[phase] -= wellStateNupcol.wellRates(well_index)[phase] * efficiency;
+                        }
+                }
             }
-
-            const double efficiency = wellTmp.getEfficiencyFactor();
-            // add contributino from wells not under group control
-            if (isInjector) {
-                if (wellState.currentInjectionControl(well_index) != Well::InjectorCMode::GRUP)
-                    for (int phase = 0; phase < np; phase++) {
-                        groupTargetReduction[phase] += wellStateNupcol.wellRates(well_index)[phase] * efficiency;
-                    }
-            } else {
-                if (wellState.currentProductionControl(well_index) != Well::ProducerCMode::GRUP)
-                    for (int phase = 0; phase < np; phase++) {
-                        groupTargetReduction[phase] -= wellStateNupcol.wellRates(well_index)[phase] * efficiency;
-                    }
+            const double groupEfficiency = group_tree.efficiency(group);
+            for (double& elem : targetReduction) {
+                elem *= groupEfficiency;
             }
+            if (isInjector)
+                group_state.update_injection_reduction_rates(group_tree.name(group), targetReduction);
+            else
+                group_state.update_production_reduction_rates(group_tree.name(group), targetReduction);
         }
-        const double groupEfficiency = group.getGroupEfficiencyFactor();
-        for (double& elem : groupTargetReduction) {
-            elem *= groupEfficiency;
-        }
-        if (isInjector)
-            group_state.update_injection_reduction_rates(group.name(), groupTargetReduction);
-        else
-            group_state.update_production_reduction_rates(group.name(), groupTargetReduction);
+        groupTargetReduction = targetReductions[group_tree.root()];
     }
 
     void updateWellRatesFromGroupTargetScale(const double scale,
@@ -497,54 +625,34 @@ namespace WellGroupHelpers
     }
 
 
-    void updateVREPForGroups(const Group& group,
-                             const Schedule& schedule,
-                             const int reportStepIdx,
+    void updateVREPForGroups(const GroupTree& group_tree,
                              const WellState& wellStateNupcol,
                              WellState& wellState,
                              GroupState& group_state)
     {
-        for (const std::string& groupName : group.groups()) {
-            const Group& groupTmp = schedule.getGroup(groupName, reportStepIdx);
-            updateVREPForGroups(groupTmp, schedule, reportStepIdx, wellStateNupcol, wellState, group_state);
+        const auto group_rates = group_tree.sumWellPhaseRates(wellStateNupcol.wellReservoirRates(),
+                                                              wellState,
+                                                              /*isInjector*/ false);
+        for (std::size_t group = 0; group < group_tree.size(); ++group) {
+            double resv = 0.0;
+            for (const double rate : group_rates[group]) {
+                resv += rate;
+            }
+            group_state.update_injection_vrep_rate(group_tree.name(group), resv);
         }
-        const int np = wellState.numPhases();
-        double resv = 0.0;
-        for (int phase = 0; phase < np; ++phase) {
-            resv += sumWellPhaseRates(wellStateNupcol.wellReservoirRates(),
-                                      group,
-                                      schedule,
-                                      wellState,
-                                      reportStepIdx,
-                                      phase,
-                                      /*isInjector*/ false);
-        }
-        group_state.update_injection_vrep_rate(group.name(), resv);
     }
 
-    void updateReservoirRatesInjectionGroups(const Group& group,
-                                             const Schedule& schedule,
-                                             const int reportStepIdx,
+    void updateReservoirRatesInjectionGroups(const GroupTree& group_tree,
                                              const WellState& wellStateNupcol,
                                              WellState& wellState,
                                              GroupState& group_state)
     {
-        for (const std::string& groupName : group.groups()) {
-            const Group& groupTmp = schedule.getGroup(groupName, reportStepIdx);
-            updateReservoirRatesInjectionGroups(groupTmp, schedule, reportStepIdx, wellStateNupcol, wellState, group_state);
+        const auto group_rates = group_tree.sumWellPhaseRates(wellStateNupcol.wellReservoirRates(),
+                                                              wellState,
+                                                              /*isInjector*/ true);
+        for (std::size_t group = 0; group < group_tree.size(); ++group) {
+            group_state.update_injection_reservoir_rates(group_tree.name(group), group_rates[group]);
         }
-        const int np = wellState.numPhases();
-        std::vector<double> resv(np, 0.0);
-        for (int phase = 0; phase < np; ++phase) {
-            resv[phase] = sumWellPhaseRates(wellStateNupcol.wellReservoirRates(),
-                                            group,
-                                            schedule,
-                                            wellState,
-                                            reportStepIdx,
-                                            phase,
-                                            /*isInjector*/ true);
-        }
-        group_state.update_injection_reservoir_rates(group.name(), resv);
     }
 
     void updateWellRates(const Group& group,
@@ -573,29 +681,24 @@ namespace WellGroupHelpers
                 for (int phase = 0; phase < np; ++phase) {
                     rates[phase] = sign * wellStateNupcol.wellRates(well_index)[phase];
                 }
+                wellState.setCurrentWellRates(static_cast<std::size_t>(well_index), rates);
             }
-            wellState.setCurrentWellRates(wellName, rates);
+            else
+                wellState.setCurrentWellRates(wellName, rates);
         }
     }
 
-    void updateGroupProductionRates(const Group& group,
-                                    const Schedule& schedule,
-                                    const int reportStepIdx,
+    void updateGroupProductionRates(const GroupTree& group_tree,
                                     const WellState& wellStateNupcol,
                                     WellState& wellState,
                                     GroupState& group_state)
     {
-        for (const std::string& groupName : group.groups()) {
-            const Group& groupTmp = schedule.getGroup(groupName, reportStepIdx);
-            updateGroupProductionRates(groupTmp, schedule, reportStepIdx, wellStateNupcol, wellState, group_state);
-        }
-        const int np = wellState.numPhases();
-        std::vector<double> rates(np, 0.0);
-        for (int phase = 0; phase < np; ++phase) {
-            rates[phase] = sumWellPhaseRates(
-                wellStateNupcol.wellRates(), group, schedule, wellState, reportStepIdx, phase, /*isInjector*/ false);
+        const auto group_rates = group_tree.sumWellPhaseRates(wellStateNupcol.wellRates(),
+                                                              wellState,
+                                                              /*isInjector*/ false);
+        for (std::size_t group = 0; group < group_tree.size(); ++group) {
+            group_state.update_production_rates(group_tree.name(group), group_rates[group]);
         }
-        group_state.update_production_rates(group.name(), rates);
     }
 
 
@@ -39,9 +39,6 @@ class Schedule;
 class VFPProdProperties;
 class WellState;
 
-template <typename>
-class WellContainer;
-
 namespace Network { class ExtNetwork; }
 
 namespace WellGroupHelpers
@@ -61,7 +58,10 @@ namespace WellGroupHelpers
                                          const int reportStepIdx,
                                          double& factor);
 
-    double sumWellPhaseRates(const WellContainer<std::vector<double>>& rates,
+    /// Sum of the rates of the wells below group, where rates holds
+    /// wellState.numPhases() values per local well, like
+    /// WellState::wellRates().
+    double sumWellPhaseRates(const std::vector<double>& rates,
                              const Group& group,
                              const Schedule& schedule,
                              const WellState& wellState,
@@ -89,11 +89,65 @@ namespace WellGroupHelpers
                            const int reportStepIdx,
                            const bool injector);
 
-    void updateGroupTargetReduction(const Group& group,
-                                    const Schedule& schedule,
-                                    const int reportStepIdx,
+    /// Flattened group hierarchy below a root group at one report step.
+    /// Groups are numbered in topological order, every group after all of
+    /// its subgroups, so that quantities summed over subtrees are built in
+    /// a single bottom-up pass instead of walking the subtree below every
+    /// group separately.  Only schedule data is stored, so the tree stays
+    /// valid until the report step changes or ACTIONX modifies the wells.
+    class GroupTree
+    {
+    public:
+        struct WellNode
+        {
+            std::string name;
+            double efficiency;
+            bool is_producer;
+            bool is_injector;
+            bool is_shut;
+        };
+
+        GroupTree(const Schedule& schedule,
+                  const int reportStepIdx,
+                  const std::string& root = "FIELD");
+
+        int reportStep() const { return report_step_; }
+        std::size_t size() const { return names_.size(); }
+        std::size_t root() const { return names_.size() - 1; }
+
+        const std::string& name(const std::size_t group) const { return names_[group]; }
+        int parent(const std::size_t group) const { return parent_[group]; }
+        double efficiency(const std::size_t group) const { return efficiency_[group]; }
+        const std::vector<std::size_t>& childGroups(const std::size_t group) const { return child_groups_[group]; }
+        const std::vector<WellNode>& childWells(const std::size_t group) const { return child_wells_[group]; }
+
+        /// sumWellPhaseRates() for every group and phase of the tree,
+        /// indexed as [group][phase].
+        std::vector<std::vector<double>>
+        sumWellPhaseRates(const std::vector<double>& rates,
+                          const WellState& wellState,
+                          const bool injector) const;
+
+        /// groupControlledWells() without an always included child, for
+        /// every group of the tree.
+        std::vector<int> groupControlledWells(const WellState& well_state,
+                                              const GroupState& group_state,
+                                              const bool is_production_group,
+                                              const Phase injection_phase) const;
+
+    private:
+        std::size_t addGroup(const Schedule& schedule, const std::string& name);
+
+        int report_step_;
+        std::vector<std::string> names_;
+        std::vector<int> parent_;
+        std::vector<double> efficiency_;
+        std::vector<std::vector<std::size_t>> child_groups_;
+        std::vector<std::vector<WellNode>> child_wells_;
+    };
+
+    void updateGroupTargetReduction(const GroupTree& group_tree,
                                     const bool isInjector,
-                                    const PhaseUsage& pu,
                                     const GuideRate& guide_rate,
                                     const WellState& wellStateNupcol,
                                     WellState& wellState,
@@ -145,16 +199,12 @@ namespace WellGroupHelpers
                                             GuideRate* guideRate,
                                             Opm::DeferredLogger& deferred_logger);
 
-    void updateVREPForGroups(const Group& group,
-                             const Schedule& schedule,
-                             const int reportStepIdx,
+    void updateVREPForGroups(const GroupTree& group_tree,
                              const WellState& wellStateNupcol,
                              WellState& wellState,
                              GroupState& group_state);
 
-    void updateReservoirRatesInjectionGroups(const Group& group,
-                                             const Schedule& schedule,
-                                             const int reportStepIdx,
+    void updateReservoirRatesInjectionGroups(const GroupTree& group_tree,
                                              const WellState& wellStateNupcol,
                                              WellState& wellState,
                                              GroupState& group_state);
@@ -165,9 +215,7 @@ namespace WellGroupHelpers
                          const WellState& wellStateNupcol,
                          WellState& wellState);
 
-    void updateGroupProductionRates(const Group& group,
-                                    const Schedule& schedule,
-                                    const int reportStepIdx,
+    void updateGroupProductionRates(const GroupTree& group_tree,
                                     const WellState& wellStateNupcol,
                                     WellState& wellState,
                                     GroupState& group_state);
@@ -846,7 +846,7 @@ checkMaxRatioLimitCompletions(const WellState& well_state,
     double max_ratio_completion = 0;
     const int np = number_of_phases_;
 
-    const auto& perf_data = well_state.perfData(this->index_of_well_);
+    const auto perf_data = well_state.perfData(this->index_of_well_);
     const auto& perf_phase_rates = perf_data.phase_rates;
     // look for the worst_offending_completion
     for (const auto& completion : completions_) {
@@ -1095,7 +1095,7 @@ getGroupProductionTargetRate(const Group& group,
     // Avoid negative target rates coming from too large local reductions.
     const double target_rate = std::max(0.0, target / efficiencyFactor);
     const auto& rates = well_state.wellRates(index_of_well_);
-    const auto current_rate = -tcalc.calcModeRateFromRates(rates); // Switch sign since 'rates' are negative for producers.
+    const auto current_rate = -tcalc.calcModeRateFromRates(rates.data()); // Switch sign since 'rates' are negative for producers.
     double scale = 1.0;
     if (current_rate > 1e-14)
         scale = target_rate/current_rate;
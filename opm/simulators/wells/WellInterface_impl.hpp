@@ -313,8 +313,8 @@ namespace Opm
     solveWellForTesting(const Simulator& ebosSimulator, WellState& well_state, const GroupState& group_state,
                         DeferredLogger& deferred_logger)
     {
-        // keep a copy of the original well state
-        const WellState well_state0 = well_state;
+        // keep a copy of the original state of this well
+        const auto well_state0 = well_state.snapshotWell(this->index_of_well_);
         const double dt = ebosSimulator.timeStepSize();
         const bool converged = iterateWellEquations(ebosSimulator, dt, well_state, group_state, deferred_logger);
         if (converged) {
@@ -323,7 +323,7 @@ namespace Opm
             const int max_iter = param_.max_welleq_iter_;
             deferred_logger.debug("WellTest: Well equation for well " + this->name() + " failed converging in "
                           + std::to_string(max_iter) + " iterations");
-            well_state = well_state0;
+            well_state.restoreWell(well_state0);
         }
     }
 
@@ -338,8 +338,8 @@ namespace Opm
         if (!this->isOperable())
             return;
 
-        // keep a copy of the original well state
-        const WellState well_state0 = well_state;
+        // keep a copy of the original state of this well
+        const auto well_state0 = well_state.snapshotWell(this->index_of_well_);
         const double dt = ebosSimulator.timeStepSize();
         const bool converged = iterateWellEquations(ebosSimulator, dt, well_state, group_state, deferred_logger);
         if (!converged) {
@@ -350,7 +350,7 @@ namespace Opm
             if (this->shutUnsolvableWells())
                 this->operability_status_.solvable = false;
 
-            well_state = well_state0;
+            well_state.restoreWell(well_state0);
         }
     }
 
@@ -454,32 +454,34 @@ namespace Opm
         // If the well is not operable during any of the time. It means it does not pass the physical
         // limit test.
 
-        // create a copy of the well_state to use. If the operability checking is sucessful, we use this one
-        // to replace the original one
-        WellState well_state_copy = well_state;
+        // work on the well state directly, and roll this well back to its original state
+        // if the operability checking is not sucessful
+        const auto well_state0 = well_state.snapshotWell(this->index_of_well_);
 
         // TODO: well state for this well is kind of all zero status
         // we should be able to provide a better initialization
-        calculateExplicitQuantities(ebos_simulator, well_state_copy, deferred_logger);
+        calculateExplicitQuantities(ebos_simulator, well_state, deferred_logger);
 
-        updateWellOperability(ebos_simulator, well_state_copy, deferred_logger);
+        updateWellOperability(ebos_simulator, well_state, deferred_logger);
 
         if ( !this->isOperable() ) {
             const std::string msg = " well " + this->name() + " is not operable during well testing for physical reason";
             deferred_logger.debug(msg);
+            well_state.restoreWell(well_state0);
             return;
         }
 
-        updateWellStateWithTarget(ebos_simulator, group_state, well_state_copy, deferred_logger);
+        updateWellStateWithTarget(ebos_simulator, group_state, well_state, deferred_logger);
 
-        calculateExplicitQuantities(ebos_simulator, well_state_copy, deferred_logger);
+        calculateExplicitQuantities(ebos_simulator, well_state, deferred_logger);
 
         const double dt = ebos_simulator.timeStepSize();
-        const bool converged = this->iterateWellEquations(ebos_simulator, dt, well_state_copy, group_state, deferred_logger);
+        const bool converged = this->iterateWellEquations(ebos_simulator, dt, well_state, group_state, deferred_logger);
 
         if (!converged) {
             const std::string msg = " well " + this->name() + " did not get converged during well testing for physical reason";
             deferred_logger.debug(msg);
+            well_state.restoreWell(well_state0);
             return;
         }
 
@@ -487,9 +489,9 @@ namespace Opm
             welltest_state.openWell(this->name(), WellTestConfig::PHYSICAL );
             const std::string msg = " well " + this->name() + " is re-opened through well testing for physical reason";
             deferred_logger.info(msg);
-            well_state = well_state_copy;
         } else {
             const std::string msg = " well " + this->name() + " is not operable during well testing for physical reason";
+            well_state.restoreWell(well_state0);
             deferred_logger.debug(msg);
         }
     }
@@ -40,21 +40,34 @@ void WellState::base_init(const std::vector<double>& cellPressures,
 {
     // clear old name mapping
     this->wellMap_.clear();
-    this->perfdata.clear();
     this->status_.clear();
     this->well_perf_data_.clear();
     this->parallel_well_info_.clear();
-    this->wellrates_.clear();
     this->bhp_.clear();
     this->thp_.clear();
     this->temperature_.clear();
-    this->segment_state.clear();
-    this->well_potentials_.clear();
-    this->productivity_index_.clear();
     {
         // const int nw = wells->number_of_wells;
         const int nw = wells_ecl.size();
-        // const int np = wells->number_of_phases;
+        const int np = this->numPhases();
+
+        // The perforation data of a distributed well holds all perforations
+        // of the well on every process.
+        this->perf_offset_.assign(1, 0);
+        for (int w = 0; w < nw; ++w) {
+            const std::size_t num_perf_this_well = parallel_well_info[w]->communication().sum(well_perf_data[w].size());
+            this->perf_offset_.push_back(this->perf_offset_.back() + num_perf_this_well);
+        }
+        this->perfdata = PerfData(this->perf_offset_.back(), true, this->phase_usage_);
+
+        // The segments are set up by initWellStateMSWell().
+        this->segment_state = SegmentState{};
+        this->segment_offset_.assign(nw + 1, 0);
+
+        this->wellrates_.assign(nw * np, 0.0);
+        this->well_potentials_.assign(nw * np, 0.0);
+        this->productivity_index_.assign(nw * np, 0.0);
+
         int connpos = 0;
         for (int w = 0; w < nw; ++w) {
             const Well& well = wells_ecl[w];
@@ -91,19 +104,13 @@ void WellState::initSingleWell(const std::vector<double>& cellPressures,
     // Set default zero initial well rates.
     // May be overwritten below.
     const auto& pu = this->phase_usage_;
-    const int np = pu.num_phases;
 
     this->status_.add(well.name(), Well::Status::OPEN);
     this->well_perf_data_.add(well.name(), well_perf_data);
     this->parallel_well_info_.add(well.name(), well_info);
-    this->wellrates_.add(well.name(), std::vector<double>(np, 0));
-    this->well_potentials_.add(well.name(), std::vector<double>(np, 0));
-    const int num_perf_this_well = well_info->communication().sum(well_perf_data_[w].size());
-    this->segment_state.add(well.name(), SegmentState{});
-    this->perfdata.add(well.name(), PerfData{static_cast<std::size_t>(num_perf_this_well), well.isInjector(), this->phase_usage_});
+    const int num_perf_this_well = this->numPerf(w);
     this->bhp_.add(well.name(), 0.0);
     this->thp_.add(well.name(), 0.0);
-    this->productivity_index_.add(well.name(), std::vector<double>(np, 0));
     if ( well.isInjector() )
         this->temperature_.add(well.name(), well.injectionControls(summary_state).temperature);
     else
@@ -158,7 +165,7 @@ void WellState::initSingleWell(const std::vector<double>& cellPressures,
         //    (producer) or RATE (injector).
         //    Otherwise, we cannot set the correct
         //    value here and initialize to zero rate.
-        auto& rates = this->wellrates_[w];
+        auto rates = this->wellRates(w);
         if (well.isInjector()) {
             if (inj_controls.cmode == Well::InjectorCMode::RATE) {
                 switch (inj_controls.injector_type) {
@@ -241,12 +248,14 @@ void WellState::init(const std::vector<double>& cellPressures,
     this->global_well_info = std::make_optional<GlobalWellInfo>( schedule, report_step, wells_ecl );
     for (const auto& wname : schedule.wellNames(report_step))
     {
-        well_rates.insert({wname, std::make_pair(false, std::vector<double>(this->numPhases()))});
+        if (!current_rates_owner_.has(wname))
+            this->add_current_rates(wname);
     }
     for (const auto& winfo: parallel_well_info)
     {
-        well_rates[winfo->name()].first = winfo->isOwner();
+        current_rates_owner_[winfo->name()] = winfo->isOwner();
     }
+    this->update_current_rates_index();
 
     const int nw = wells_ecl.size();
 
@@ -263,7 +272,7 @@ void WellState::init(const std::vector<double>& cellPressures,
         nperf += wpd.size();
     }
 
-    well_reservoir_rates_.clear();
+    well_reservoir_rates_.assign(nw * np, 0.0);
     well_dissolved_gas_rates_.clear();
     well_vaporized_oil_rates_.clear();
 
@@ -287,7 +296,7 @@ void WellState::init(const std::vector<double>& cellPressures,
         const auto& well_info = this->wellMap().at(wname);
         const int num_perf_this_well = well_info[2];
         const int global_num_perf_this_well = ecl_well.getConnections().num_open();
-        auto& perf_data = this->perfData(w);
+        auto perf_data = this->perfData(w);
 
         for (int perf = 0; perf < num_perf_this_well; ++perf) {
             if (wells_ecl[w].getStatus() == Well::Status::OPEN) {
@@ -298,7 +307,6 @@ void WellState::init(const std::vector<double>& cellPressures,
             perf_data.pressure[perf] = cellPressures[well_perf_data[w][perf].cell_index];
         }
 
-        this->well_reservoir_rates_.add(wname, std::vector<double>(np, 0));
         this->well_dissolved_gas_rates_.add(wname, 0);
         this->well_vaporized_oil_rates_.add(wname, 0);
     }
@@ -379,13 +387,11 @@ void WellState::init(const std::vector<double>& cellPressures,
                     current_production_controls_[ newIndex ] = prevState->currentProductionControl(oldIndex);
                 }
 
-                wellRates(w) = prevState->wellRates(oldIndex);
-                wellReservoirRates(w) = prevState->wellReservoirRates(oldIndex);
+                wellRates(w).assign(prevState->wellRates(oldIndex));
+                wellReservoirRates(w).assign(prevState->wellReservoirRates(oldIndex));
 
                 // Well potentials
-                for (int p=0; p < np; p++) {
-                    this->wellPotentials(newIndex)[p] = prevState->wellPotentials(oldIndex)[p];
-                }
+                this->wellPotentials(newIndex).assign(prevState->wellPotentials(oldIndex));
 
                 // perfPhaseRates
                 const int num_perf_old_well = (*it).second[ 2 ];
@@ -406,12 +412,12 @@ void WellState::init(const std::vector<double>& cellPressures,
                 // number of perforations.
                 if (global_num_perf_same)
                 {
-                    auto& perf_data = this->perfData(w);
-                    const auto& prev_perf_data = prevState->perfData(w);
+                    auto perf_data = this->perfData(w);
+                    const auto prev_perf_data = prevState->perfData(w);
                     perf_data.try_assign( prev_perf_data );
                 } else {
                     const int global_num_perf_this_well = well.getConnections().num_open();
-                    auto& perf_data = this->perfData(w);
+                    auto perf_data = this->perfData(w);
                     auto& target_rates = perf_data.phase_rates;
                     for (int perf_index = 0; perf_index < num_perf_this_well; perf_index++) {
                         for (int p = 0; p < np; ++p) {
@@ -421,7 +427,7 @@ void WellState::init(const std::vector<double>& cellPressures,
                 }
 
                 // Productivity index.
-                this->productivity_index_.copy_welldata( prevState->productivity_index_, wname );
+                this->productivityIndex(newIndex).assign(prevState->productivityIndex(oldIndex));
             }
 
             // If in the new step, there is no THP related
@@ -457,15 +463,50 @@ void WellState::resize(const std::vector<Well>& wells_ecl,
     }
 }
 
-const std::vector<double>&
+ArraySlice<const double>
 WellState::currentWellRates(const std::string& wellName) const
 {
-    auto it = well_rates.find(wellName);
+    auto index = current_rates_owner_.well_index(wellName);
 
-    if (it == well_rates.end())
+    if (!index)
         OPM_THROW(std::logic_error, "Could not find any rates for well  " << wellName);
 
-    return it->second.second;
+    return this->current_rates(*index);
+}
+
+void WellState::setCurrentWellRates(const std::string& wellName, const std::vector<double>& new_rates)
+{
+    auto index = current_rates_owner_.well_index(wellName);
+
+    if (!index)
+        OPM_THROW(std::logic_error, "Could not find any rates for well  " << wellName);
+
+    if (this->current_rates_owner_[*index])
+        this->current_rates(*index).assign(ArraySlice<const double>(new_rates.data(), new_rates.size()));
+}
+
+void WellState::setCurrentWellRates(std::size_t well_index, const std::vector<double>& new_rates)
+{
+    const auto index = this->current_rates_index_.at(well_index);
+    if (this->current_rates_owner_[index])
+        this->current_rates(index).assign(ArraySlice<const double>(new_rates.data(), new_rates.size()));
+}
+
+void WellState::add_current_rates(const std::string& wname)
+{
+    this->current_rates_owner_.add(wname, 0);
+    this->current_rates_.resize(this->current_rates_.size() + this->numPhases(), 0.0);
+}
+
+void WellState::update_current_rates_index()
+{
+    this->current_rates_index_.assign(this->wellMap_.size(), 0);
+    for (const auto& [wname, entry] : this->wellMap_) {
+        if (!this->current_rates_owner_.has(wname))
+            this->add_current_rates(wname);
+
+        this->current_rates_index_[entry[0]] = this->current_rates_owner_.well_index(wname).value();
+    }
 }
 
 template<class Communication>
@@ -509,10 +550,10 @@ WellState::report(const int* globalCellIdxMap,
             continue;
         }
 
-        const auto& reservoir_rates = this->well_reservoir_rates_[well_index];
-        const auto& well_potentials = this->well_potentials_[well_index];
-        const auto& wpi = this->productivity_index_[well_index];
-        const auto& wv = this->wellRates(well_index);
+        const auto reservoir_rates = this->wellReservoirRates(well_index);
+        const auto well_potentials = this->wellPotentials(well_index);
+        const auto wpi = this->productivityIndex(well_index);
+        const auto wv = this->wellRates(well_index);
 
         data::Well well;
         well.bhp = this->bhp(well_index);
@@ -604,7 +645,7 @@ void WellState::reportConnections(std::vector<data::Connection>& connections,
     const auto& pd = this->well_perf_data_[well_index];
     const int num_perf_well = pd.size();
     connections.resize(num_perf_well);
-    const auto& perf_data = this->perfData(well_index);
+    const auto perf_data = this->perfData(well_index);
     const auto& perf_rates = perf_data.rates;
     const auto& perf_pressure = perf_data.pressure;
     for( int i = 0; i < num_perf_well; ++i ) {
@@ -673,6 +714,17 @@ void WellState::initWellStateMSWell(const std::vector<Well>& wells_ecl,
     const auto& pu = this->phaseUsage();
     const int np = pu.num_phases;
 
+    // the segments of all the multisegment wells, one after the other
+    this->segment_state = SegmentState{};
+    this->segment_offset_.assign(1, 0);
+    for (int w = 0; w < nw; ++w) {
+        const auto& well_ecl = wells_ecl[w];
+        if ( well_ecl.isMultiSegment() )
+            this->segment_state.append(SegmentState{np, well_ecl.getSegments()});
+
+        this->segment_offset_.push_back(this->segment_state.size());
+    }
+
     // in the init function, the well rates and perforation rates have been initialized or copied from prevState
     // what we do here, is to set the segment rates and perforation rates
     for (int w = 0; w < nw; ++w) {
@@ -683,7 +735,6 @@ void WellState::initWellStateMSWell(const std::vector<Well>& wells_ecl,
             // assuming the order of the perforations in well_ecl is the same with Wells
             const WellConnections& completion_set = well_ecl.getConnections();
             // number of segment for this single well
-            this->segment_state.update(w, SegmentState{np, segment_set});
             const int well_nseg = segment_set.size();
             int n_activeperf = 0;
 
@@ -712,7 +763,7 @@ void WellState::initWellStateMSWell(const std::vector<Well>& wells_ecl,
             }
 
 
-            auto& perf_data = this->perfData(w);
+            auto perf_data = this->perfData(w);
             // for the seg_rates_, now it becomes a recursive solution procedure.
             {
                 // make sure the information from wells_ecl consistent with wells
@@ -734,8 +785,9 @@ void WellState::initWellStateMSWell(const std::vector<Well>& wells_ecl,
                 const auto& perf_rates = perf_data.phase_rates;
                 std::vector<double> perforation_rates(perf_rates.begin(), perf_rates.end());
 
-                auto& segments = this->segments(w);
-                calculateSegmentRates(segment_inlets, segment_perforations, perforation_rates, np, 0 /* top segment */, segments.rates);
+                std::vector<double> segment_rates;
+                calculateSegmentRates(segment_inlets, segment_perforations, perforation_rates, np, 0 /* top segment */, segment_rates);
+                std::copy(segment_rates.begin(), segment_rates.end(), this->segments(w).rates.begin());
             }
             // for the segment pressure, the segment pressure is the same with the first perforation belongs to the segment
             // if there is no perforation associated with this segment, it uses the pressure from the outlet segment
@@ -744,7 +796,7 @@ void WellState::initWellStateMSWell(const std::vector<Well>& wells_ecl,
             // improved during the solveWellEq process
             {
                 // top segment is always the first one, and its pressure is the well bhp
-                auto& segment_pressure = this->segments(w).pressure;
+                auto segment_pressure = this->segments(w).pressure;
                 segment_pressure[0] = bhp(w);
                 const auto& perf_press = perf_data.pressure;
                 for (int seg = 1; seg < well_nseg; ++seg) {
@@ -772,16 +824,17 @@ void WellState::initWellStateMSWell(const std::vector<Well>& wells_ecl,
             if ( !well.isMultiSegment() )
                 continue;
 
-            const auto& wname = well.name();
-            if (prev_well_state->segment_state.has(wname)) {
-                if (prev_well_state->status_[wname] == Well::Status::SHUT) {
+            const auto it = prev_well_state->wellMap().find(well.name());
+            if (it != prev_well_state->wellMap().end()) {
+                const auto prev_index = it->second[0];
+                if (prev_well_state->status_[prev_index] == Well::Status::SHUT) {
                     continue;
                 }
 
                 // TODO: the well with same name can change a lot, like they might not have same number of segments
                 // we need to handle that later.
-                // for now, we just copy them.
-                this->segment_state.copy_welldata(prev_well_state->segment_state, wname);
+                // for now, we copy them when the number of segments is unchanged.
+                this->segments(w).try_assign(prev_well_state->segments(prev_index));
             }
         }
     }
@@ -849,17 +902,17 @@ void WellState::shutWell(int well_index)
     this->thp_[well_index] = 0;
     this->bhp_[well_index] = 0;
     const int np = numPhases();
-    this->wellrates_[well_index].assign(np, 0);
+    this->wellRates(well_index).assign(np, 0);
 
-    auto& resv = this->well_reservoir_rates_[well_index];
-    auto& wpi  = this->productivity_index_[well_index];
+    auto resv = this->wellReservoirRates(well_index);
+    auto wpi  = this->productivityIndex(well_index);
 
     for (int p = 0; p < np; ++p) {
         resv[p] = 0.0;
         wpi[p]  = 0.0;
     }
 
-    auto& perf_data = this->perfData(well_index);
+    auto perf_data = this->perfData(well_index);
     auto& connpi = perf_data.prod_index;
     connpi.assign(connpi.size(), 0);
 }
@@ -887,24 +940,16 @@ template<class Comm>
 void WellState::communicateGroupRates(const Comm& comm)
 {
     // Compute the size of the data.
-    std::size_t sz = 0;
-    for (const auto& [_, owner_rates] : this->well_rates) {
-        (void)_;
-        const auto& [__, rates] = owner_rates;
-        (void)__;
-        sz += rates.size();
-    }
+    std::size_t sz = this->current_rates_.size();
     sz += this->alq_state.pack_size();
 
 
     // Make a vector and collect all data into it.
     std::vector<double> data(sz);
     std::size_t pos = 0;
-    for (const auto& [_, owner_rates] : this->well_rates) {
-        (void)_;
-        const auto& [owner, rates] = owner_rates;
-        for (const auto& value : rates) {
-            if (owner)
+    for (std::size_t w = 0; w < this->current_rates_owner_.size(); ++w) {
+        for (const auto& value : this->current_rates(w)) {
+            if (this->current_rates_owner_[w])
                 data[pos++] = value;
             else
                 data[pos++] = 0;
@@ -916,14 +961,8 @@ void WellState::communicateGroupRates(const Comm& comm)
     // Communicate it with a single sum() call.
     comm.sum(data.data(), data.size());
 
-    pos = 0;
-    for (auto& [_, owner_rates] : this->well_rates) {
-        (void)_;
-        auto& [__, rates] = owner_rates;
-        (void)__;
-        for (auto& value : rates)
-            value = data[pos++];
-    }
+    std::copy(data.begin(), data.begin() + this->current_rates_.size(), this->current_rates_.begin());
+    pos = this->current_rates_.size();
     pos += this->alq_state.unpack_data(&data[pos]);
     assert(pos == sz);
 }
@@ -942,7 +981,7 @@ WellState::reportSegmentResults(const PhaseUsage& pu,
                                                      const int         seg_ix,
                                                      const int         seg_no) const
 {
-    const auto& segments = this->segments(well_id);
+    const auto segments = this->segments(well_id);
     if (segments.empty())
         return {};
 
@@ -997,6 +1036,64 @@ bool WellState::wellIsOwned(const std::string& wellName) const
     return wellIsOwned(well_index, wellName);
 }
 
+WellState::SingleWellSnapshot
+WellState::snapshotWell(std::size_t well_index) const
+{
+    SingleWellSnapshot snapshot {
+        well_index,
+        this->status_[well_index],
+        this->bhp_[well_index],
+        this->thp_[well_index],
+        this->temperature_[well_index],
+        this->is_producer_[well_index],
+        this->current_injection_controls_[well_index],
+        this->current_production_controls_[well_index],
+        this->well_dissolved_gas_rates_[well_index],
+        this->well_vaporized_oil_rates_[well_index],
+        this->events_[well_index],
+        this->currentWellRates(well_index).to_vector(),
+        {}
+    };
+
+    auto& values = snapshot.values;
+    visitWellArrays(*this, well_index, [&values](const auto& slice)
+    {
+        values.insert(values.end(), slice.begin(), slice.end());
+    });
+    return snapshot;
+}
+
+void WellState::restoreWell(const SingleWellSnapshot& snapshot)
+{
+    const auto well_index = snapshot.well_index;
+    this->status_[well_index] = snapshot.status;
+    this->bhp_[well_index] = snapshot.bhp;
+    this->thp_[well_index] = snapshot.thp;
+    this->temperature_[well_index] = snapshot.temperature;
+    this->is_producer_[well_index] = snapshot.is_producer;
+    this->current_injection_controls_[well_index] = snapshot.injection_control;
+    this->current_production_controls_[well_index] = snapshot.production_control;
+    this->well_dissolved_gas_rates_[well_index] = snapshot.dissolved_gas_rate;
+    this->well_vaporized_oil_rates_[well_index] = snapshot.vaporized_oil_rate;
+    this->events_[well_index] = snapshot.events;
+
+    const auto& current_rates = snapshot.current_rates;
+    this->current_rates(this->current_rates_index_.at(well_index))
+        .assign(ArraySlice<const double>(current_rates.data(), current_rates.size()));
+
+    auto src = snapshot.values.begin();
+    visitWellArrays(*this, well_index, [&src, &snapshot](const auto& slice)
+    {
+        if (static_cast<std::size_t>(snapshot.values.end() - src) < slice.size())
+            throw std::logic_error("The well state has changed since the snapshot was taken");
+
+        std::copy(src, src + slice.size(), slice.begin());
+        src += slice.size();
+    });
+    if (src != snapshot.values.end())
+        throw std::logic_error("The well state has changed since the snapshot was taken");
+}
+
 int WellState::wellIndex(const std::string& wellName) const
 {
     const auto& it = this->wellMap_.find( wellName );
@@ -1008,14 +1105,12 @@ int WellState::wellIndex(const std::string& wellName) const
 
 int WellState::numSegments(const int well_id) const
 {
-    const auto& segments = this->segments(well_id);
-    return segments.size();
+    return this->segment_offset_.at(well_id + 1) - this->segment_offset_[well_id];
 }
 
 int WellState::segmentNumber(const int well_id, const int seg_id) const
 {
-    const auto& segments = this->segment_state[well_id];
-    return segments.segment_number()[seg_id];
+    return this->segments(well_id).segment_number()[seg_id];
 }
 
 void WellState::updateWellsDefaultALQ( const std::vector<Well>& wells_ecl )
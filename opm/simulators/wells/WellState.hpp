@@ -22,6 +22,7 @@
 #define OPM_WELLSTATEFULLYIMPLICITBLACKOIL_HEADER_INCLUDED
 
 #include <opm/simulators/wells/ALQState.hpp>
+#include <opm/simulators/wells/ArraySlice.hpp>
 #include <opm/simulators/wells/GlobalWellInfo.hpp>
 #include <opm/simulators/wells/SegmentState.hpp>
 #include <opm/simulators/wells/WellContainer.hpp>
@@ -33,9 +34,12 @@
 #include <opm/parser/eclipse/EclipseState/Schedule/Events.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Well/Well.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <functional>
 #include <map>
 #include <optional>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -48,6 +52,14 @@ class Schedule;
 
 /// The state of a set of wells, tailored for use by the fully
 /// implicit blackoil simulator.
+///
+/// Each quantity is stored in one contiguous array for all the local
+/// wells.  Per phase quantities hold numPhases() values per well, and the
+/// perforation and segment quantities of a well are found at the offsets
+/// of the well into the perforation and segment arrays of all wells.  The
+/// accessors for a single well take the local well index as handle and
+/// return slices of these arrays, so copying a well state copies a fixed
+/// number of flat arrays.
 class WellState
 {
 public:
@@ -64,8 +76,9 @@ public:
     static const int Gas = BlackoilPhases::Vapour;
 
     explicit WellState(const PhaseUsage& pu)
+        : phase_usage_(pu)
+        , perfdata(0, true, pu)
     {
-        this->phase_usage_ = pu;
     }
 
     const WellMapType& wellMap() const { return wellMap_; }
@@ -110,16 +123,21 @@ public:
     Well::ProducerCMode currentProductionControl(std::size_t well_index) const { return current_production_controls_[well_index]; }
     void currentProductionControl(std::size_t well_index, Well::ProducerCMode cmode) { current_production_controls_[well_index] = cmode; }
 
-    void setCurrentWellRates(const std::string& wellName, const std::vector<double>& new_rates ) {
-        auto& [owner, rates] = this->well_rates.at(wellName);
-        if (owner)
-            rates = new_rates;
-    }
+    void setCurrentWellRates(const std::string& wellName, const std::vector<double>& new_rates );
+
+    /// Set the current rates of local well well_index.
+    void setCurrentWellRates(std::size_t well_index, const std::vector<double>& new_rates );
+
+    ArraySlice<const double> currentWellRates(const std::string& wellName) const;
 
-    const std::vector<double>& currentWellRates(const std::string& wellName) const;
+    /// The current rates of local well well_index, without the lookup
+    /// by name.
+    ArraySlice<const double> currentWellRates(std::size_t well_index) const {
+        return this->current_rates(this->current_rates_index_.at(well_index));
+    }
 
     bool hasWellRates(const std::string& wellName) const {
-        return this->well_rates.find(wellName) != this->well_rates.end();
+        return this->current_rates_owner_.has(wellName);
     }
 
     template<class Communication>
@@ -155,16 +173,17 @@ public:
     /// One rate pr well
     double brineWellRate(const int w) const;
 
-    const WellContainer<std::vector<double>>& wellReservoirRates() const { return well_reservoir_rates_; }
+    /// Reservoir rates of all wells, numPhases() values per well.
+    const std::vector<double>& wellReservoirRates() const { return well_reservoir_rates_; }
 
-    std::vector<double>& wellReservoirRates(std::size_t well_index)
+    ArraySlice<double> wellReservoirRates(std::size_t well_index)
     {
-        return well_reservoir_rates_[well_index];
+        return this->phase_slice(this->well_reservoir_rates_, well_index);
     }
 
-    const std::vector<double>& wellReservoirRates(std::size_t well_index) const
+    ArraySlice<const double> wellReservoirRates(std::size_t well_index) const
     {
-        return well_reservoir_rates_[well_index];
+        return this->phase_slice(this->well_reservoir_rates_, well_index);
     }
 
     double& wellDissolvedGasRates(std::size_t well_index)
@@ -180,36 +199,156 @@ public:
 
 
 
-    const SegmentState& segments(const std::size_t well_index) const {
-        return this->segment_state[well_index];
+    SegmentStateSlice<const double> segments(const std::size_t well_index) const {
+        return this->segment_state.slice(this->segment_offset_.at(well_index),
+                                         this->numSegments(well_index),
+                                         this->numPhases());
     }
 
-    SegmentState& segments(const std::size_t well_index) {
-        return this->segment_state[well_index];
+    SegmentStateSlice<double> segments(const std::size_t well_index) {
+        return this->segment_state.slice(this->segment_offset_.at(well_index),
+                                         this->numSegments(well_index),
+                                         this->numPhases());
     }
 
-    const SegmentState& segments(const std::string& wname) const {
-        return this->segment_state[wname];
+    SegmentStateSlice<const double> segments(const std::string& wname) const {
+        return this->segments(this->wellIndex(wname));
     }
 
-    SegmentState& segments(const std::string& wname) {
-        return this->segment_state[wname];
+    SegmentStateSlice<double> segments(const std::string& wname) {
+        return this->segments(this->wellIndex(wname));
     }
 
-    std::vector<double>& productivityIndex(std::size_t well_index) {
-        return this->productivity_index_[well_index];
+    ArraySlice<double> productivityIndex(std::size_t well_index) {
+        return this->phase_slice(this->productivity_index_, well_index);
     }
 
-    const std::vector<double>& productivityIndex(std::size_t well_index) const {
-        return this->productivity_index_[well_index];
+    ArraySlice<const double> productivityIndex(std::size_t well_index) const {
+        return this->phase_slice(this->productivity_index_, well_index);
     }
 
-    std::vector<double>& wellPotentials(std::size_t well_index) {
-        return this->well_potentials_[well_index];
+    ArraySlice<double> wellPotentials(std::size_t well_index) {
+        return this->phase_slice(this->well_potentials_, well_index);
     }
 
-    const std::vector<double>& wellPotentials(std::size_t well_index) const {
-        return this->well_potentials_[well_index];
+    ArraySlice<const double> wellPotentials(std::size_t well_index) const {
+        return this->phase_slice(this->well_potentials_, well_index);
+    }
+
+    /// Copy of the dynamic state of a single well.  Local well solves
+    /// only modify the entries of the well being solved, so a failed
+    /// solve can be rolled back from this instead of from a copy of the
+    /// complete WellState.
+    struct SingleWellSnapshot
+    {
+        std::size_t well_index;
+        Well::Status status;
+        double bhp;
+        double thp;
+        double temperature;
+        int is_producer;
+        Well::InjectorCMode injection_control;
+        Well::ProducerCMode production_control;
+        double dissolved_gas_rate;
+        double vaporized_oil_rate;
+        Events events;
+        std::vector<double> current_rates;
+        // The per phase, perforation and segment values of the well in
+        // the order of visitWellArrays().
+        std::vector<double> values;
+    };
+
+    SingleWellSnapshot snapshotWell(std::size_t well_index) const;
+
+    /// Restore the entries of a single well from a snapshot taken from
+    /// this WellState.  The set of wells must not have changed since the
+    /// snapshot was taken.
+    void restoreWell(const SingleWellSnapshot& snapshot);
+
+    /// (De-)serialize the dynamic state of the wells.  The static parts,
+    /// i.e. the set of wells and their perforation data, are set up from
+    /// the schedule and must match the state which was serialized.
+    template<class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        auto checkSize = [&serializer](std::size_t size, const std::string& what)
+        {
+            std::size_t serializedSize = size;
+            serializer(serializedSize);
+            if (serializedSize != size)
+                throw std::runtime_error("Serialized well state has " + std::to_string(serializedSize)
+                                         + " " + what + ", expected " + std::to_string(size));
+        };
+
+        checkSize(this->wellMap_.size(), "wells");
+        for (const auto& [wname, entry] : this->wellMap_) {
+            std::string serializedName = wname;
+            serializer(serializedName);
+            if (serializedName != wname)
+                throw std::runtime_error("Serialized well state has well " + serializedName
+                                         + " where " + wname + " was expected");
+
+            const auto w = entry[0];
+            serializer(this->status_[w]);
+            serializer(this->bhp_[w]);
+            serializer(this->thp_[w]);
+            serializer(this->temperature_[w]);
+            serializer(this->is_producer_[w]);
+            serializer(this->current_injection_controls_[w]);
+            serializer(this->current_production_controls_[w]);
+            serializer(this->well_dissolved_gas_rates_[w]);
+            serializer(this->well_vaporized_oil_rates_[w]);
+            this->events_[w].serializeOp(serializer);
+        }
+
+        // The arrays of all wells, in the well order checked above. The
+        // segments of a restarted state are only set up if a multisegment
+        // well is open, so the segment layout is restored as well.
+        serializer(this->wellrates_);
+        serializer(this->well_reservoir_rates_);
+        serializer(this->productivity_index_);
+        serializer(this->well_potentials_);
+        this->perfdata.serializeOp(serializer);
+        serializer(this->perf_offset_);
+        this->segment_state.serializeOp(serializer);
+        serializer(this->segment_offset_);
+
+        // The current rates hold all wells which have been seen so far, not
+        // only the local ones, and a restarted state does not necessarily know
+        // all of them yet. They are therefore matched by name.
+        const int np = this->numPhases();
+        std::size_t numRates = this->current_rates_owner_.size();
+        serializer(numRates);
+        const auto rateWells = this->current_rates_owner_.wells();
+        for (std::size_t i = 0; i < numRates; ++i) {
+            std::string wname = serializer.isSerializing() ? rateWells[i] : std::string{};
+            int owner = 0;
+            std::vector<double> rates;
+            if (serializer.isSerializing()) {
+                owner = this->current_rates_owner_[i];
+                rates = this->current_rates(i).to_vector();
+            }
+            serializer(wname);
+            serializer(owner);
+            serializer(rates);
+            if (serializer.isSerializing())
+                continue;
+
+            if (rates.size() != static_cast<std::size_t>(np))
+                throw std::runtime_error("Serialized well state has " + std::to_string(rates.size())
+                                         + " current rates for well " + wname + ", expected " + std::to_string(np));
+
+            if (!this->current_rates_owner_.has(wname))
+                this->add_current_rates(wname);
+
+            const auto index = this->current_rates_owner_.well_index(wname).value();
+            this->current_rates_owner_[index] = owner;
+            std::copy(rates.begin(), rates.end(), this->current_rates(index).begin());
+        }
+        this->update_current_rates_index();
+
+        this->alq_state.serializeOp(serializer);
+        serializer(this->do_glift_optimization_);
     }
 
     template<class Comm>
@@ -316,27 +455,29 @@ public:
     void update_temperature(std::size_t well_index, double value) { temperature_[well_index] = value; }
     double temperature(std::size_t well_index) const { return temperature_[well_index]; }
 
-    /// One rate per well and phase.
-    const WellContainer<std::vector<double>>& wellRates() const { return wellrates_; }
-    std::vector<double>& wellRates(std::size_t well_index) { return wellrates_[well_index]; }
-    const std::vector<double>& wellRates(std::size_t well_index) const { return wellrates_[well_index]; }
+    /// One rate per well and phase, numPhases() values per well.
+    const std::vector<double>& wellRates() const { return wellrates_; }
+    ArraySlice<double> wellRates(std::size_t well_index) { return this->phase_slice(this->wellrates_, well_index); }
+    ArraySlice<const double> wellRates(std::size_t well_index) const { return this->phase_slice(this->wellrates_, well_index); }
 
-    std::size_t numPerf(std::size_t well_index) const { return this->perfdata[well_index].size(); }
+    std::size_t numPerf(std::size_t well_index) const {
+        return this->perf_offset_.at(well_index + 1) - this->perf_offset_[well_index];
+    }
 
-    PerfData& perfData(const std::string& wname) {
-        return this->perfdata[wname];
+    PerfDataSlice<double> perfData(const std::string& wname) {
+        return this->perfData(this->wellIndex(wname));
     }
 
-    const PerfData& perfData(const std::string& wname) const {
-        return this->perfdata[wname];
+    PerfDataSlice<const double> perfData(const std::string& wname) const {
+        return this->perfData(this->wellIndex(wname));
     }
 
-    PerfData& perfData(std::size_t well_index) {
-        return this->perfdata[well_index];
+    PerfDataSlice<double> perfData(std::size_t well_index) {
+        return this->perfdata.slice(this->perf_offset_.at(well_index), this->numPerf(well_index));
     }
 
-    const PerfData& perfData(std::size_t well_index) const {
-        return this->perfdata[well_index];
+    PerfDataSlice<const double> perfData(std::size_t well_index) const {
+        return this->perfdata.slice(this->perf_offset_.at(well_index), this->numPerf(well_index));
     }
 
 private:
@@ -354,9 +495,13 @@ private:
     WellContainer<double> bhp_;
     WellContainer<double> thp_;
     WellContainer<double> temperature_;
-    WellContainer<std::vector<double>> wellrates_;
+    std::vector<double> wellrates_;
     PhaseUsage phase_usage_;
-    WellContainer<PerfData> perfdata;
+
+    // The perforation quantities of all wells. The perforations of well w
+    // are [perf_offset_[w], perf_offset_[w + 1]).
+    PerfData perfdata;
+    std::vector<std::size_t> perf_offset_;
 
     WellContainer<int> is_producer_; // Size equal to number of local wells.
 
@@ -366,14 +511,17 @@ private:
     WellContainer<Opm::Well::InjectorCMode> current_injection_controls_;
     WellContainer<Well::ProducerCMode> current_production_controls_;
 
-    // The well_rates variable is defined for all wells on all processors. The
-    // bool in the value pair is whether the current process owns the well or
-    // not.
-    std::map<std::string, std::pair<bool, std::vector<double>>> well_rates;
+    // The current rates are defined for all wells on all processors, with
+    // numPhases() rates per well in current_rates_. The owner flag is whether
+    // the current process owns the well or not.
+    WellContainer<int> current_rates_owner_;
+    std::vector<double> current_rates_;
+    // The position of each local well in current_rates_owner_.
+    std::vector<std::size_t> current_rates_index_;
 
     // phase rates under reservoir condition for wells
     // or voidage phase rates
-    WellContainer<std::vector<double>> well_reservoir_rates_;
+    std::vector<double> well_reservoir_rates_;
 
     // dissolved gas rates or solution gas production rates
     // should be zero for injection wells
@@ -388,13 +536,51 @@ private:
     // \Note: for now, only WCON* keywords, and well status change is considered
     WellContainer<Events> events_;
 
-    WellContainer<SegmentState> segment_state;
+    // The segment quantities of all wells. The segments of well w are
+    // [segment_offset_[w], segment_offset_[w + 1]), and standard wells
+    // have no segments.
+    SegmentState segment_state;
+    std::vector<std::size_t> segment_offset_;
 
     // Productivity Index
-    WellContainer<std::vector<double>> productivity_index_;
+    std::vector<double> productivity_index_;
 
     // Well potentials
-    WellContainer<std::vector<double>> well_potentials_;
+    std::vector<double> well_potentials_;
+
+    ArraySlice<double> phase_slice(std::vector<double>& values, std::size_t well_index) const {
+        const auto np = static_cast<std::size_t>(this->numPhases());
+        return {values, well_index * np, np};
+    }
+
+    ArraySlice<const double> phase_slice(const std::vector<double>& values, std::size_t well_index) const {
+        const auto np = static_cast<std::size_t>(this->numPhases());
+        return {values, well_index * np, np};
+    }
+
+    ArraySlice<double> current_rates(std::size_t rates_index) {
+        return this->phase_slice(this->current_rates_, rates_index);
+    }
+
+    ArraySlice<const double> current_rates(std::size_t rates_index) const {
+        return this->phase_slice(this->current_rates_, rates_index);
+    }
+
+    void add_current_rates(const std::string& wname);
+    void update_current_rates_index();
+
+    /// Call visitor with every per phase, perforation and segment slice
+    /// of well well_index, for both const and non const states.
+    template<class State, class Visitor>
+    static void visitWellArrays(State& state, std::size_t well_index, Visitor&& visitor)
+    {
+        visitor(state.wellRates(well_index));
+        visitor(state.wellReservoirRates(well_index));
+        visitor(state.productivityIndex(well_index));
+        visitor(state.wellPotentials(well_index));
+        state.perfData(well_index).visit(visitor);
+        state.segments(well_index).visit(visitor);
+    }
 
 
     data::Segment
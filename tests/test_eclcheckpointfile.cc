@@ -0,0 +1,135 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+#include "config.h"
+
+#define BOOST_TEST_MODULE EclCheckpointFile
+
+#include <boost/test/unit_test.hpp>
+
+#include <ebos/eclcheckpointfile.hh>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(FileName)
+{
+    BOOST_CHECK_EQUAL(Opm::eclCheckpointFileName("out/CASE.UNRST", 12, 3),
+                      "out/CASE_0012.3.OPMCKPT");
+    BOOST_CHECK_EQUAL(Opm::eclCheckpointFileName("out.d/CASE.X0012", 12, 0),
+                      "out.d/CASE_0012.0.OPMCKPT");
+    BOOST_CHECK_EQUAL(Opm::eclCheckpointMarkerFileName("out/CASE.UNRST", 12),
+                      "out/CASE_0012.OPMCKPT");
+}
+
+BOOST_AUTO_TEST_CASE(RoundTrip)
+{
+    const std::string fileName = "test_eclcheckpointfile.OPMCKPT";
+    const std::vector<double> pressure{1.0/3.0, std::numeric_limits<double>::denorm_min(), -0.0, 2.5e7};
+    const std::vector<int> meanings{0, 1, 2};
+    const std::vector<char> odd{'a', 'b', 'c'};
+    const std::vector<double> empty;
+
+    {
+        Opm::EclCheckpointWriter writer(fileName);
+        writer.write("PRIMVARS", pressure);
+        writer.write("ODD", odd);
+        writer.write("EMPTY", empty);
+        writer.write("PVMEANING", meanings);
+        writer.close();
+    }
+
+    Opm::EclCheckpointReader reader(fileName);
+    BOOST_CHECK(reader.has("PRIMVARS"));
+    BOOST_CHECK(!reader.has("SOMAX"));
+    BOOST_CHECK_EQUAL(reader.size("EMPTY"), 0U);
+
+    const auto readPressure = reader.read<double>("PRIMVARS");
+    BOOST_REQUIRE_EQUAL(readPressure.size(), pressure.size());
+    for (std::size_t i = 0; i < pressure.size(); ++i)
+        BOOST_CHECK(std::memcmp(&readPressure[i], &pressure[i], sizeof(double)) == 0);
+
+    const auto readOdd = reader.read<char>("ODD");
+    BOOST_CHECK_EQUAL_COLLECTIONS(readOdd.begin(), readOdd.end(), odd.begin(), odd.end());
+
+    const auto readMeanings = reader.read<int>("PVMEANING");
+    BOOST_CHECK_EQUAL_COLLECTIONS(readMeanings.begin(), readMeanings.end(),
+                                  meanings.begin(), meanings.end());
+
+    // wrong element type and wrong number of elements
+    BOOST_CHECK_THROW(reader.read<float>("PRIMVARS"), std::runtime_error);
+    std::vector<double> tooShort(2);
+    BOOST_CHECK_THROW(reader.read("PRIMVARS", tooShort.data(), tooShort.size()), std::runtime_error);
+    BOOST_CHECK_THROW(reader.read<double>("SOMAX"), std::runtime_error);
+
+    std::remove(fileName.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(Truncated)
+{
+    const std::string fileName = "test_eclcheckpointfile_truncated.OPMCKPT";
+    {
+        Opm::EclCheckpointWriter writer(fileName);
+        writer.write("DATA", std::vector<double>(16, 1.0));
+        writer.close();
+    }
+    {
+        std::ifstream is(fileName, std::ios::binary);
+        std::vector<char> contents((std::istreambuf_iterator<char>(is)),
+                                   std::istreambuf_iterator<char>());
+        is.close();
+        std::ofstream os(fileName, std::ios::binary | std::ios::trunc);
+        os.write(contents.data(), contents.size() - 8);
+    }
+
+    BOOST_CHECK_THROW(Opm::EclCheckpointReader reader(fileName), std::runtime_error);
+
+    std::remove(fileName.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(UnfinishedWrite)
+{
+    const std::string fileName = "test_eclcheckpointfile_unfinished.OPMCKPT";
+    {
+        Opm::EclCheckpointWriter writer(fileName);
+        writer.write("DATA", std::vector<double>(4, 1.0));
+        writer.close();
+    }
+    {
+        // the existing checkpoint is only replaced once the new one is complete
+        Opm::EclCheckpointWriter writer(fileName);
+        writer.write("DATA", std::vector<double>(8, 2.0));
+        BOOST_CHECK_EQUAL(Opm::EclCheckpointReader(fileName).size("DATA"), 4U);
+        writer.close();
+    }
+
+    const auto data = Opm::EclCheckpointReader(fileName).read<double>("DATA");
+    BOOST_REQUIRE_EQUAL(data.size(), 8U);
+    BOOST_CHECK_EQUAL(data[0], 2.0);
+
+    std::remove(fileName.c_str());
+}
@@ -0,0 +1,197 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+#include "config.h"
+
+#define BOOST_TEST_MODULE EclDistributedCellData
+
+#include <boost/test/unit_test.hpp>
+
+#include <ebos/ecldistributedcelldata.hh>
+
+#include <opm/io/eclipse/EclOutput.hpp>
+#include <opm/output/data/Solution.hpp>
+#include <opm/parser/eclipse/Units/UnitSystem.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+const std::vector<int> reportSteps{1, 5};
+const std::size_t numCells = 2500;
+const int numRanks = 3;
+
+double pressure(int step, std::size_t cellIdx)
+{ return 100.0*step + cellIdx/7.0; }
+
+double swat(int step, std::size_t cellIdx)
+{ return 0.1*step + cellIdx/10000.0; }
+
+double rssat(int step, std::size_t cellIdx)
+{ return step + cellIdx/3.0; }
+
+template <class T>
+std::vector<T> globalArray(double (*value)(int, std::size_t), int step)
+{
+    std::vector<T> values(numCells);
+    for (std::size_t cellIdx = 0; cellIdx < numCells; ++cellIdx)
+        values[cellIdx] = static_cast<T>(value(step, cellIdx));
+    return values;
+}
+
+// Write a unified restart file laid out like the one of the restart writer,
+// with or without the cell arrays. The arrays span several record blocks.
+void writeRestartFile(const std::string& fileName, bool withCellArrays)
+{
+    Opm::EclIO::EclOutput output(fileName, /*formatted=*/false);
+    for (int step : reportSteps) {
+        output.write("SEQNUM", std::vector<int>{step});
+        output.write("INTEHEAD", std::vector<int>(411, step));
+        output.message("STARTSOL");
+        if (withCellArrays) {
+            output.write("PRESSURE", globalArray<float>(pressure, step));
+            output.write("SWAT", globalArray<float>(swat, step));
+        }
+        output.write("THRESHPR", std::vector<double>(4, 1.5*step));
+        output.message("ENDSOL");
+        if (withCellArrays)
+            output.write("RSSAT", globalArray<float>(rssat, step));
+        output.write("OPMEXTRA", std::vector<double>{0.25*step});
+    }
+}
+
+// The cells of a rank in a scrambled order
+std::vector<int> cellsOfRank(int rank)
+{
+    std::vector<int> cells;
+    for (int cellIdx = numCells - 1; cellIdx >= 0; --cellIdx)
+        if (cellIdx % numRanks == rank)
+            cells.push_back(cellIdx);
+    return cells;
+}
+
+void writeCellData(const std::string& fileName, int rank)
+{
+    using Opm::UnitSystem;
+    using Opm::data::TargetType;
+
+    const auto cells = cellsOfRank(rank);
+    Opm::EclDistributedCellWriter writer(fileName, cells);
+    for (int step : reportSteps) {
+        std::vector<double> p, s, r;
+        for (int cellIdx : cells) {
+            p.push_back(pressure(step, cellIdx));
+            s.push_back(swat(step, cellIdx));
+            r.push_back(rssat(step, cellIdx));
+        }
+
+        Opm::data::Solution solution;
+        solution.insert("PRESSURE", UnitSystem::measure::pressure, p, TargetType::RESTART_SOLUTION);
+        solution.insert("SWAT", UnitSystem::measure::identity, s, TargetType::RESTART_SOLUTION);
+        solution.insert("RSSAT", UnitSystem::measure::gas_oil_ratio, r, TargetType::RESTART_AUXILIARY);
+        solution.insert("FIPOIL", UnitSystem::measure::liquid_surface_volume, r, TargetType::SUMMARY);
+        writer.writeStep(step, solution, /*doublePrecision=*/false, /*writeAuxiliary=*/true);
+    }
+}
+
+std::string fileContents(const std::string& fileName)
+{
+    std::ifstream is(fileName, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(MergeIsByteIdentical)
+{
+    const std::string referenceFileName = "TEST_DISTRIBUTED_REFERENCE.UNRST";
+    const std::string skeletonFileName = "TEST_DISTRIBUTED.UNRST";
+    const std::string mergedFileName = "TEST_DISTRIBUTED_MERGED.UNRST";
+
+    writeRestartFile(referenceFileName, /*withCellArrays=*/true);
+    writeRestartFile(skeletonFileName, /*withCellArrays=*/false);
+
+    std::vector<std::string> cellDataFileNames;
+    for (int rank = 0; rank < numRanks; ++rank) {
+        cellDataFileNames.push_back(Opm::eclDistributedCellDataFileName(".", "TEST_DISTRIBUTED", rank));
+        writeCellData(cellDataFileNames.back(), rank);
+    }
+
+    Opm::mergeEclDistributedCellData(skeletonFileName, cellDataFileNames, mergedFileName);
+    const auto reference = fileContents(referenceFileName);
+    BOOST_CHECK(!reference.empty());
+    BOOST_CHECK(fileContents(mergedFileName) == reference);
+
+    // a missing rank leaves cells without values
+    const std::vector<std::string> incomplete(cellDataFileNames.begin(), cellDataFileNames.end() - 1);
+    BOOST_CHECK_THROW(Opm::mergeEclDistributedCellData(skeletonFileName, incomplete, mergedFileName),
+                      std::runtime_error);
+
+    // the same rank twice covers some cells twice
+    const std::vector<std::string> duplicate{cellDataFileNames[0], cellDataFileNames[0], cellDataFileNames[1]};
+    BOOST_CHECK_THROW(Opm::mergeEclDistributedCellData(skeletonFileName, duplicate, mergedFileName),
+                      std::runtime_error);
+
+    for (const auto& fileName : cellDataFileNames)
+        std::remove(fileName.c_str());
+    for (const auto& fileName : {referenceFileName, skeletonFileName, mergedFileName})
+        std::remove(fileName.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(MissingReportStep)
+{
+    const std::string skeletonFileName = "TEST_DISTRIBUTED_STEP.UNRST";
+    const std::string cellDataFileName = "TEST_DISTRIBUTED_STEP.0.OPMCELL";
+    const std::string mergedFileName = "TEST_DISTRIBUTED_STEP_MERGED.UNRST";
+
+    writeRestartFile(skeletonFileName, /*withCellArrays=*/false);
+    {
+        std::vector<int> cells(numCells);
+        for (std::size_t cellIdx = 0; cellIdx < numCells; ++cellIdx)
+            cells[cellIdx] = cellIdx;
+
+        Opm::data::Solution solution;
+        solution.insert("PRESSURE", Opm::UnitSystem::measure::pressure,
+                        std::vector<double>(numCells, 1.0), Opm::data::TargetType::RESTART_SOLUTION);
+
+        Opm::EclDistributedCellWriter writer(cellDataFileName, cells);
+        writer.writeStep(reportSteps.front(), solution, /*doublePrecision=*/true, /*writeAuxiliary=*/true);
+
+        Opm::data::Solution wrongSize;
+        wrongSize.insert("PRESSURE", Opm::UnitSystem::measure::pressure,
+                         std::vector<double>(1, 1.0), Opm::data::TargetType::RESTART_SOLUTION);
+        BOOST_CHECK_THROW(writer.writeStep(reportSteps.back(), wrongSize,
+                                           /*doublePrecision=*/true, /*writeAuxiliary=*/true),
+                          std::logic_error);
+    }
+
+    BOOST_CHECK_THROW(Opm::mergeEclDistributedCellData(skeletonFileName, {cellDataFileName}, mergedFileName),
+                      std::runtime_error);
+
+    for (const auto& fileName : {skeletonFileName, cellDataFileName, mergedFileName})
+        std::remove(fileName.c_str());
+}
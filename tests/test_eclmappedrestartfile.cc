@@ -0,0 +1,91 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+#include "config.h"
+
+#define BOOST_TEST_MODULE EclMappedRestartFile
+
+#include <boost/test/unit_test.hpp>
+
+#include <ebos/eclmappedrestartfile.hh>
+
+#include <opm/io/eclipse/EclOutput.hpp>
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Write a unified restart file with three report steps. The arrays span
+// several record blocks to exercise the block arithmetic.
+void writeRestartFile(const std::string& fileName, std::size_t numCells)
+{
+    Opm::EclIO::EclOutput output(fileName, /*formatted=*/false);
+    for (int step : {1, 5, 9}) {
+        output.write("SEQNUM", std::vector<int>{step});
+        output.write("INTEHEAD", std::vector<int>(411, step));
+
+        std::vector<float> pressure(numCells);
+        std::vector<double> swat(numCells);
+        for (std::size_t cellIdx = 0; cellIdx < numCells; ++cellIdx) {
+            pressure[cellIdx] = 100.0f*step + cellIdx;
+            swat[cellIdx] = step + cellIdx/3.0;
+        }
+        output.write("PRESSURE", pressure);
+        output.write("SWAT", swat);
+    }
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(ReadSelectedCells)
+{
+    const std::string fileName = "TEST_MAPPED_RESTART.UNRST";
+    const std::size_t numCells = 2500;
+    writeRestartFile(fileName, numCells);
+
+    {
+        const Opm::EclMappedRestartFile restartFile(fileName, 5, /*unified=*/true);
+        BOOST_CHECK(restartFile.has("PRESSURE"));
+        BOOST_CHECK(restartFile.has("SWAT"));
+        BOOST_CHECK(!restartFile.has("INTEHEAD"));
+        BOOST_CHECK(!restartFile.has("SGAS"));
+        BOOST_CHECK_EQUAL(restartFile.size("SWAT"), numCells);
+
+        const std::vector<int> cells{2499, 0, 999, 1000, 1001};
+        const auto pressure = restartFile.read("PRESSURE", cells);
+        const auto swat = restartFile.read("SWAT", cells);
+        for (std::size_t i = 0; i < cells.size(); ++i) {
+            BOOST_CHECK_EQUAL(pressure[i], static_cast<double>(500.0f + cells[i]));
+            BOOST_CHECK_EQUAL(swat[i], 5 + cells[i]/3.0);
+        }
+
+        BOOST_CHECK_THROW(restartFile.read("PRESSURE", {static_cast<int>(numCells)}), std::runtime_error);
+        BOOST_CHECK_THROW(restartFile.read("SGAS", {0}), std::runtime_error);
+    }
+
+    BOOST_CHECK_THROW(Opm::EclMappedRestartFile(fileName, 4, /*unified=*/true), std::runtime_error);
+
+    std::remove(fileName.c_str());
+}
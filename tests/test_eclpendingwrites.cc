@@ -0,0 +1,149 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+#include "config.h"
+
+#define BOOST_TEST_MODULE EclPendingWrites
+
+#include <boost/test/unit_test.hpp>
+
+#include <ebos/eclpendingwrites.hh>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+
+namespace {
+
+// Acquire a slot from another thread, like the simulator does while the
+// output thread is busy writing.
+class Acquirer
+{
+public:
+    Acquirer(Opm::EclPendingWrites& pending, std::size_t size)
+        : thread_([this, &pending, size]()
+                  {
+                      pending.acquire(size);
+                      acquired_ = true;
+                  })
+    {}
+
+    ~Acquirer()
+    {
+        if (thread_.joinable())
+            thread_.join();
+    }
+
+    // Give the thread time to get past acquire() if it is not blocked.
+    bool acquiredAfterWait() const
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        return acquired_;
+    }
+
+    bool acquired()
+    {
+        thread_.join();
+        return acquired_;
+    }
+
+private:
+    std::atomic<bool> acquired_{false};
+    std::thread thread_;
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(EmptyQueueAlwaysAdmits)
+{
+    Opm::EclPendingWrites pending(2, 100);
+
+    // a single write larger than the memory limit does not deadlock
+    Acquirer large(pending, 1000);
+    BOOST_CHECK(large.acquired());
+    pending.release(1000);
+
+    Acquirer small(pending, 10);
+    BOOST_CHECK(small.acquired());
+    pending.release(10);
+}
+
+BOOST_AUTO_TEST_CASE(CountLimit)
+{
+    Opm::EclPendingWrites pending(2, 0);
+    pending.acquire(10);
+    pending.acquire(10);
+
+    Acquirer third(pending, 10);
+    BOOST_CHECK(!third.acquiredAfterWait());
+
+    pending.release(10);
+    BOOST_CHECK(third.acquired());
+    pending.release(10);
+    pending.release(10);
+}
+
+BOOST_AUTO_TEST_CASE(MemoryLimit)
+{
+    Opm::EclPendingWrites pending(10, 100);
+    pending.acquire(60);
+
+    // the write fits within the limit
+    pending.acquire(40);
+
+    Acquirer tooLarge(pending, 1);
+    BOOST_CHECK(!tooLarge.acquiredAfterWait());
+
+    // a slot is only admitted once enough memory has been released
+    pending.release(40);
+    BOOST_CHECK(tooLarge.acquired());
+    pending.release(1);
+    pending.release(60);
+}
+
+BOOST_AUTO_TEST_CASE(NoMemoryLimit)
+{
+    Opm::EclPendingWrites pending(3, 0);
+    pending.acquire(1000000);
+    pending.acquire(1000000);
+
+    Acquirer third(pending, 1000000);
+    BOOST_CHECK(third.acquired());
+
+    pending.release(1000000);
+    pending.release(1000000);
+    pending.release(1000000);
+}
+
+BOOST_AUTO_TEST_CASE(ZeroCountIsOne)
+{
+    Opm::EclPendingWrites pending(0, 0);
+    pending.acquire(10);
+
+    Acquirer second(pending, 10);
+    BOOST_CHECK(!second.acquiredAfterWait());
+
+    pending.release(10);
+    BOOST_CHECK(second.acquired());
+    pending.release(10);
+}
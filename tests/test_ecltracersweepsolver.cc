@@ -0,0 +1,159 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+#include "config.h"
+
+#define BOOST_TEST_MODULE EclTracerSweepSolver
+
+#include <boost/test/unit_test.hpp>
+
+#include <ebos/ecltracersweepsolver.hh>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+
+#include <set>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, 1, 1>>;
+using Vector = Dune::BlockVector<Dune::FieldVector<double, 1>>;
+using Entry = std::tuple<unsigned, unsigned, double>;
+
+// build a matrix from its entries. every cell is also connected to its
+// neighbors by explicit zeros, like the tracer matrix is.
+Matrix makeMatrix(unsigned n, const std::vector<Entry>& entries)
+{
+    std::vector<std::set<unsigned>> pattern(n);
+    for (unsigned i = 0; i < n; ++i) {
+        pattern[i].insert(i);
+        if (i > 0)
+            pattern[i].insert(i - 1);
+        if (i + 1 < n)
+            pattern[i].insert(i + 1);
+    }
+    for (const auto& [row, col, value] : entries)
+        pattern[row].insert(col);
+
+    Matrix M(n, n, Matrix::random);
+    for (unsigned i = 0; i < n; ++i)
+        M.setrowsize(i, pattern[i].size());
+    M.endrowsizes();
+    for (unsigned i = 0; i < n; ++i)
+        for (unsigned j : pattern[i])
+            M.addindex(i, j);
+    M.endindices();
+
+    M = 0.0;
+    for (const auto& [row, col, value] : entries)
+        M[row][col][0][0] += value;
+
+    return M;
+}
+
+// the right hand sides and solutions are stored interleaved
+void checkSolution(const Matrix& M,
+                   const std::vector<double>& x,
+                   const std::vector<double>& b,
+                   unsigned numRhs)
+{
+    const unsigned n = M.N();
+    for (unsigned rhsIdx = 0; rhsIdx < numRhs; ++rhsIdx) {
+        Vector xk(n);
+        Vector y(n);
+        for (unsigned i = 0; i < n; ++i)
+            xk[i][0] = x[i*numRhs + rhsIdx];
+        M.mv(xk, y);
+        for (unsigned i = 0; i < n; ++i)
+            BOOST_CHECK_CLOSE(y[i][0], b[i*numRhs + rhsIdx], 1e-10);
+    }
+}
+
+std::vector<double> makeRhs(unsigned n, unsigned numRhs)
+{
+    std::vector<double> b(n*numRhs);
+    for (unsigned i = 0; i < n; ++i)
+        for (unsigned rhsIdx = 0; rhsIdx < numRhs; ++rhsIdx)
+            b[i*numRhs + rhsIdx] = 1.0 + i + 10.0*rhsIdx;
+    return b;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(UpwindChain)
+{
+    // flow goes 3 -> 1 -> 4 -> 0 -> 2, each cell only sees its upstream cell
+    const unsigned n = 5;
+    const Matrix M = makeMatrix(n, {
+            {0, 0, 2.0}, {1, 1, 3.0}, {2, 2, 1.5}, {3, 3, 4.0}, {4, 4, 2.5},
+            {1, 3, -1.0}, {4, 1, -2.0}, {0, 4, -0.5}, {2, 0, -1.0}});
+
+    Opm::EclTracerSweepSolver<double> solver;
+    BOOST_CHECK(solver.update(M));
+    BOOST_CHECK_EQUAL(solver.numComponents(), n);
+    BOOST_CHECK_EQUAL(solver.maxComponentSize(), 1u);
+
+    const auto b = makeRhs(n, 3);
+    std::vector<double> x(b.size());
+    BOOST_CHECK(solver.solve(M, x, b, 3));
+    checkSolution(M, x, b, 3);
+}
+
+BOOST_AUTO_TEST_CASE(Cycle)
+{
+    // cells 0, 1 and 2 form a cycle which is fed by cell 4 and drains into 3
+    const unsigned n = 5;
+    const Matrix M = makeMatrix(n, {
+            {0, 0, 2.0}, {1, 1, 3.0}, {2, 2, 1.5}, {3, 3, 4.0}, {4, 4, 2.5},
+            {1, 0, -1.0}, {2, 1, -2.0}, {0, 2, -0.5}, {0, 4, -1.0}, {3, 2, -1.0}});
+
+    Opm::EclTracerSweepSolver<double> solver;
+    BOOST_CHECK(solver.update(M));
+    BOOST_CHECK_EQUAL(solver.numComponents(), 3u);
+    BOOST_CHECK_EQUAL(solver.maxComponentSize(), 3u);
+
+    const auto b = makeRhs(n, 2);
+    std::vector<double> x(b.size());
+    BOOST_CHECK(solver.solve(M, x, b, 2));
+    checkSolution(M, x, b, 2);
+
+    // the cycle is too large for a solver which only accepts pairs
+    Opm::EclTracerSweepSolver<double> smallSolver(2);
+    BOOST_CHECK(!smallSolver.update(M));
+}
+
+BOOST_AUTO_TEST_CASE(SingularCell)
+{
+    const unsigned n = 3;
+    const Matrix M = makeMatrix(n, {{0, 0, 1.0}, {2, 2, 1.0}, {1, 0, -1.0}});
+
+    Opm::EclTracerSweepSolver<double> solver;
+    BOOST_CHECK(solver.update(M));
+
+    const auto b = makeRhs(n, 1);
+    std::vector<double> x(b.size());
+    BOOST_CHECK(!solver.solve(M, x, b, 1));
+}
@@ -1148,3 +1148,23 @@ BOOST_AUTO_TEST_CASE(DeckWithSwatinit)
     }
 #endif
 }
+
+BOOST_AUTO_TEST_CASE(DefaultedThresholdPressure)
+{
+    using TypeTag = Opm::Properties::TTag::TestEquilTypeTag;
+    auto simulator = initSimulator<TypeTag>("equil_thpres.DATA");
+
+    // the defaulted threshold pressures are computed from the initial solution,
+    // i.e., after the initialization of the problem is finished.
+    simulator->model().applyInitialSolution();
+
+    // cells 0 and 1 are horizontal neighbors in different EQUIL regions. the
+    // oil pressures of the regions differ by 20 bar at the same depth.
+    const auto& problem = simulator->problem();
+    const double thpres = problem.thresholdPressure(0, 1);
+    BOOST_CHECK_GT(thpres, 10e5);
+    BOOST_CHECK_EQUAL(problem.thresholdPressure(1, 0), thpres);
+
+    // cells 0 and 2 are vertical neighbors in the same EQUIL region
+    BOOST_CHECK_EQUAL(problem.thresholdPressure(0, 2), 0.0);
+}
@@ -193,5 +193,39 @@ BOOST_AUTO_TEST_CASE(G1)
     BOOST_CHECK(!state->alqIsLimited());
     BOOST_CHECK_CLOSE(state->alq(), 0.0, 1e-8);
     BOOST_CHECK(!state->increase().has_value());
+
+    // The rates evaluated during the optimization are memoised by the
+    // GasLiftSingleWell object, and reused by later gradient evaluations,
+    // e.g. in stage 2. These must agree with a fresh evaluation.
+    GasLiftSingleWell glift_fresh {*std_well, *(simulator.get()), summary_state,
+        deferred_logger, well_state, group_state, group_info, sync_groups};
+    auto checkSameGradient = [](const auto& grad, const auto& grad_fresh) {
+        BOOST_REQUIRE_EQUAL(grad.has_value(), grad_fresh.has_value());
+        if (!grad)
+            return;
+        BOOST_CHECK_CLOSE(grad->grad, grad_fresh->grad, 1e-8);
+        BOOST_CHECK_CLOSE(grad->new_oil_rate, grad_fresh->new_oil_rate, 1e-8);
+        BOOST_CHECK_CLOSE(grad->new_gas_rate, grad_fresh->new_gas_rate, 1e-8);
+        BOOST_CHECK_CLOSE(grad->alq, grad_fresh->alq, 1e-8);
+        BOOST_CHECK_EQUAL(grad->oil_is_limited, grad_fresh->oil_is_limited);
+        BOOST_CHECK_EQUAL(grad->gas_is_limited, grad_fresh->gas_is_limited);
+        BOOST_CHECK_EQUAL(grad->alq_is_limited, grad_fresh->alq_is_limited);
+    };
+    const auto grad_inc = glift.calcIncOrDecGradient(
+        state->oilRate(), state->gasRate(), state->alq(), /*increase=*/true);
+    checkSameGradient(grad_inc, glift_fresh.calcIncOrDecGradient(
+        state->oilRate(), state->gasRate(), state->alq(), /*increase=*/true));
+    // repeated evaluations are served from the memoised values
+    checkSameGradient(grad_inc, glift.calcIncOrDecGradient(
+        state->oilRate(), state->gasRate(), state->alq(), /*increase=*/true));
+    if (grad_inc) {
+        // stepping back down hits the memoised ALQ of the initial rates up
+        // to rounding of the ALQ increments
+        checkSameGradient(
+            glift.calcIncOrDecGradient(grad_inc->new_oil_rate, grad_inc->new_gas_rate,
+                                       grad_inc->alq, /*increase=*/false),
+            glift_fresh.calcIncOrDecGradient(grad_inc->new_oil_rate, grad_inc->new_gas_rate,
+                                             grad_inc->alq, /*increase=*/false));
+    }
 }
 
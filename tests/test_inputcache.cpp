@@ -0,0 +1,230 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <config.h>
+
+#define BOOST_TEST_MODULE InputCache
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/utils/readDeck.hpp>
+
+#include <opm/common/OpmLog/OpmLog.hpp>
+#include <opm/common/OpmLog/StreamLog.hpp>
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/EclipseState/SummaryConfig/SummaryConfig.hpp>
+#include <opm/parser/eclipse/Parser/ErrorGuard.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Python/Python.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "MpiFixture.hpp"
+
+BOOST_GLOBAL_FIXTURE(MPIFixture);
+
+namespace {
+
+const std::string deckFile = "INPUT_CACHE.DATA";
+const std::string includeFile = "INPUT_CACHE_PROPS.INC";
+
+void writeFile(const std::string& name, const std::string& contents)
+{
+    std::ofstream os(name, std::ios::binary | std::ios::trunc);
+    os << contents;
+}
+
+std::vector<char> readFile(const std::string& name)
+{
+    std::ifstream is(name, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+}
+
+void writeFile(const std::string& name, const std::vector<char>& contents)
+{
+    std::ofstream os(name, std::ios::binary | std::ios::trunc);
+    os.write(contents.data(), contents.size());
+}
+
+void writeDeck(double waterDensity, const std::string& deckName = deckFile)
+{
+    writeFile(deckName,
+              "RUNSPEC\n"
+              "DIMENS\n 1 1 1 /\n"
+              "OIL\nWATER\n"
+              "METRIC\n"
+              "GRID\n"
+              "DX\n 1 /\nDY\n 1 /\nDZ\n 1 /\nTOPS\n 0 /\n"
+              "PORO\n 0.3 /\n"
+              "PERMX\n 100 /\nPERMY\n 100 /\nPERMZ\n 100 /\n"
+              "PROPS\n"
+              "INCLUDE\n '" + includeFile + "' /\n"
+              "SUMMARY\n"
+              "FOPR\n"
+              "SCHEDULE\n"
+              "TSTEP\n 1 /\n");
+
+    writeFile(includeFile,
+              "SWOF\n"
+              " 0.2 0 1 0\n"
+              " 1.0 1 0 0 /\n"
+              "PVTW\n 1 1 4e-5 0.5 0 /\n"
+              "PVDO\n 100 1.0 1.0\n 200 0.9 1.0 /\n"
+              "DENSITY\n 800 " + std::to_string(waterDensity) + " 1 /\n"
+              "ROCK\n 1 0 /\n");
+}
+
+// Read the deck with an input cache and return the messages logged while
+// doing so.
+std::string readDeckWithCache(const std::string& cacheFile, bool checkDeck = false,
+                              const std::string& deckName = deckFile)
+{
+    std::ostringstream log;
+    Opm::OpmLog::addBackend("INPUT_CACHE_TEST",
+                            std::make_shared<Opm::StreamLog>(log, Opm::Log::DefaultMessageTypes));
+
+    std::string deckFilename = deckName;
+    std::unique_ptr<Opm::Deck> deck;
+    std::unique_ptr<Opm::EclipseState> eclipseState;
+    std::unique_ptr<Opm::Schedule> schedule;
+    std::unique_ptr<Opm::SummaryConfig> summaryConfig;
+    auto python = std::make_shared<Opm::Python>();
+    Opm::readDeck(/*rank=*/0, deckFilename, deck, eclipseState, schedule, summaryConfig,
+                  std::make_unique<Opm::ErrorGuard>(), python, std::make_unique<Opm::ParseContext>(),
+                  /*initFromRestart=*/false, checkDeck, /*outputInterval=*/std::nullopt, cacheFile);
+
+    BOOST_CHECK(deck);
+    BOOST_CHECK(eclipseState);
+    BOOST_CHECK(schedule);
+    BOOST_CHECK(summaryConfig);
+    if (summaryConfig)
+        BOOST_CHECK(summaryConfig->hasKeyword("FOPR"));
+
+    Opm::OpmLog::removeBackend("INPUT_CACHE_TEST");
+    return log.str();
+}
+
+bool readFromCache(const std::string& log)
+{ return log.find("Read parsed input from cache") != std::string::npos; }
+
+bool wroteCache(const std::string& log)
+{ return log.find("Wrote parsed input to cache") != std::string::npos; }
+
+}
+
+BOOST_AUTO_TEST_CASE(Hit)
+{
+    const std::string cacheFile = "INPUT_CACHE_HIT.cache";
+    std::remove(cacheFile.c_str());
+    writeDeck(1000.0);
+
+    const auto first = readDeckWithCache(cacheFile);
+    BOOST_CHECK(!readFromCache(first));
+    BOOST_CHECK(wroteCache(first));
+
+    const auto second = readDeckWithCache(cacheFile);
+    BOOST_CHECK(readFromCache(second));
+    BOOST_CHECK(!wroteCache(second));
+}
+
+BOOST_AUTO_TEST_CASE(MissAfterInputFileChange)
+{
+    const std::string cacheFile = "INPUT_CACHE_FILE_CHANGE.cache";
+    std::remove(cacheFile.c_str());
+    writeDeck(1000.0);
+    BOOST_CHECK(wroteCache(readDeckWithCache(cacheFile)));
+
+    // only the include file is changed
+    writeDeck(1010.0);
+    const auto log = readDeckWithCache(cacheFile);
+    BOOST_CHECK(log.find(includeFile + "' changed") != std::string::npos);
+    BOOST_CHECK(!readFromCache(log));
+    BOOST_CHECK(wroteCache(log));
+
+    BOOST_CHECK(readFromCache(readDeckWithCache(cacheFile)));
+}
+
+BOOST_AUTO_TEST_CASE(MissAfterKeyChange)
+{
+    const std::string cacheFile = "INPUT_CACHE_KEY_CHANGE.cache";
+    std::remove(cacheFile.c_str());
+    writeDeck(1000.0);
+    BOOST_CHECK(wroteCache(readDeckWithCache(cacheFile, /*checkDeck=*/false)));
+
+    const auto log = readDeckWithCache(cacheFile, /*checkDeck=*/true);
+    BOOST_CHECK(log.find("created with other settings") != std::string::npos);
+    BOOST_CHECK(!readFromCache(log));
+    BOOST_CHECK(wroteCache(log));
+}
+
+BOOST_AUTO_TEST_CASE(MissForOtherDeck)
+{
+    const std::string cacheFile = "INPUT_CACHE_OTHER_DECK.cache";
+    const std::string otherDeckFile = "INPUT_CACHE_OTHER.DATA";
+    std::remove(cacheFile.c_str());
+    writeDeck(1000.0);
+    writeDeck(1000.0, otherDeckFile);
+    BOOST_CHECK(wroteCache(readDeckWithCache(cacheFile)));
+
+    // the other deck has the same contents, but the cache is not for it
+    const auto log = readDeckWithCache(cacheFile, /*checkDeck=*/false, otherDeckFile);
+    BOOST_CHECK(log.find("created for another deck") != std::string::npos);
+    BOOST_CHECK(!readFromCache(log));
+    BOOST_CHECK(wroteCache(log));
+
+    BOOST_CHECK(readFromCache(readDeckWithCache(cacheFile, /*checkDeck=*/false, otherDeckFile)));
+    BOOST_CHECK(!readFromCache(readDeckWithCache(cacheFile)));
+}
+
+BOOST_AUTO_TEST_CASE(CorruptCache)
+{
+    const std::string cacheFile = "INPUT_CACHE_CORRUPT.cache";
+    std::remove(cacheFile.c_str());
+    writeDeck(1000.0);
+    BOOST_CHECK(wroteCache(readDeckWithCache(cacheFile)));
+    const auto contents = readFile(cacheFile);
+    BOOST_REQUIRE(contents.size() > 16);
+
+    // change a byte of the serialized objects, which are stored right
+    // before the trailing 8 byte hash
+    auto corrupt = contents;
+    corrupt[corrupt.size() - 9] ^= 0x5a;
+    writeFile(cacheFile, corrupt);
+    auto log = readDeckWithCache(cacheFile);
+    BOOST_CHECK(log.find("is corrupt") != std::string::npos);
+    BOOST_CHECK(!readFromCache(log));
+    BOOST_CHECK(wroteCache(log));
+
+    // truncated files, both inside the serialized objects and inside the
+    // header, are not read either
+    for (const std::size_t size : {contents.size() - 20, std::size_t{12}}) {
+        writeFile(cacheFile, std::vector<char>(contents.begin(), contents.begin() + size));
+        log = readDeckWithCache(cacheFile);
+        BOOST_CHECK(!readFromCache(log));
+        BOOST_CHECK(wroteCache(log));
+    }
+
+    BOOST_CHECK(readFromCache(readDeckWithCache(cacheFile)));
+}
@@ -0,0 +1,223 @@
+/*
+  Copyright 2021 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE NumericalAquiferCondensation
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/linalg/NumericalAquiferCondensation.hpp>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+
+#include <cmath>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr int blockSize = 2;
+using Block = Dune::FieldMatrix<double, blockSize, blockSize>;
+using Matrix = Dune::BCRSMatrix<Block>;
+using Vector = Dune::BlockVector<Dune::FieldVector<double, blockSize>>;
+using Condensation = Opm::NumericalAquiferCondensation<Matrix, Vector>;
+
+// Reservoir cells 0, 1 and 2 form a line, the aquifer chain 3 - 7 is
+// connected to the reservoir through cell 3, which is coupled to cells 0
+// and 2. Additional connections can be given as pairs of cells.
+Matrix makeMatrix(const std::vector<std::pair<int, int>>& extraConnections,
+                  const std::vector<std::pair<int, int>>& zeroConnections = {})
+{
+    const int n = 8;
+    std::vector<std::pair<int, int>> connections = {
+        {0, 1}, {1, 2}, {0, 3}, {2, 3}, {3, 4}, {4, 5}, {5, 6}, {6, 7}
+    };
+    connections.insert(connections.end(), extraConnections.begin(), extraConnections.end());
+
+    std::vector<std::set<int>> pattern(n);
+    for (int i = 0; i < n; ++i)
+        pattern[i].insert(i);
+    for (const auto& conns : {connections, zeroConnections}) {
+        for (const auto& [i, j] : conns) {
+            pattern[i].insert(j);
+            pattern[j].insert(i);
+        }
+    }
+
+    Matrix A(n, n, Matrix::random);
+    for (int i = 0; i < n; ++i)
+        A.setrowsize(i, pattern[i].size());
+    A.endrowsizes();
+    for (int i = 0; i < n; ++i)
+        for (int j : pattern[i])
+            A.addindex(i, j);
+    A.endindices();
+    A = 0.0;
+
+    for (int i = 0; i < n; ++i) {
+        A[i][i][0][0] = 1.0 + 0.1*i;
+        A[i][i][0][1] = 0.3;
+        A[i][i][1][0] = -0.2;
+        A[i][i][1][1] = 2.0;
+    }
+    for (const auto& [i, j] : connections) {
+        Block coupling(0.0);
+        coupling[0][0] = 1.0 + 0.05*(i + j);
+        coupling[0][1] = 0.1;
+        coupling[1][0] = 0.2;
+        coupling[1][1] = 0.5;
+
+        // like a flux term: the coupling is added to the diagonals and
+        // subtracted from the off-diagonals
+        for (int r = 0; r < blockSize; ++r) {
+            for (int c = 0; c < blockSize; ++c) {
+                A[i][i][r][c] += coupling[r][c];
+                A[j][j][r][c] += coupling[r][c];
+            }
+        }
+        A[i][j] -= coupling;
+        A[j][i] -= coupling;
+
+        // make the matrix non-symmetric
+        A[j][i][0][1] += 0.05;
+    }
+
+    return A;
+}
+
+Vector makeRhs(int n)
+{
+    Vector b(n);
+    for (int i = 0; i < n; ++i) {
+        b[i][0] = 1.0 + i;
+        b[i][1] = 0.5 - 0.25*i;
+    }
+    return b;
+}
+
+// solve a small system by dense Gaussian elimination with partial pivoting
+Vector solveDense(const Matrix& A, const Vector& b)
+{
+    const int n = A.N() * blockSize;
+    std::vector<std::vector<double>> M(n, std::vector<double>(n + 1, 0.0));
+    for (std::size_t i = 0; i < A.N(); ++i) {
+        for (auto colIt = A[i].begin(); colIt != A[i].end(); ++colIt)
+            for (int r = 0; r < blockSize; ++r)
+                for (int c = 0; c < blockSize; ++c)
+                    M[i*blockSize + r][colIt.index()*blockSize + c] = (*colIt)[r][c];
+        for (int r = 0; r < blockSize; ++r)
+            M[i*blockSize + r][n] = b[i][r];
+    }
+
+    for (int col = 0; col < n; ++col) {
+        int pivot = col;
+        for (int row = col + 1; row < n; ++row)
+            if (std::abs(M[row][col]) > std::abs(M[pivot][col]))
+                pivot = row;
+        std::swap(M[col], M[pivot]);
+        for (int row = col + 1; row < n; ++row) {
+            const double factor = M[row][col] / M[col][col];
+            for (int c = col; c <= n; ++c)
+                M[row][c] -= factor*M[col][c];
+        }
+    }
+
+    std::vector<double> x(n);
+    for (int row = n - 1; row >= 0; --row) {
+        double sum = M[row][n];
+        for (int c = row + 1; c < n; ++c)
+            sum -= M[row][c]*x[c];
+        x[row] = sum / M[row][row];
+    }
+
+    Vector result(A.N());
+    for (std::size_t i = 0; i < A.N(); ++i)
+        for (int r = 0; r < blockSize; ++r)
+            result[i][r] = x[i*blockSize + r];
+    return result;
+}
+
+// condense the system, solve the reduced one and check that the recovered
+// solution solves the original system
+std::size_t checkCondensedSolve(const Matrix& A, const std::vector<int>& chain)
+{
+    const Vector b = makeRhs(A.N());
+
+    Matrix reducedA = A;
+    Vector reducedB = b;
+    Condensation condensation({chain});
+    condensation.condense(reducedA, reducedB);
+
+    Vector x = solveDense(reducedA, reducedB);
+    condensation.recover(x);
+
+    Vector y(A.N());
+    A.mv(x, y);
+    for (std::size_t i = 0; i < A.N(); ++i)
+        for (int r = 0; r < blockSize; ++r)
+            BOOST_CHECK_SMALL(y[i][r] - b[i][r], 1e-10);
+
+    return condensation.numEliminatedCells();
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(FullChain)
+{
+    // explicit zero blocks in the pattern do not prevent the elimination
+    const Matrix A = makeMatrix({}, {{4, 0}, {6, 1}});
+    BOOST_CHECK_EQUAL(checkCondensedSolve(A, {3, 4, 5, 6, 7}), 4u);
+
+    // the eliminated cells are decoupled from the reduced system
+    Matrix reducedA = A;
+    Vector reducedB = makeRhs(A.N());
+    Condensation condensation({{3, 4, 5, 6, 7}});
+    condensation.condense(reducedA, reducedB);
+    for (int cell = 4; cell < 8; ++cell) {
+        for (auto colIt = reducedA[cell].begin(); colIt != reducedA[cell].end(); ++colIt) {
+            const double expected = (int(colIt.index()) == cell) ? 1.0 : 0.0;
+            BOOST_CHECK_EQUAL((*colIt)[0][0], expected);
+            BOOST_CHECK_EQUAL((*colIt)[1][1], expected);
+        }
+        BOOST_CHECK_EQUAL((*reducedA[cell - 1].find(cell)).infinity_norm(), 0.0);
+        BOOST_CHECK_EQUAL(reducedB[cell][0], 0.0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ExternalCoupling)
+{
+    // cell 5 is also connected to the reservoir, so only 6 and 7 are eliminated
+    const Matrix A = makeMatrix({{5, 1}});
+    BOOST_CHECK_EQUAL(checkCondensedSolve(A, {3, 4, 5, 6, 7}), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(UnavailableCell)
+{
+    // cell 5 is not available, so cell 6 is kept and only cell 7 is eliminated
+    const Matrix A = makeMatrix({});
+    BOOST_CHECK_EQUAL(checkCondensedSolve(A, {3, 4, -1, 6, 7}), 1u);
+
+    // nothing to eliminate for a chain of a single cell
+    BOOST_CHECK_EQUAL(checkCondensedSolve(A, {3}), 0u);
+}
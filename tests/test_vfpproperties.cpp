@@ -725,6 +725,62 @@ BOOST_AUTO_TEST_CASE(ParseInterpolateRealisticVFPPROD)
     BOOST_CHECK_SMALL(sad, sad_tol);
 }
 
+/**
+ * Tests that the cached THP inversion gives the same result as inverting
+ * the BHP array interpolated at every THP axis point.
+ */
+BOOST_AUTO_TEST_CASE(THPInverseMatchesDirectInversion)
+{
+    auto units = Opm::UnitSystem::newMETRIC();
+
+    Opm::Parser parser;
+    Opm::filesystem::path file("VFPPROD2");
+
+    auto deck = parser.parseFile(file.string());
+    Opm::VFPProdTable table(deck.getKeyword("VFPPROD", 0), units);
+    Opm::VFPProdProperties properties;
+    properties.addTable(table);
+
+    const std::vector<double>& thp_axis = table.getTHPAxis();
+    const int nthp = thp_axis.size();
+
+    const double liq[] = {50.0, 3000.0, 9000.0, 25000.0};
+    const double wct[] = {0.1, 0.5, 0.95};
+    const double gor[] = {50.0, 2000.0, 12000.0};
+    const double bhp[] = {1.0e6, 5.0e6, 1.0e7, 2.0e7, 5.0e7};
+    const double alq = 0.0;
+
+    for (const double l : liq) {
+        for (const double w : wct) {
+            for (const double g : gor) {
+                const double f_i = -l*1.1574074074074073e-05;
+                const double aqua = w * f_i;
+                const double liquid = f_i - aqua;
+                const double vapour = g * liquid;
+
+                const double flo = -Opm::detail::getFlo(table, aqua, liquid, vapour);
+                const auto flo_i = Opm::detail::findInterpData(flo, table.getFloAxis());
+                const auto wfr_i = Opm::detail::findInterpData(Opm::detail::getWFR(table, aqua, liquid, vapour), table.getWFRAxis());
+                const auto gfr_i = Opm::detail::findInterpData(Opm::detail::getGFR(table, aqua, liquid, vapour), table.getGFRAxis());
+                const auto alq_i = Opm::detail::findInterpData(alq, table.getALQAxis());
+
+                std::vector<double> bhp_array(nthp);
+                for (int t = 0; t < nthp; ++t) {
+                    const auto thp_i = Opm::detail::findInterpData(thp_axis[t], thp_axis);
+                    bhp_array[t] = Opm::detail::interpolate(table, flo_i, thp_i, wfr_i, gfr_i, alq_i).value;
+                }
+
+                for (const double b : bhp) {
+                    const double expected = Opm::detail::findTHP(bhp_array, thp_axis, b);
+                    // Second call is served from the cached bracket.
+                    BOOST_CHECK_EQUAL(properties.thp(32, aqua, liquid, vapour, b, alq), expected);
+                    BOOST_CHECK_EQUAL(properties.thp(32, aqua, liquid, vapour, b, alq), expected);
+                }
+            }
+        }
+    }
+}
+
 /**
  * Reference computed using MATLAB with the input above.
  */
@@ -28,6 +28,7 @@
 #include <opm/simulators/wells/WellState.hpp>
 #include <opm/simulators/wells/SegmentState.hpp>
 #include <opm/simulators/wells/WellContainer.hpp>
+#include <opm/simulators/wells/WellGroupHelpers.hpp>
 #include <opm/simulators/wells/PerfData.hpp>
 #include <opm/parser/eclipse/Python/Python.hpp>
 
@@ -36,6 +37,7 @@
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Group/Group.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/SummaryState.hpp>
 #include <opm/parser/eclipse/Units/Units.hpp>
@@ -174,7 +176,7 @@ namespace {
             }
 
             const auto  pressTop = 100.0 * wellID;
-            auto& segments = wstate.segments(wellID);
+            auto segments = wstate.segments(wellID);
             segments.pressure[0] = pressTop;
 
             const auto& segSet = well.getSegments();
@@ -214,8 +216,8 @@ namespace {
             }
 
             const auto  rateTop  = 1000.0 * wellID;
-            auto& segments = wstate.segments(wellID);
-            auto& segRates = segments.rates;
+            auto segments = wstate.segments(wellID);
+            auto segRates = segments.rates;
 
             if (wat) { segRates[iw] = rateTop; }
             if (oil) { segRates[io] = rateTop; }
@@ -291,7 +293,7 @@ BOOST_AUTO_TEST_CASE(Pressure)
     }
 
 
-    const auto& perf_data = wstate.perfData("PROD01");
+    const auto perf_data = wstate.perfData("PROD01");
     (void) perf_data;
 }
 
@@ -358,7 +360,7 @@ BOOST_AUTO_TEST_CASE(STOP_well)
     std::vector<Opm::ParallelWellInfo> pinfos;
     auto wstate = buildWellState(setup, 0, pinfos);
     for (std::size_t well_index = 0; well_index < setup.sched.numWells(0); well_index++) {
-        const auto& perf_data = wstate.perfData(well_index);
+        const auto perf_data = wstate.perfData(well_index);
         for (const auto& p : perf_data.pressure)
             BOOST_CHECK(p > 0);
     }
@@ -488,6 +490,16 @@ BOOST_AUTO_TEST_CASE(TESTWellContainer) {
 
     auto wx = wci.well_index("WX");
     BOOST_CHECK(!wx.has_value());
+
+    // Copies share the name -> index map until one of them adds wells.
+    auto wci_copy = wci;
+    wci_copy["W1"] = 10;
+    wci_copy.add("W4", 4);
+    BOOST_CHECK_EQUAL(wci["W1"], 1);
+    BOOST_CHECK(!wci.has("W4"));
+    BOOST_CHECK_EQUAL(wci.size(), 3);
+    BOOST_CHECK_EQUAL(wci_copy["W4"], 4);
+    BOOST_CHECK_EQUAL(wci_copy.size(), 4);
 }
 
 BOOST_AUTO_TEST_CASE(TESTSegmentState) {
@@ -508,7 +520,7 @@ BOOST_AUTO_TEST_CASE(TESTSegmentState) {
 BOOST_AUTO_TEST_CASE(TESTSegmentState2) {
     const Setup setup{ "msw.data" };
     std::vector<Opm::ParallelWellInfo> pinfo;
-    const auto wstate = buildWellState(setup, 0, pinfo);
+    auto wstate = buildWellState(setup, 0, pinfo);
     const auto& well = setup.sched.getWell("PROD01", 0);
 
     BOOST_CHECK_THROW(wstate.segments(100), std::exception);
@@ -535,6 +547,77 @@ BOOST_AUTO_TEST_CASE(TESTSegmentState2) {
 }
 
 
+BOOST_AUTO_TEST_CASE(TESTSingleWellSnapshot) {
+    const Setup setup{ "msw.data" };
+    std::vector<Opm::ParallelWellInfo> pinfo;
+    auto wstate = buildWellState(setup, 0, pinfo);
+
+    const auto prod_index = wstate.wellIndex("PROD01");
+    const auto other_index = 1 - prod_index;
+    const auto other_bhp = wstate.bhp(other_index);
+    const auto bhp0 = wstate.bhp(prod_index);
+    const auto rates0 = wstate.wellRates(prod_index).to_vector();
+    const auto seg_press0 = wstate.segments(prod_index).pressure.to_vector();
+
+    const auto snapshot = wstate.snapshotWell(prod_index);
+
+    wstate.update_bhp(prod_index, bhp0 + 100.0);
+    for (auto& q : wstate.wellRates(prod_index))
+        q += 1.0;
+    for (auto& p : wstate.segments(prod_index).pressure)
+        p += 10.0;
+    wstate.currentProductionControl(prod_index, Opm::Well::ProducerCMode::BHP);
+    wstate.update_bhp(other_index, other_bhp + 1.0);
+
+    wstate.restoreWell(snapshot);
+
+    BOOST_CHECK_EQUAL(wstate.bhp(prod_index), bhp0);
+    BOOST_CHECK(wstate.wellRates(prod_index).to_vector() == rates0);
+    BOOST_CHECK(wstate.segments(prod_index).pressure.to_vector() == seg_press0);
+    BOOST_CHECK(wstate.currentProductionControl(prod_index) == snapshot.production_control);
+
+    // Other wells are not touched by the restore.
+    BOOST_CHECK_EQUAL(wstate.bhp(other_index), other_bhp + 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(TESTGroupTree) {
+    const Setup setup{ "msw.data" };
+    std::vector<Opm::ParallelWellInfo> pinfo;
+    auto wstate = buildWellState(setup, 0, pinfo);
+
+    const Opm::WellGroupHelpers::GroupTree tree(setup.sched, 0);
+    BOOST_CHECK_EQUAL(tree.size(), 3);
+    BOOST_CHECK_EQUAL(tree.name(tree.root()), "FIELD");
+    BOOST_CHECK_EQUAL(tree.parent(tree.root()), -1);
+
+    for (std::size_t group = 0; group < tree.size(); ++group) {
+        // Every group comes after all of its subgroups.
+        for (const auto child : tree.childGroups(group)) {
+            BOOST_CHECK_LT(child, group);
+            BOOST_CHECK_EQUAL(tree.parent(child), static_cast<int>(group));
+        }
+        const auto& group_ecl = setup.sched.getGroup(tree.name(group), 0);
+        BOOST_CHECK_EQUAL(tree.childWells(group).size(), group_ecl.wells().size());
+    }
+
+    for (auto& q : wstate.wellRates(wstate.wellIndex("INJE01")))
+        q = 1.0;
+    for (auto& q : wstate.wellRates(wstate.wellIndex("PROD01")))
+        q = -2.0;
+
+    const int np = wstate.numPhases();
+    for (const bool injector : {false, true}) {
+        const auto sums = tree.sumWellPhaseRates(wstate.wellRates(), wstate, injector);
+        for (std::size_t group = 0; group < tree.size(); ++group) {
+            const auto& group_ecl = setup.sched.getGroup(tree.name(group), 0);
+            for (int phase = 0; phase < np; ++phase) {
+                BOOST_CHECK_EQUAL(sums[group][phase],
+                                  Opm::WellGroupHelpers::sumWellRates(group_ecl, setup.sched, wstate, 0, phase, injector));
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(TESTPerfData) {
     const auto& deck_string = R"(
 RUNSPEC
@@ -570,6 +653,47 @@ GAS
     BOOST_CHECK(!pd1.try_assign(pd4));
 }
 
+BOOST_AUTO_TEST_CASE(TESTFlatLayout) {
+    const Setup setup{ "msw.data" };
+    std::vector<Opm::ParallelWellInfo> pinfo;
+    auto wstate = buildWellState(setup, 0, pinfo);
+
+    const auto nw = static_cast<std::size_t>(wstate.numWells());
+    const auto np = static_cast<std::size_t>(wstate.numPhases());
+    BOOST_CHECK_EQUAL(wstate.wellRates().size(), nw * np);
+
+    // The slices of the wells are consecutive parts of the flat arrays.
+    std::size_t num_perf = 0;
+    std::size_t num_seg = 0;
+    for (std::size_t w = 0; w < nw; ++w) {
+        BOOST_CHECK(wstate.wellRates(w).data() == wstate.wellRates().data() + w * np);
+
+        const auto perf_data = wstate.perfData(w);
+        BOOST_CHECK_EQUAL(perf_data.size(), wstate.numPerf(w));
+        BOOST_CHECK_EQUAL(perf_data.phase_rates.size(), perf_data.size() * np);
+        num_perf += perf_data.size();
+
+        const auto segments = wstate.segments(w);
+        BOOST_CHECK_EQUAL(segments.rates.size(), segments.size() * np);
+        num_seg += segments.size();
+    }
+    BOOST_CHECK_EQUAL(wstate.perfData(nw - 1).pressure.end() - wstate.perfData(0).pressure.begin(),
+                      static_cast<std::ptrdiff_t>(num_perf));
+    BOOST_CHECK_EQUAL(wstate.segments("PROD01").size(), num_seg);
+    BOOST_CHECK(wstate.segments("INJE01").empty());
+
+    // Writing through the slice of one well leaves the other wells alone.
+    const auto prod_index = wstate.wellIndex("PROD01");
+    const auto other_index = 1 - prod_index;
+    const auto other_rates = wstate.wellRates(other_index).to_vector();
+    wstate.wellRates(prod_index).assign(np, 7.0);
+    BOOST_CHECK(wstate.wellRates(other_index).to_vector() == other_rates);
+    for (std::size_t p = 0; p < np; ++p)
+        BOOST_CHECK_EQUAL(wstate.wellRates()[prod_index * np + p], 7.0);
+
+    BOOST_CHECK_THROW(wstate.wellRates(prod_index).assign(np + 1, 0.0), std::logic_error);
+}
+
 
 
 BOOST_AUTO_TEST_SUITE_END()